@@ -23,11 +23,15 @@ namespace CesiumForUnity
         private SerializedProperty _preloadSiblings;
         private SerializedProperty _forbidHoles;
         private SerializedProperty _maximumSimultaneousTileLoads;
+        private SerializedProperty _loadPriorityWeight;
+        private SerializedProperty _predictiveLoadingTime;
+        private SerializedProperty _warmStart;
         private SerializedProperty _maximumCachedBytes;
         private SerializedProperty _loadingDescendantLimit;
 
         private SerializedProperty _enableFrustumCulling;
         private SerializedProperty _enableFogCulling;
+        private SerializedProperty _enableOcclusionCulling;
         private SerializedProperty _enforceCulledScreenSpaceError;
         private SerializedProperty _culledScreenSpaceError;
 
@@ -36,6 +40,9 @@ namespace CesiumForUnity
         //private SerializedProperty _useLodTransitions;
         //private SerializedProperty _lodTransitionLength;
         private SerializedProperty _generateSmoothNormals;
+        private SerializedProperty _shareMaterials;
+        private SerializedProperty _useRasterOverlayAtlas;
+        private SerializedProperty _compositeRasterOverlays;
 
         private SerializedProperty _pointCloudShading;
 
@@ -43,6 +50,7 @@ namespace CesiumForUnity
         private SerializedProperty _suspendUpdate;
         private SerializedProperty _updateInEditor;
         private SerializedProperty _logSelectionStats;
+        private SerializedProperty _recordFrameStats;
 
         private SerializedProperty _createPhysicsMeshes;
 
@@ -67,6 +75,11 @@ namespace CesiumForUnity
             this._forbidHoles = this.serializedObject.FindProperty("_forbidHoles");
             this._maximumSimultaneousTileLoads =
                 this.serializedObject.FindProperty("_maximumSimultaneousTileLoads");
+            this._loadPriorityWeight =
+                this.serializedObject.FindProperty("_loadPriorityWeight");
+            this._predictiveLoadingTime =
+                this.serializedObject.FindProperty("_predictiveLoadingTime");
+            this._warmStart = this.serializedObject.FindProperty("_warmStart");
             this._maximumCachedBytes = this.serializedObject.FindProperty("_maximumCachedBytes");
             this._loadingDescendantLimit =
                 this.serializedObject.FindProperty("_loadingDescendantLimit");
@@ -74,6 +87,8 @@ namespace CesiumForUnity
             this._enableFrustumCulling =
                 this.serializedObject.FindProperty("_enableFrustumCulling");
             this._enableFogCulling = this.serializedObject.FindProperty("_enableFogCulling");
+            this._enableOcclusionCulling =
+                this.serializedObject.FindProperty("_enableOcclusionCulling");
             this._enforceCulledScreenSpaceError =
                 this.serializedObject.FindProperty("_enforceCulledScreenSpaceError");
             this._culledScreenSpaceError =
@@ -86,6 +101,11 @@ namespace CesiumForUnity
             this._generateSmoothNormals =
                 this.serializedObject.FindProperty("_generateSmoothNormals");
             this._ignoreKhrMaterialsUnlit = this.serializedObject.FindProperty("_ignoreKhrMaterialsUnlit");
+            this._shareMaterials = this.serializedObject.FindProperty("_shareMaterials");
+            this._useRasterOverlayAtlas =
+                this.serializedObject.FindProperty("_useRasterOverlayAtlas");
+            this._compositeRasterOverlays =
+                this.serializedObject.FindProperty("_compositeRasterOverlays");
 
             this._pointCloudShading = this.serializedObject.FindProperty("_pointCloudShading");
 
@@ -94,6 +114,7 @@ namespace CesiumForUnity
             this._suspendUpdate = this.serializedObject.FindProperty("_suspendUpdate");
             this._updateInEditor = this.serializedObject.FindProperty("_updateInEditor");
             this._logSelectionStats = this.serializedObject.FindProperty("_logSelectionStats");
+            this._recordFrameStats = this.serializedObject.FindProperty("_recordFrameStats");
 
             this._createPhysicsMeshes =
                 this.serializedObject.FindProperty("_createPhysicsMeshes");
@@ -286,6 +307,36 @@ namespace CesiumForUnity
             EditorGUILayout.PropertyField(
                 this._maximumSimultaneousTileLoads, maximumSimultaneousTileLoadsContent);
 
+            GUIContent loadPriorityWeightContent = new GUIContent(
+                "Load Priority Weight",
+                "The share of the scene-wide limit on simultaneous tile loads that this " +
+                "tileset receives, relative to the other tilesets in the scene." +
+                "\n\n" +
+                "This only has an effect when Maximum Simultaneous Tile Loads is set in " +
+                "the Cesium runtime settings.");
+            EditorGUILayout.PropertyField(this._loadPriorityWeight, loadPriorityWeightContent);
+
+            GUIContent predictiveLoadingTimeContent = new GUIContent(
+                "Predictive Loading Time",
+                "How far ahead, in seconds, to predict the motion of each camera in order " +
+                "to start loading the tiles it will need before it gets there. Zero " +
+                "disables predictive loading." +
+                "\n\n" +
+                "Tiles for the predicted views are loaded at a lower priority than tiles " +
+                "for the current views.");
+            EditorGUILayout.PropertyField(
+                this._predictiveLoadingTime, predictiveLoadingTimeContent);
+
+            GUIContent warmStartContent = new GUIContent(
+                "Warm Start",
+                "Whether to save a snapshot of the camera views while this tileset is " +
+                "in use, and to load the tiles for those views when the tileset is " +
+                "next loaded." +
+                "\n\n" +
+                "The tiles are usually read from the request cache, so an " +
+                "application that starts where it was closed reaches full detail sooner.");
+            EditorGUILayout.PropertyField(this._warmStart, warmStartContent);
+
             GUIContent maximumCachedBytesContent = new GUIContent(
                 "Maximum Cached Bytes",
                 "The maximum number of bytes that may be cached." +
@@ -344,6 +395,17 @@ namespace CesiumForUnity
             EditorGUILayout.PropertyField(this._enableFogCulling, enableFogCullingContent);
             //EditorGUI.EndDisabledGroup();
 
+            GUIContent enableOcclusionCullingContent = new GUIContent(
+                "Enable Occlusion Culling",
+                "Whether to cull tiles that are hidden behind the tiles already rendered " +
+                "by this and other tilesets that enable occlusion culling." +
+                "\n\n" +
+                "The rendered tiles are rasterized on the CPU into a coarse depth buffer, " +
+                "and hidden tiles are neither refined nor loaded. Tiles are only culled " +
+                "while a single camera is used with the tileset.");
+            EditorGUILayout.PropertyField(
+                this._enableOcclusionCulling, enableOcclusionCullingContent);
+
             GUIContent enforceCulledScreenSpaceErrorContent = new GUIContent(
                 "Enforce Culled Screen Space Error",
                 "Whether a specified screen-space error should be enforced for tiles " +
@@ -441,6 +503,34 @@ namespace CesiumForUnity
                 "textures. "
             );
             EditorGUILayout.PropertyField(this._ignoreKhrMaterialsUnlit, ignoreKhrMaterialsUnlit);
+
+            GUIContent shareMaterialsContent = new GUIContent(
+                "Share Materials",
+                "Whether tiles with identical material parameters should share a single " +
+                "Material instance, which allows Unity to batch their draw calls." +
+                "\n\n" +
+                "When enabled, raster overlays are applied with a MaterialPropertyBlock on " +
+                "each renderer, and changes to a tile's sharedMaterial affect every tile " +
+                "that shares it.");
+            EditorGUILayout.PropertyField(this._shareMaterials, shareMaterialsContent);
+
+            GUIContent useRasterOverlayAtlasContent = new GUIContent(
+                "Use Raster Overlay Atlas",
+                "Whether raster overlay textures of the same size and format should be " +
+                "packed into shared Texture2DArrays, with each renderer given a slice index " +
+                "through a MaterialPropertyBlock." +
+                "\n\n" +
+                "This requires a tileset material whose shader samples the " +
+                "_overlayTextureArray_KEY and _overlayTextureSliceIndex_KEY properties.");
+            EditorGUILayout.PropertyField(this._useRasterOverlayAtlas, useRasterOverlayAtlasContent);
+
+            GUIContent compositeRasterOverlaysContent = new GUIContent(
+                "Composite Raster Overlays",
+                "Whether the raster overlays of each tile should be blended into a single " +
+                "texture on a worker thread, which is assigned to the first overlay." +
+                "\n\n" +
+                "When enabled, Use Raster Overlay Atlas is ignored.");
+            EditorGUILayout.PropertyField(this._compositeRasterOverlays, compositeRasterOverlaysContent);
         }
 
         private void DrawPointCloudShadingProperties()
@@ -537,6 +627,18 @@ namespace CesiumForUnity
                 "Log Selection Stats",
                 "Whether to log details about the tile selection process.");
             EditorGUILayout.PropertyField(this._logSelectionStats, logSelectionStatsContent);
+
+            GUIContent recordFrameStatsContent = new GUIContent(
+                "Record Frame Stats",
+                "Whether to record statistics about each update of this tileset, which " +
+                "can be retrieved with Cesium3DTileset.GetFrameStats.");
+            EditorGUI.BeginChangeCheck();
+            EditorGUILayout.PropertyField(this._recordFrameStats, recordFrameStatsContent);
+            if (EditorGUI.EndChangeCheck())
+            {
+                // Start or stop recording in the native tileset.
+                this._tileset.recordFrameStats = this._recordFrameStats.boolValue;
+            }
         }
 
         private void DrawPhysicsProperties()
@@ -12,6 +12,7 @@ namespace CesiumForUnity
         private SerializedProperty _flyToMaximumAltitudeCurve;
         private SerializedProperty _flyToDuration;
         private SerializedProperty _flyToGranularityDegrees;
+        private SerializedProperty _prefetchTilesAlongFlight;
 
         private void OnEnable()
         {
@@ -25,6 +26,8 @@ namespace CesiumForUnity
                 this.serializedObject.FindProperty("_flyToDuration");
             this._flyToGranularityDegrees =
                 this.serializedObject.FindProperty("_flyToGranularityDegrees");
+            this._prefetchTilesAlongFlight =
+                this.serializedObject.FindProperty("_prefetchTilesAlongFlight");
         }
 
         public override void OnInspectorGUI()
@@ -72,6 +75,17 @@ namespace CesiumForUnity
                 "The length in seconds that the camera flight should last.");
             EditorGUILayout.PropertyField(
                 this._flyToDuration, flyToDurationContent);
+
+            GUIContent prefetchTilesAlongFlightContent = new GUIContent(
+                "Prefetch Tiles Along Flight",
+                "Whether tilesets should load the tiles needed along the flight, " +
+                "and at its destination, before the camera gets there." +
+                "\n\n" +
+                "These tiles are loaded at a lower priority than the tiles for " +
+                "the current view, and tiles for views that will be reached " +
+                "sooner are loaded first.");
+            EditorGUILayout.PropertyField(
+                this._prefetchTilesAlongFlight, prefetchTilesAlongFlightContent);
         }
     }
 }
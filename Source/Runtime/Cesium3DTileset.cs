@@ -2,7 +2,9 @@ using Reinterop;
 using System;
 using System.Collections;
 using System.Collections.Generic;
+using System.Threading;
 using System.Threading.Tasks;
+using Unity.Collections;
 using Unity.Mathematics;
 using UnityEngine;
 
@@ -252,7 +254,7 @@ namespace CesiumForUnity
             set
             {
                 this._maximumScreenSpaceError = value;
-                this.RecreateTileset();
+                this.UpdateTilesetOptions();
             }
         }
 
@@ -273,7 +275,7 @@ namespace CesiumForUnity
             set
             {
                 this._preloadAncestors = value;
-                this.RecreateTileset();
+                this.UpdateTilesetOptions();
             }
         }
 
@@ -294,7 +296,7 @@ namespace CesiumForUnity
             set
             {
                 this._preloadSiblings = value;
-                this.RecreateTileset();
+                this.UpdateTilesetOptions();
             }
         }
 
@@ -317,7 +319,7 @@ namespace CesiumForUnity
             set
             {
                 this._forbidHoles = value;
-                this.RecreateTileset();
+                this.UpdateTilesetOptions();
             }
         }
 
@@ -340,10 +342,95 @@ namespace CesiumForUnity
             set
             {
                 this._maximumSimultaneousTileLoads = value;
-                this.RecreateTileset();
+                this.UpdateTilesetOptions();
             }
         }
 
+        [SerializeField]
+        private float _loadPriorityWeight = 1.0f;
+
+        /// <summary>
+        /// The share of the scene-wide limit on simultaneous tile loads that this
+        /// tileset receives, relative to the other tilesets in the scene.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// This only has an effect when
+        /// <see cref="CesiumRuntimeSettings.maximumSimultaneousTileLoads"/> is greater
+        /// than zero. The limit is then divided each frame between the tilesets that
+        /// have tiles waiting to load, in proportion to this weight. A tileset never
+        /// receives more loads than <see cref="maximumSimultaneousTileLoads"/>, and
+        /// every tileset with waiting tiles receives at least one, so that a tileset
+        /// with a low weight still makes progress.
+        /// </para>
+        /// <para>
+        /// For example, giving a terrain tileset a higher weight than a buildings
+        /// tileset makes the ground beneath the camera fill in before distant
+        /// buildings. Changes take effect in the next frame.
+        /// </para>
+        /// </remarks>
+        public float loadPriorityWeight
+        {
+            get => this._loadPriorityWeight;
+            set => this._loadPriorityWeight = Math.Max(value, 0.0f);
+        }
+
+        [SerializeField]
+        private float _predictiveLoadingTime = 0.0f;
+
+        /// <summary>
+        /// How far ahead, in seconds, to predict the motion of each camera in order to
+        /// start loading the tiles it will need before it gets there. Zero disables
+        /// predictive loading.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Each camera's position and orientation are extrapolated from its recent linear
+        /// and angular velocity, and the tiles needed for the predicted views are loaded
+        /// at a lower priority than those needed for the current views. This helps fast
+        /// fly-overs arrive at detailed geometry, at the cost of loading some tiles that
+        /// are never shown when the camera changes course.
+        /// </para>
+        /// <para>
+        /// How many of the predicted tiles were shown, and how many were wasted, is
+        /// reported in <see cref="Cesium3DTilesetFrameStats"/>. Changes take effect in
+        /// the next frame.
+        /// </para>
+        /// </remarks>
+        public float predictiveLoadingTime
+        {
+            get => this._predictiveLoadingTime;
+            set => this._predictiveLoadingTime = Math.Max(value, 0.0f);
+        }
+
+        [SerializeField]
+        private bool _warmStart = false;
+
+        /// <summary>
+        /// Whether to save a snapshot of the camera views while this tileset is in
+        /// use, and to load the tiles for those views when the tileset is next
+        /// loaded.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// The snapshot is saved every few seconds and when the tileset is destroyed,
+        /// in <see cref="Application.temporaryCachePath"/>. When the tileset is loaded,
+        /// the tiles for the saved views are loaded along with the tiles for the live
+        /// cameras, usually from the request cache, so that an application that
+        /// starts where it was closed reaches full detail sooner. The saved views get
+        /// a smaller share of the tile loads than the live cameras, and are dropped
+        /// once their tiles have all loaded, or after 30 seconds.
+        /// </para>
+        /// <para>
+        /// Changes take effect the next time the tileset is loaded.
+        /// </para>
+        /// </remarks>
+        public bool warmStart
+        {
+            get => this._warmStart;
+            set => this._warmStart = value;
+        }
+
         [SerializeField]
         private long _maximumCachedBytes = 512 * 1024 * 1024;
 
@@ -351,11 +438,18 @@ namespace CesiumForUnity
         /// The maximum number of bytes that may be cached for this tileset.
         /// </summary>
         /// <remarks>
+        /// <para>
         /// Note that this value, even if 0, will never cause tiles that are needed
         /// for rendering to be unloaded. However, if the total number of loaded
         /// bytes is greater than this value, tiles will be unloaded until the
         /// total is under this number or until only required tiles remain, whichever
         /// comes first.
+        /// </para>
+        /// <para>
+        /// The loaded bytes include both the tiles' glTF data and the Unity meshes,
+        /// mesh colliders, and textures created from it and from raster overlays, as
+        /// reported by <see cref="GetRenderResourceBytes"/>.
+        /// </para>
         /// </remarks>
         public long maximumCachedBytes
         {
@@ -363,7 +457,7 @@ namespace CesiumForUnity
             set
             {
                 this._maximumCachedBytes = value;
-                this.RecreateTileset();
+                this.UpdateTilesetOptions();
             }
         }
 
@@ -387,7 +481,7 @@ namespace CesiumForUnity
             set
             {
                 this._loadingDescendantLimit = value;
-                this.RecreateTileset();
+                this.UpdateTilesetOptions();
             }
         }
 
@@ -417,7 +511,7 @@ namespace CesiumForUnity
             set
             {
                 this._enableFrustumCulling = value;
-                this.RecreateTileset();
+                this.UpdateTilesetOptions();
             }
         }
 
@@ -444,6 +538,38 @@ namespace CesiumForUnity
             set
             {
                 this._enableFogCulling = value;
+                this.UpdateTilesetOptions();
+            }
+        }
+
+        [SerializeField]
+        private bool _enableOcclusionCulling = false;
+
+        /// <summary>
+        /// Whether to cull tiles that are hidden behind the tiles already rendered by
+        /// this and other tilesets that enable occlusion culling.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Each frame, the rendered tiles of these tilesets are rasterized on the CPU
+        /// into a coarse depth buffer for the camera. In the next frame, tiles whose
+        /// bounding volumes are entirely behind that depth are neither refined nor
+        /// loaded. This saves loading the many hidden tiles in cities and mountainous
+        /// terrain.
+        /// </para>
+        /// <para>
+        /// Tiles are only culled while a single camera is used with the tileset and
+        /// that camera is nearly still, and may take a frame to appear after the
+        /// geometry in front of them moves out of the way. Changing this recreates the
+        /// tileset.
+        /// </para>
+        /// </remarks>
+        public bool enableOcclusionCulling
+        {
+            get => this._enableOcclusionCulling;
+            set
+            {
+                this._enableOcclusionCulling = value;
                 this.RecreateTileset();
             }
         }
@@ -483,7 +609,7 @@ namespace CesiumForUnity
             set
             {
                 this._enforceCulledScreenSpaceError = value;
-                this.RecreateTileset();
+                this.UpdateTilesetOptions();
             }
         }
 
@@ -520,7 +646,7 @@ namespace CesiumForUnity
             set
             {
                 this._culledScreenSpaceError = value;
-                this.RecreateTileset();
+                this.UpdateTilesetOptions();
             }
         }
 
@@ -616,6 +742,111 @@ namespace CesiumForUnity
             }
         }
 
+        [SerializeField]
+        private bool _shareMaterials = false;
+
+        /// <summary>
+        /// Whether tiles with identical material parameters should share a single
+        /// Material instance.
+        /// </summary>
+        /// <remarks>
+        /// By default, a new Material is instantiated for every primitive of every tile.
+        /// When this property is true, primitives whose glTF material parameters resolve
+        /// to the same values share one Material, which reduces material count and allows
+        /// Unity to batch their draw calls. Materials that use glTF textures are only
+        /// shared by primitives that use the same textures of the same tile, and their
+        /// textures are created once for all of them. Raster overlays, which differ
+        /// for each tile, are then applied through a MaterialPropertyBlock on each
+        /// renderer instead of on the Material.
+        /// 
+        /// Code that modifies <c>MeshRenderer.sharedMaterial</c> on tile game objects,
+        /// for example in <see cref="OnTileGameObjectCreated"/>, will affect every tile
+        /// that shares the Material. Use <c>MeshRenderer.material</c> to modify a single
+        /// tile instead.
+        /// </remarks>
+        public bool shareMaterials
+        {
+            get => this._shareMaterials;
+            set
+            {
+                this._shareMaterials = value;
+                this.RecreateTileset();
+            }
+        }
+
+        [SerializeField]
+        private bool _useRasterOverlayAtlas = false;
+
+        /// <summary>
+        /// Whether raster overlay textures of the same size and format should be packed
+        /// into the slices of shared Texture2DArrays.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// By default, each raster overlay tile is a separate texture assigned to the
+        /// <c>_overlayTexture_KEY</c> property of the tile's material. When this property
+        /// is true, overlay textures are instead copied into a slice of a shared
+        /// Texture2DArray, and each renderer receives the following properties through a
+        /// MaterialPropertyBlock, leaving its Material untouched:
+        /// </para>
+        /// <list type="bullet">
+        /// <item><b>Overlay Texture Array</b>: _overlayTextureArray_KEY</item>
+        /// <item><b>Overlay Texture Slice Index</b>: _overlayTextureSliceIndex_KEY, or -1 if no overlay is attached</item>
+        /// <item><b>Overlay Texture Coordinate Index</b>: _overlayTextureCoordinateIndex_KEY</item>
+        /// <item><b>Overlay Translation and Scale</b>: _overlayTranslationAndScale_KEY</item>
+        /// </list>
+        /// <para>
+        /// The default tileset materials do not sample texture arrays, so this requires
+        /// an <see cref="opaqueMaterial"/> whose shader does, for example with the
+        /// <c>CesiumSampleRasterOverlayAtlas</c> function in
+        /// <c>CesiumRasterOverlayAtlas.hlsl</c>. Combined with <see cref="shareMaterials"/>,
+        /// this lets tiles with different overlays share a Material. If the platform
+        /// cannot copy between 2D textures and texture arrays, or the material lacks the
+        /// texture array and slice index properties of an overlay, a warning is logged
+        /// and overlays are applied as separate textures.
+        /// </para>
+        /// </remarks>
+        public bool useRasterOverlayAtlas
+        {
+            get => this._useRasterOverlayAtlas;
+            set
+            {
+                this._useRasterOverlayAtlas = value;
+                this.RecreateTileset();
+            }
+        }
+
+        [SerializeField]
+        private bool _compositeRasterOverlays = false;
+
+        /// <summary>
+        /// Whether the raster overlays of each tile should be blended into a single
+        /// texture per set of overlay texture coordinates.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Compositing happens on a worker thread whenever the overlays attached to a
+        /// tile change. Overlays are blended in the order they were added to the tileset.
+        /// The composite is assigned to the properties of the first overlay in each
+        /// group, and the textures of the other overlays in the group are cleared.
+        /// </para>
+        /// <para>
+        /// Only uncompressed 8-bit images can be composited. The default tileset
+        /// materials still sample a texture for every overlay, so with them this does not
+        /// reduce the cost of rendering a tile. When this property is true,
+        /// <see cref="useRasterOverlayAtlas"/> is ignored.
+        /// </para>
+        /// </remarks>
+        public bool compositeRasterOverlays
+        {
+            get => this._compositeRasterOverlays;
+            set
+            {
+                this._compositeRasterOverlays = value;
+                this.RecreateTileset();
+            }
+        }
+
         [SerializeField]
         private CesiumPointCloudShading _pointCloudShading = new CesiumPointCloudShading();
 
@@ -644,12 +875,12 @@ namespace CesiumForUnity
             }
         }
 
-        // Normally tilesets are destroyed when anything in the editor changes.
-        // But if suspendUpdate is the only value that has changed, the tileset
-        // should not be reloaded, and instead continue updating after the setting
-        // has been toggled. This variable saves the last value of suspendUpdate,
-        // so OnValidate() can determine if this property was modified. If so, it
-        // prevents the tileset from being destroyed.
+        // Tilesets are destroyed when an option that they can't take in place is
+        // changed in the editor. But if suspendUpdate is the only value that has
+        // changed, the tileset should not be reloaded, and instead continue
+        // updating after the setting has been toggled. This variable saves the last
+        // value of suspendUpdate, so OnValidate() can determine if this property
+        // was modified. If so, it prevents the tileset from being destroyed.
         private bool _previousSuspendUpdate = false;
 
         internal bool previousSuspendUpdate
@@ -705,6 +936,27 @@ namespace CesiumForUnity
             set { this._logSelectionStats = value; }
         }
 
+        [SerializeField]
+        private bool _recordFrameStats = false;
+
+        /// <summary>
+        /// Whether to record statistics about each update of this tileset.
+        /// </summary>
+        /// <remarks>
+        /// Statistics for the most recent 256 updates are kept, and can be retrieved
+        /// with <see cref="GetFrameStats"/>. When this is false, no statistics are
+        /// gathered.
+        /// </remarks>
+        public bool recordFrameStats
+        {
+            get => this._recordFrameStats;
+            set
+            {
+                this._recordFrameStats = value;
+                this.SetRecordFrameStats(value);
+            }
+        }
+
         [SerializeField]
         private bool _createPhysicsMeshes = true;
 
@@ -738,6 +990,33 @@ namespace CesiumForUnity
         /// </returns>
         public partial float ComputeLoadProgress();
 
+        /// <summary>
+        /// Gets the total size, in bytes, of the Unity meshes, mesh colliders, and
+        /// textures created for the tiles and raster overlay tiles of this tileset that
+        /// are currently loaded.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Mesh sizes are the sizes of their vertex and index buffers, and texture sizes
+        /// include all mip levels. The physics meshes baked for mesh colliders are not
+        /// exposed by Unity, so their sizes are estimated. Textures of materials shared
+        /// between tiles are counted once. Materials themselves are not counted.
+        /// </para>
+        /// <para>
+        /// Raster overlay textures are counted while they are in use, including the
+        /// texture array slices and composite textures that stand in for them when
+        /// <see cref="useRasterOverlayAtlas"/> or <see cref="compositeRasterOverlays"/>
+        /// is enabled. Released overlay textures kept for reuse by
+        /// <see cref="CesiumRasterOverlayTexturePool"/> are not counted, because that
+        /// pool has its own limit.
+        /// </para>
+        /// <para>
+        /// This memory counts toward <see cref="maximumCachedBytes"/>.
+        /// </para>
+        /// </remarks>
+        /// <returns>The size of the tileset's render resources, in bytes.</returns>
+        public partial long GetRenderResourceBytes();
+
 
         /// <summary>
         /// Destroy and recreate the tilset. All tiles are unloaded, and then the tileset is reloaded
@@ -774,11 +1053,122 @@ namespace CesiumForUnity
         /// <returns>An asynchronous task that will provide the requested heights when complete.</returns>
         public partial Task<CesiumSampleHeightResult> SampleHeightMostDetailed(params double3[] longitudeLatitudeHeightPositions);
 
+        /// <summary>
+        /// Samples the height of this tileset at a batch of cartographic positions, where the
+        /// longitude (X) and latitude (Y) are given in degrees, writing the heights into the
+        /// given arrays in place.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// This works like <see cref="SampleHeightMostDetailed"/>, but reads and writes the
+        /// native arrays directly, so it is much cheaper for large batches, such as when
+        /// clamping many objects to terrain. For each position that is sampled successfully,
+        /// its height (Z) is replaced with the sampled height in meters above the ellipsoid,
+        /// and the element of <paramref name="sampleSuccess"/> at the same index is set to
+        /// true. Other positions are left unchanged, and their element of
+        /// <paramref name="sampleSuccess"/> is set to false.
+        /// </para>
+        /// <para>
+        /// When <paramref name="loadedTilesOnly"/> is true, heights are sampled from the tiles
+        /// that are already loaded, no tiles are loaded for the query, and the arrays are
+        /// filled before this method returns. The height at each position comes from the
+        /// most detailed tile that is loaded there, which may be coarser than the most
+        /// detailed tile available. Heights are interpolated from grids cached as for
+        /// <see cref="SampleHeightCached"/>, so this is suitable for sampling every frame.
+        /// </para>
+        /// <para>
+        /// Otherwise, the most detailed tiles are loaded as needed and the arrays are filled
+        /// when the returned task completes, so they must not be disposed before then. If
+        /// <paramref name="cancellationToken"/> is cancelled first, the task is cancelled
+        /// and the arrays are not written, so they may be disposed right away. Tiles that
+        /// were already requested for the query still finish loading.
+        /// </para>
+        /// </remarks>
+        /// <param name="longitudeLatitudeHeightPositions">
+        /// The cartographic positions for which to sample heights. The X component is the
+        /// Longitude (degrees), the Y component is the Latitude (degrees), and the Z component
+        /// is the Height (meters).
+        /// </param>
+        /// <param name="sampleSuccess">
+        /// Receives whether the height of the position at the same index was sampled. It must
+        /// be at least as long as <paramref name="longitudeLatitudeHeightPositions"/>.
+        /// </param>
+        /// <param name="loadedTilesOnly">
+        /// Whether to sample only from tiles that are already loaded.
+        /// </param>
+        /// <param name="cancellationToken">A token that cancels the query.</param>
+        /// <returns>
+        /// An asynchronous task that provides any warnings that occurred while sampling
+        /// heights, once the arrays have been filled.
+        /// </returns>
+        public Task<string[]> SampleHeights(
+            NativeArray<double3> longitudeLatitudeHeightPositions,
+            NativeArray<bool> sampleSuccess,
+            bool loadedTilesOnly = false,
+            CancellationToken cancellationToken = default)
+        {
+            if (sampleSuccess.Length < longitudeLatitudeHeightPositions.Length)
+            {
+                throw new ArgumentException(
+                    "The sampleSuccess array must be at least as long as the positions array.",
+                    nameof(sampleSuccess));
+            }
+
+            CesiumSampleHeightBatch batch = new CesiumSampleHeightBatch(cancellationToken);
+            if (!cancellationToken.IsCancellationRequested)
+            {
+                this.SampleHeightsNative(
+                    longitudeLatitudeHeightPositions,
+                    sampleSuccess,
+                    loadedTilesOnly,
+                    batch);
+            }
+            return batch.task;
+        }
+
+        /// <summary>
+        /// Samples the height of this tileset at a cartographic position from the tiles that
+        /// are already loaded, without loading any more.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// The first query that lands on a tile extracts a grid of heights from it, and later
+        /// queries in that tile are interpolated from the grid, so repeated queries over the
+        /// same area, such as clamping objects to terrain every frame, take only a few
+        /// microseconds each. Grids are discarded when their tiles are unloaded or replaced
+        /// by more detailed tiles.
+        /// </para>
+        /// <para>
+        /// The height comes from the most detailed tile that is loaded at the position, which
+        /// may be coarser than the most detailed tile available. The geometric error of the
+        /// tile, plus the most that its grid differs from its triangles, is returned with
+        /// the height, so that callers who need more accuracy can use
+        /// <see cref="SampleHeightMostDetailed"/> instead.
+        /// </para>
+        /// </remarks>
+        /// <param name="longitude">The longitude of the position, in degrees.</param>
+        /// <param name="latitude">The latitude of the position, in degrees.</param>
+        /// <returns>The sampled height.</returns>
+        public partial CesiumTerrainHeightSample SampleHeightCached(double longitude, double latitude);
+
+        /// <summary>
+        /// Copies the statistics of the most recent updates of this tileset, recorded while
+        /// <see cref="recordFrameStats"/> is true.
+        /// </summary>
+        /// <remarks>
+        /// Statistics are copied from oldest to newest. If there are more recorded updates
+        /// than fit in <paramref name="stats"/>, only the most recent ones are copied.
+        /// </remarks>
+        /// <param name="stats">The array to receive the statistics.</param>
+        /// <returns>The number of elements of <paramref name="stats"/> that were written.</returns>
+        public partial int GetFrameStats(NativeArray<Cesium3DTilesetFrameStats> stats);
+
         #endregion
 
         #region Private Methods
 
         private partial void SetShowCreditsOnScreen(bool value);
+        private partial void SetRecordFrameStats(bool value);
 
         private partial void Start();
         private partial void Update();
@@ -788,6 +1178,16 @@ namespace CesiumForUnity
         private partial void OnDisable();
 
         internal partial void UpdateOverlayMaterialKeys();
+        private partial void UpdateTilesetOptions();
+        private partial void SampleHeightsNative(
+            NativeArray<double3> longitudeLatitudeHeightPositions,
+            NativeArray<bool> sampleSuccess,
+            bool loadedTilesOnly,
+            CesiumSampleHeightBatch batch);
+
+        internal partial bool StartCameraPathRecording(string path);
+        internal partial bool StartCameraPathReplay(string path, bool loop);
+        internal partial void StopCameraPath();
 
         #endregion
 
@@ -0,0 +1,127 @@
+namespace CesiumForUnity
+{
+    /// <summary>
+    /// Statistics about a single update of a <see cref="Cesium3DTileset"/>.
+    /// </summary>
+    /// <remarks>
+    /// Statistics are only recorded while <see cref="Cesium3DTileset.recordFrameStats"/>
+    /// is true. Use <see cref="Cesium3DTileset.GetFrameStats"/> to retrieve them. All
+    /// times are main thread times in milliseconds.
+    /// </remarks>
+    public struct Cesium3DTilesetFrameStats
+    {
+        /// <summary>
+        /// The value of <see cref="UnityEngine.Time.frameCount"/> during the update.
+        /// </summary>
+        public int frameCount;
+
+        /// <summary>
+        /// The number of tiles visited during tile selection.
+        /// </summary>
+        public int tilesVisited;
+
+        /// <summary>
+        /// The number of tiles that were visited even though they were culled.
+        /// </summary>
+        public int culledTilesVisited;
+
+        /// <summary>
+        /// The number of tiles that were culled.
+        /// </summary>
+        public int tilesCulled;
+
+        /// <summary>
+        /// The number of tiles selected for rendering.
+        /// </summary>
+        public int tilesRendered;
+
+        /// <summary>
+        /// The deepest level of the tile hierarchy that was visited.
+        /// </summary>
+        public int maxDepthVisited;
+
+        /// <summary>
+        /// The number of tiles waiting to be loaded on worker threads.
+        /// </summary>
+        public int workerThreadTileLoadQueueLength;
+
+        /// <summary>
+        /// The number of tiles waiting to be finished on the main thread.
+        /// </summary>
+        public int mainThreadTileLoadQueueLength;
+
+        /// <summary>
+        /// The number of tiles currently loaded.
+        /// </summary>
+        public int tilesLoaded;
+
+        /// <summary>
+        /// The number of bytes of tile data currently loaded.
+        /// </summary>
+        public long bytesResident;
+
+        /// <summary>
+        /// The number of bytes of Unity meshes, mesh colliders, and textures created
+        /// for the loaded tiles and raster overlay tiles. See
+        /// <see cref="Cesium3DTileset.GetRenderResourceBytes"/>.
+        /// </summary>
+        public long renderResourceBytes;
+
+        /// <summary>
+        /// The number of tile game objects that were activated or deactivated.
+        /// </summary>
+        public int visibilityChanges;
+
+        /// <summary>
+        /// The time spent dispatching main thread tasks, such as finishing tile loads
+        /// that completed on worker threads.
+        /// </summary>
+        public double dispatchTime;
+
+        /// <summary>
+        /// The time spent selecting the tiles to render for the current cameras.
+        /// </summary>
+        public double selectionTime;
+
+        /// <summary>
+        /// The time spent loading and unloading tiles on the main thread, including
+        /// creating their game objects, meshes, and textures.
+        /// </summary>
+        public double prepareTime;
+
+        /// <summary>
+        /// The time spent applying raster overlays to tiles.
+        /// </summary>
+        public double overlayTime;
+
+        /// <summary>
+        /// The time spent showing and hiding tile game objects.
+        /// </summary>
+        public double visibilityTime;
+
+        /// <summary>
+        /// The total number of tiles that were loaded for a predicted camera view
+        /// since the tileset was loaded. See <see cref="Cesium3DTileset.predictiveLoadingTime"/>.
+        /// </summary>
+        public long predictedTilesLoaded;
+
+        /// <summary>
+        /// The total number of tiles loaded for a predicted camera view that were
+        /// later shown. Divided by the sum of this and
+        /// <see cref="predictedTilesWasted"/>, this gives the prediction hit rate.
+        /// </summary>
+        public long predictedTilesShown;
+
+        /// <summary>
+        /// The total number of tiles loaded for a predicted camera view that were
+        /// unloaded without ever being shown.
+        /// </summary>
+        public long predictedTilesWasted;
+
+        /// <summary>
+        /// The total size of the glTF data of the tiles counted by
+        /// <see cref="predictedTilesWasted"/>, in bytes.
+        /// </summary>
+        public long predictedBytesWasted;
+    }
+}
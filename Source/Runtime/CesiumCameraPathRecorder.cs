@@ -0,0 +1,171 @@
+using System.IO;
+using UnityEngine;
+
+namespace CesiumForUnity
+{
+    /// <summary>
+    /// Specifies what a <see cref="CesiumCameraPathRecorder"/> does.
+    /// </summary>
+    public enum CesiumCameraPathRecorderMode
+    {
+        /// <summary>
+        /// The views of the live cameras are written to the file as the tileset
+        /// is updated.
+        /// </summary>
+        Record,
+
+        /// <summary>
+        /// The tileset is updated for the views read from the file instead of the
+        /// live cameras.
+        /// </summary>
+        Replay
+    }
+
+    /// <summary>
+    /// Records the camera views that a <see cref="Cesium3DTileset"/> is updated for,
+    /// or replays a recording in place of the live cameras.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// While recording, each update of the tileset writes one row per camera to a CSV
+    /// file, holding exactly the view that tile selection used, in the tileset's
+    /// Earth-Centered, Earth-Fixed coordinates, followed by the number of tiles
+    /// rendered, loaded, and waiting to load, the bytes resident, and the update time.
+    /// </para>
+    /// <para>
+    /// While replaying, each update of the tileset uses the views of the next
+    /// recorded update, whatever the frame rate, so a performance problem captured
+    /// on one machine selects the same tiles in the same order on another. The
+    /// recording can also be replayed without Unity by the tile streaming benchmark.
+    /// </para>
+    /// <para>
+    /// Orthographic cameras are replayed as perspective cameras.
+    /// </para>
+    /// </remarks>
+    [RequireComponent(typeof(Cesium3DTileset))]
+    [DisallowMultipleComponent]
+    [AddComponentMenu("Cesium/Cesium Camera Path Recorder")]
+    [IconAttribute("Packages/com.cesium.unity/Editor/Resources/Cesium-24x24.png")]
+    public class CesiumCameraPathRecorder : MonoBehaviour
+    {
+        [SerializeField]
+        [Tooltip("Whether to record the views of the live cameras, or replay a " +
+                 "recording in place of them.")]
+        private CesiumCameraPathRecorderMode _mode = CesiumCameraPathRecorderMode.Record;
+
+        /// <summary>
+        /// Whether to record the views of the live cameras, or replay a recording in
+        /// place of them.
+        /// </summary>
+        /// <remarks>
+        /// Changing this while the component is enabled ends the current recording or
+        /// replay and starts a new one.
+        /// </remarks>
+        public CesiumCameraPathRecorderMode mode
+        {
+            get => this._mode;
+            set
+            {
+                this._mode = value;
+                this.Restart();
+            }
+        }
+
+        [SerializeField]
+        [Tooltip("The file to record to or replay from. A relative path is relative to " +
+                 "Application.persistentDataPath.")]
+        private string _filePath = "camera-path.csv";
+
+        /// <summary>
+        /// The file to record to or replay from. A relative path is relative to
+        /// <see cref="Application.persistentDataPath"/>.
+        /// </summary>
+        /// <remarks>
+        /// Recording replaces the file if it already exists. Changing this while the
+        /// component is enabled ends the current recording or replay and starts a new
+        /// one.
+        /// </remarks>
+        public string filePath
+        {
+            get => this._filePath;
+            set
+            {
+                this._filePath = value;
+                this.Restart();
+            }
+        }
+
+        [SerializeField]
+        [Tooltip("Whether a replay starts over after the last recorded update, rather " +
+                 "than holding its views.")]
+        private bool _loopReplay = false;
+
+        /// <summary>
+        /// Whether a replay starts over after the last recorded update, rather than
+        /// holding its views.
+        /// </summary>
+        public bool loopReplay
+        {
+            get => this._loopReplay;
+            set
+            {
+                this._loopReplay = value;
+                this.Restart();
+            }
+        }
+
+        /// <summary>
+        /// Whether a recording or replay is in progress.
+        /// </summary>
+        public bool isActive => this._isActive;
+
+        private bool _isActive = false;
+
+        private void OnEnable()
+        {
+            Cesium3DTileset tileset = this.GetComponent<Cesium3DTileset>();
+            if (tileset == null)
+            {
+                return;
+            }
+
+            string path = Path.Combine(Application.persistentDataPath, this._filePath);
+            if (this._mode == CesiumCameraPathRecorderMode.Record)
+            {
+                this._isActive = tileset.StartCameraPathRecording(path);
+            }
+            else
+            {
+                this._isActive = tileset.StartCameraPathReplay(path, this._loopReplay);
+            }
+
+            if (!this._isActive)
+            {
+                Debug.LogWarning(
+                    "CesiumCameraPathRecorder could not " +
+                    (this._mode == CesiumCameraPathRecorderMode.Record ? "record to " : "replay ") +
+                    path + ".");
+            }
+        }
+
+        private void OnDisable()
+        {
+            Cesium3DTileset tileset = this.GetComponent<Cesium3DTileset>();
+            if (tileset != null)
+            {
+                tileset.StopCameraPath();
+            }
+
+            this._isActive = false;
+        }
+
+        private void Restart()
+        {
+            if (this.isActiveAndEnabled)
+            {
+                this.OnDisable();
+                this.OnEnable();
+            }
+        }
+    }
+}
@@ -0,0 +1,50 @@
+using Reinterop;
+using Unity.Mathematics;
+using UnityEngine;
+
+namespace CesiumForUnity
+{
+    /// <summary>
+    /// Tells tilesets the path a camera is about to follow, so that they can load
+    /// the tiles needed along it, and at its end, before the camera gets there.
+    /// </summary>
+    /// <remarks>
+    /// Every tileset under a georeference loads the tiles for each upcoming view of
+    /// each path at a lower priority than the tiles for its current views. Views that
+    /// will be reached sooner have a higher priority than views further along the
+    /// path.
+    /// </remarks>
+    [ReinteropNativeImplementation("CesiumForUnityNative::CesiumFlightPathPrefetchImpl", "CesiumFlightPathPrefetchImpl.h", staticOnly: true)]
+    internal static partial class CesiumFlightPathPrefetch
+    {
+        /// <summary>
+        /// Sets, or replaces, the path that a camera is expected to follow.
+        /// </summary>
+        /// <param name="pathID">Identifies the path, so that it can be replaced or cleared.</param>
+        /// <param name="georeference">The georeference whose ellipsoid defines the
+        /// East-Up-North frames of the orientations.</param>
+        /// <param name="camera">The camera whose frustum is used for the upcoming views.</param>
+        /// <param name="positions">The positions of the camera along the path, in ECEF
+        /// coordinates.</param>
+        /// <param name="directions">The forward directions of the camera at each
+        /// position, in the East-Up-North frame at that position.</param>
+        /// <param name="ups">The up directions of the camera at each position, in the
+        /// East-Up-North frame at that position.</param>
+        /// <param name="arrivalTimes">The value of <see cref="Time.timeAsDouble"/> at
+        /// which the camera is expected to reach each position, in increasing order.</param>
+        public static partial void SetPath(
+            int pathID,
+            CesiumGeoreference georeference,
+            Camera camera,
+            double3[] positions,
+            double3[] directions,
+            double3[] ups,
+            double[] arrivalTimes);
+
+        /// <summary>
+        /// Removes a path, so that tilesets no longer load tiles for it.
+        /// </summary>
+        /// <param name="pathID">The ID passed to <see cref="SetPath"/>.</param>
+        public static partial void ClearPath(int pathID);
+    }
+}
@@ -79,6 +79,25 @@ namespace CesiumForUnity
             set => this._flyToDuration = Math.Max(value, 0.0);
         }
 
+        [SerializeField]
+        private bool _prefetchTilesAlongFlight = true;
+
+        /// <summary>
+        /// Whether tilesets should load the tiles needed along the flight, and at its
+        /// destination, before the controller gets there.
+        /// </summary>
+        /// <remarks>
+        /// The tiles for views that will be reached sooner are loaded first. They are
+        /// always loaded at a lower priority than the tiles for the current view, so
+        /// this reduces the number of missing or coarse tiles during and after a
+        /// flight without delaying the tiles that are visible now.
+        /// </remarks>
+        public bool prefetchTilesAlongFlight
+        {
+            get => this._prefetchTilesAlongFlight;
+            set => this._prefetchTilesAlongFlight = value;
+        }
+
         #region Deprecated Functionality
         [Min(0.0f)]
         private double _flyToGranularityDegrees = 0.01;
@@ -151,6 +170,10 @@ namespace CesiumForUnity
         private bool _flyingToLocation = false;
         private bool _canInterruptFlight = true;
 
+        // The number of views along the flight that are planned. Tiles are
+        // prefetched for the next two of them at a time.
+        const int prefetchViewCount = 8;
+
         void Awake()
         {
             this._georeference = this.gameObject.GetComponentInParent<CesiumGeoreference>();
@@ -186,6 +209,11 @@ namespace CesiumForUnity
             }
         }
 
+        void OnDisable()
+        {
+            CesiumFlightPathPrefetch.ClearPath(this.GetInstanceID());
+        }
+
 #if UNITY_EDITOR
         // Ensures required components are present in the editor.
         private void Reset()
@@ -264,28 +292,56 @@ namespace CesiumForUnity
 
             this._currentFlyToTime += deltaTime;
 
-            double flyPercentage = 0.0;
-            if (this._currentFlyToTime >= this._flyToDuration)
+            double flyPercentage = this.ComputeFlyPercentage(this._currentFlyToTime);
+
+            // If we're have it to the end of the flight, or if the flight we're taking isn't actually moving or rotating us at all, we're done.
+            if (flyPercentage == 1.0 || (this._flightPathLength == 0.0 && this._sourceRotation == this._destinationRotation))
             {
-                flyPercentage = 1.0;
+                this.CompleteFlight();
+                return;
+            }
+
+            double altituteOffset = this.ComputeAltitudeOffset(flyPercentage);
+
+            // Update position.
+            double3 currentPosition = this._flightPath.GetPosition(flyPercentage, altituteOffset);
+            this._previousPositionECEF = currentPosition;
+            this._globeAnchor.positionGlobeFixed = currentPosition;
+
+            Quaternion currentQuat = Quaternion.Slerp(this._sourceRotation, this._destinationRotation, (float)flyPercentage);
+            this._globeAnchor.rotationEastUpNorth = currentQuat;
+        }
+
+        /// <summary>
+        /// Computes the fraction of the flight path that is covered at the given time
+        /// into the flight.
+        /// </summary>
+        /// <param name="flyToTime">The time since the start of the flight, in seconds.</param>
+        /// <returns>The fraction of the flight path, from 0 to 1.</returns>
+        private double ComputeFlyPercentage(double flyToTime)
+        {
+            if (flyToTime >= this._flyToDuration)
+            {
+                return 1.0;
             }
             else if (this._flyToProgressCurve != null && this._flyToProgressCurve.length > 0)
             {
                 // Sample the progress curve if we have one
-                flyPercentage = math.clamp(this._flyToProgressCurve.Evaluate((float)(this._currentFlyToTime / this._flyToDuration)), 0.0, 1.0);
+                return math.clamp(this._flyToProgressCurve.Evaluate((float)(flyToTime / this._flyToDuration)), 0.0, 1.0);
             }
             else
             {
-                flyPercentage = this._currentFlyToTime / this._flyToDuration;
-            }
-
-            // If we're have it to the end of the flight, or if the flight we're taking isn't actually moving or rotating us at all, we're done.
-            if (flyPercentage == 1.0 || (this._flightPathLength == 0.0 && this._sourceRotation == this._destinationRotation))
-            {
-                this.CompleteFlight();
-                return;
+                return flyToTime / this._flyToDuration;
             }
+        }
 
+        /// <summary>
+        /// Computes the height above the flight path at the given fraction of the path.
+        /// </summary>
+        /// <param name="flyPercentage">The fraction of the flight path, from 0 to 1.</param>
+        /// <returns>The height in meters.</returns>
+        private double ComputeAltitudeOffset(double flyPercentage)
+        {
             // Calculate the height above the surface. If we have a profile curve, use it as well.
             double altituteOffset = 0.0;
             if (this._maxHeight != 0.0 && this.flyToAltitudeProfileCurve != null && this.flyToAltitudeProfileCurve.length > 0)
@@ -294,17 +350,66 @@ namespace CesiumForUnity
                 altituteOffset += curveOffset;
             }
 
-            // Update position.
-            double3 currentPosition = this._flightPath.GetPosition(flyPercentage, altituteOffset);
-            this._previousPositionECEF = currentPosition;
-            this._globeAnchor.positionGlobeFixed = currentPosition;
+            return altituteOffset;
+        }
 
-            Quaternion currentQuat = Quaternion.Slerp(this._sourceRotation, this._destinationRotation, (float)flyPercentage);
-            this._globeAnchor.rotationEastUpNorth = currentQuat;
+        /// <summary>
+        /// Tells tilesets about the views along the flight that was just computed, so
+        /// that they can load the tiles for them ahead of time.
+        /// </summary>
+        private void PrefetchFlightPath()
+        {
+            if (!this._prefetchTilesAlongFlight || this._flyToDuration <= 0.0)
+            {
+                return;
+            }
+
+            Camera camera = this.GetComponent<Camera>();
+            if (camera == null)
+            {
+                camera = Camera.main;
+            }
+
+            if (camera == null)
+            {
+                return;
+            }
+
+            double3[] positions = new double3[prefetchViewCount];
+            double3[] directions = new double3[prefetchViewCount];
+            double3[] ups = new double3[prefetchViewCount];
+            double[] arrivalTimes = new double[prefetchViewCount];
+
+            double startTime = Time.timeAsDouble;
+            for (int i = 0; i < prefetchViewCount; ++i)
+            {
+                double flyToTime = this._flyToDuration * (i + 1) / prefetchViewCount;
+                double flyPercentage = this.ComputeFlyPercentage(flyToTime);
+
+                Quaternion rotation = Quaternion.Slerp(this._sourceRotation, this._destinationRotation, (float)flyPercentage);
+                Vector3 direction = rotation * Vector3.forward;
+                Vector3 up = rotation * Vector3.up;
+
+                positions[i] = this._flightPath.GetPosition(flyPercentage, this.ComputeAltitudeOffset(flyPercentage));
+                directions[i] = new double3(direction.x, direction.y, direction.z);
+                ups[i] = new double3(up.x, up.y, up.z);
+                arrivalTimes[i] = startTime + flyToTime;
+            }
+
+            CesiumFlightPathPrefetch.SetPath(
+                this.GetInstanceID(),
+                this._georeference,
+                camera,
+                positions,
+                directions,
+                ups,
+                arrivalTimes);
         }
 
         private void CompleteFlight()
         {
+            CesiumFlightPathPrefetch.ClearPath(this.GetInstanceID());
+
             this._globeAnchor.positionGlobeFixed = _destinationECEF;
             this._globeAnchor.rotationEastUpNorth = this._destinationRotation;
 
@@ -328,6 +433,8 @@ namespace CesiumForUnity
 
         private void InterruptFlight()
         {
+            CesiumFlightPathPrefetch.ClearPath(this.GetInstanceID());
+
             this._flyingToLocation = false;
             this._currentFlyToTime = 0.0;
 
@@ -416,6 +523,7 @@ namespace CesiumForUnity
             double3 source = this._globeAnchor.positionGlobeFixed;
 
             this.ComputeFlightPath(source, destination, yawAtDestination, pitchAtDestination);
+            this.PrefetchFlightPath();
 
             // Indicate that the controller will be flying from now
             this._flyingToLocation = true;
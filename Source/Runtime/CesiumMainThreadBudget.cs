@@ -0,0 +1,124 @@
+using System;
+
+namespace CesiumForUnity
+{
+    /// <summary>
+    /// Describes how much main thread time was given to tile loading and unloading
+    /// for a single frame, and the measurements that led to that decision.
+    /// </summary>
+    /// <remarks>
+    /// All times are in milliseconds.
+    /// </remarks>
+    public struct CesiumMainThreadBudgetDecision
+    {
+        /// <summary>
+        /// The value of <see cref="UnityEngine.Time.frameCount"/> when the decision
+        /// was made.
+        /// </summary>
+        public int frameCount;
+
+        /// <summary>
+        /// The frame time that the budget aims to stay within.
+        /// </summary>
+        public double targetFrameTime;
+
+        /// <summary>
+        /// The duration of the previous frame, measured from the first tileset update
+        /// of that frame to the first tileset update of this one.
+        /// </summary>
+        public double previousFrameTime;
+
+        /// <summary>
+        /// The main thread time spent by all tilesets in the previous frame
+        /// outside of loading and unloading tiles, such as selecting tiles,
+        /// dispatching main thread tasks, and applying raster overlays.
+        /// </summary>
+        public double previousFixedTime;
+
+        /// <summary>
+        /// The main thread time spent by all tilesets in the previous frame loading
+        /// and unloading tiles, including creating their textures and meshes.
+        /// </summary>
+        public double previousBudgetedTime;
+
+        /// <summary>
+        /// The total time given to loading and unloading tiles in this frame, shared
+        /// by all tilesets.
+        /// </summary>
+        public double totalBudget;
+
+        /// <summary>
+        /// The time each tileset may spend loading tiles in this frame.
+        /// </summary>
+        public double loadingTimeLimit;
+
+        /// <summary>
+        /// The time each tileset may spend unloading tiles in this frame.
+        /// </summary>
+        public double unloadingTimeLimit;
+
+        /// <summary>
+        /// The number of tilesets that shared the budget.
+        /// </summary>
+        public int tilesetCount;
+
+        public CesiumMainThreadBudgetDecision(
+            int frameCount,
+            double targetFrameTime,
+            double previousFrameTime,
+            double previousFixedTime,
+            double previousBudgetedTime,
+            double totalBudget,
+            double loadingTimeLimit,
+            double unloadingTimeLimit,
+            int tilesetCount)
+        {
+            this.frameCount = frameCount;
+            this.targetFrameTime = targetFrameTime;
+            this.previousFrameTime = previousFrameTime;
+            this.previousFixedTime = previousFixedTime;
+            this.previousBudgetedTime = previousBudgetedTime;
+            this.totalBudget = totalBudget;
+            this.loadingTimeLimit = loadingTimeLimit;
+            this.unloadingTimeLimit = unloadingTimeLimit;
+            this.tilesetCount = tilesetCount;
+        }
+    }
+
+    /// <summary>
+    /// Reports the decisions of the controller that adapts the main thread time
+    /// given to tile loading and unloading to the application's frame rate.
+    /// </summary>
+    /// <remarks>
+    /// The controller is enabled by <see cref="CesiumRuntimeSettings.adaptiveMainThreadBudget"/>.
+    /// While it is enabled, a decision is made once per frame in which at least one
+    /// tileset updates. When it is disabled, each tileset may spend up to 5 milliseconds
+    /// loading and 5 milliseconds unloading tiles in every frame.
+    /// </remarks>
+    public static class CesiumMainThreadBudget
+    {
+        /// <summary>
+        /// The most recent decision of the controller.
+        /// </summary>
+        public static CesiumMainThreadBudgetDecision lastDecision { get; private set; }
+
+        /// <summary>
+        /// Invoked each time the controller makes a decision.
+        /// </summary>
+        public static event Action<CesiumMainThreadBudgetDecision> OnDecision;
+
+        internal static void RecordDecision(CesiumMainThreadBudgetDecision decision)
+        {
+            lastDecision = decision;
+            OnDecision?.Invoke(decision);
+        }
+
+        internal static double GetTargetFrameRate()
+        {
+            int targetFrameRate = CesiumRuntimeSettings.mainThreadBudgetTargetFrameRate;
+            if (targetFrameRate <= 0)
+                targetFrameRate = UnityEngine.Application.targetFrameRate;
+            return targetFrameRate > 0 ? targetFrameRate : 60.0;
+        }
+    }
+}
@@ -44,17 +44,21 @@ namespace CesiumForUnity
 
         public T Get()
         {
-            if (this._pool != null && this._pool.Count > 0)
+            while (this._pool != null && this._pool.Count > 0)
             {
                 int pos = this._pool.Count - 1;
                 T result = this._pool[pos];
                 this._pool.RemoveAt(pos);
+
+                // Pooled Unity objects may be destroyed out from under the pool,
+                // for example by an editor scene change.
+                if (result is UnityEngine.Object unityObject && unityObject == null)
+                    continue;
+
                 return result;
             }
-            else
-            {
-                return this._createCallback();
-            }
+
+            return this._createCallback();
         }
 
         public void Release(T element)
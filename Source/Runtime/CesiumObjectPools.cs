@@ -1,4 +1,5 @@
 using UnityEngine;
+using UnityEngine.Rendering;
 
 #if UNITY_EDITOR
 using UnityEditor;
@@ -10,11 +11,27 @@ namespace CesiumForUnity
     {
         public static CesiumObjectPool<Mesh> MeshPool => _meshPool;
 
+        /// <summary>
+        /// A pool of empty game objects used as the root of each tile.
+        /// </summary>
+        public static CesiumObjectPool<GameObject> TileGameObjectPool => _tileGameObjectPool;
+
+        /// <summary>
+        /// A pool of game objects used for each primitive of a tile. These always have
+        /// a MeshFilter and a MeshRenderer, and may have a disabled MeshCollider.
+        /// </summary>
+        public static CesiumObjectPool<GameObject> PrimitiveGameObjectPool => _primitiveGameObjectPool;
+
         private static CesiumObjectPool<Mesh> _meshPool;
+        private static CesiumObjectPool<GameObject> _tileGameObjectPool;
+        private static CesiumObjectPool<GameObject> _primitiveGameObjectPool;
 
         public static void Dispose()
         {
             _meshPool.Dispose();
+            _tileGameObjectPool.Dispose();
+            _primitiveGameObjectPool.Dispose();
+            CesiumRasterOverlayTexturePool.Dispose();
         }
 
         static CesiumObjectPools()
@@ -24,11 +41,127 @@ namespace CesiumForUnity
                 (mesh) => mesh.Clear(),
                 (mesh) => UnityLifetime.Destroy(mesh));
 
+            _tileGameObjectPool = new CesiumObjectPool<GameObject>(
+                () => CreatePooledGameObject(),
+                (gameObject) => ResetGameObject(gameObject),
+                (gameObject) => DestroyGameObject(gameObject));
+
+            _primitiveGameObjectPool = new CesiumObjectPool<GameObject>(
+                () =>
+                {
+                    GameObject gameObject = CreatePooledGameObject();
+                    gameObject.AddComponent<MeshFilter>();
+                    gameObject.AddComponent<MeshRenderer>();
+                    return gameObject;
+                },
+                (gameObject) => ResetGameObject(gameObject),
+                (gameObject) => DestroyGameObject(gameObject),
+                4000);
+
 #if UNITY_EDITOR
             EditorApplication.playModeStateChanged += OnPlayModeStateChanged;
 #endif
         }
 
+        private static GameObject CreatePooledGameObject()
+        {
+            GameObject gameObject = new GameObject();
+            gameObject.hideFlags = HideFlags.HideAndDontSave;
+            gameObject.SetActive(false);
+            return gameObject;
+        }
+
+        private static void ResetGameObject(GameObject gameObject)
+        {
+            // The object may have been destroyed along with its tileset.
+            if (gameObject == null)
+                return;
+
+            gameObject.SetActive(false);
+            gameObject.hideFlags = HideFlags.HideAndDontSave;
+            gameObject.name = "";
+            gameObject.layer = 0;
+
+            Transform transform = gameObject.transform;
+            transform.SetParent(null, false);
+            transform.localPosition = Vector3.zero;
+            transform.localRotation = Quaternion.identity;
+            transform.localScale = Vector3.one;
+
+            for (int i = transform.childCount - 1; i >= 0; --i)
+            {
+                UnityLifetime.Destroy(transform.GetChild(i).gameObject);
+            }
+
+            // Remove the components that were added while the object was in use, in
+            // reverse order so that dependent components are removed first. This must
+            // be immediate, because the object may be reused and reactivated within
+            // the same frame.
+            Component[] components = gameObject.GetComponents<Component>();
+            for (int i = components.Length - 1; i >= 0; --i)
+            {
+                Component component = components[i];
+                if (component is Transform)
+                    continue;
+
+                if (component is MeshFilter meshFilter)
+                {
+                    meshFilter.sharedMesh = null;
+                }
+                else if (component is MeshRenderer meshRenderer)
+                {
+                    ResetMeshRenderer(meshRenderer);
+                }
+                else if (component is MeshCollider meshCollider)
+                {
+                    meshCollider.sharedMesh = null;
+                    meshCollider.sharedMaterial = null;
+                    meshCollider.convex = false;
+                    meshCollider.isTrigger = false;
+                    meshCollider.enabled = false;
+                }
+                else
+                {
+                    Object.DestroyImmediate(component);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Restores the settings of a newly-added MeshRenderer, so that changes made by
+        /// <see cref="Cesium3DTileset.OnTileGameObjectCreated"/> handlers don't carry over to
+        /// the next tile that uses the renderer.
+        /// </summary>
+        private static void ResetMeshRenderer(MeshRenderer meshRenderer)
+        {
+            meshRenderer.sharedMaterial = null;
+            meshRenderer.SetPropertyBlock(null);
+            meshRenderer.enabled = true;
+            meshRenderer.forceRenderingOff = false;
+            meshRenderer.shadowCastingMode = ShadowCastingMode.On;
+            meshRenderer.receiveShadows = true;
+            meshRenderer.staticShadowCaster = false;
+            meshRenderer.renderingLayerMask = 1;
+            meshRenderer.rendererPriority = 0;
+            meshRenderer.sortingLayerID = 0;
+            meshRenderer.sortingOrder = 0;
+            meshRenderer.lightProbeUsage = LightProbeUsage.BlendProbes;
+            meshRenderer.reflectionProbeUsage = ReflectionProbeUsage.BlendProbes;
+            meshRenderer.probeAnchor = null;
+            meshRenderer.lightProbeProxyVolumeOverride = null;
+            meshRenderer.motionVectorGenerationMode = MotionVectorGenerationMode.Object;
+            meshRenderer.allowOcclusionWhenDynamic = true;
+            meshRenderer.receiveGI = ReceiveGI.LightProbes;
+        }
+
+        private static void DestroyGameObject(GameObject gameObject)
+        {
+            if (gameObject != null)
+            {
+                UnityLifetime.Destroy(gameObject);
+            }
+        }
+
 #if UNITY_EDITOR
         private static void OnPlayModeStateChanged(PlayModeStateChange obj)
         {
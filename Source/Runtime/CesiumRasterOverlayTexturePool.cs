@@ -0,0 +1,231 @@
+using System;
+using System.Collections.Generic;
+using UnityEngine;
+
+namespace CesiumForUnity
+{
+    /// <summary>
+    /// A pool of textures shared by the raster overlays of all tilesets, so that overlay
+    /// tiles of the same size and format can reuse each other's textures instead of
+    /// allocating new ones.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Pooling is disabled unless <see cref="CesiumRuntimeSettings.maxRasterOverlayTexturePoolBytes"/>
+    /// is greater than zero. While it is enabled, overlay textures are kept readable so that
+    /// their pixels can be replaced in place, which means a copy of each overlay texture is
+    /// also kept in CPU memory.
+    /// </para>
+    /// <para>
+    /// Released textures are kept until the total size of the textures in the pool would
+    /// exceed the maximum, after which further released textures are destroyed.
+    /// </para>
+    /// </remarks>
+    public static class CesiumRasterOverlayTexturePool
+    {
+        private struct Key : IEquatable<Key>
+        {
+            public int width;
+            public int height;
+            public TextureFormat format;
+            public int mipCount;
+            public bool linear;
+
+            public bool Equals(Key other)
+            {
+                return this.width == other.width &&
+                    this.height == other.height &&
+                    this.format == other.format &&
+                    this.mipCount == other.mipCount &&
+                    this.linear == other.linear;
+            }
+
+            public override bool Equals(object obj)
+            {
+                return obj is Key other && this.Equals(other);
+            }
+
+            public override int GetHashCode()
+            {
+                return HashCode.Combine(this.width, this.height, this.format, this.mipCount, this.linear);
+            }
+        }
+
+        private class Bucket
+        {
+            public long bytesPerTexture;
+            public List<Texture2D> textures = new List<Texture2D>();
+        }
+
+        private static Dictionary<Key, Bucket> _pool = new Dictionary<Key, Bucket>();
+
+        // Every texture created by the pool that is currently in use, so that it can be
+        // returned to the right bucket when released.
+        private static Dictionary<Texture2D, Bucket> _activeTextures = new Dictionary<Texture2D, Bucket>();
+
+        private static long _maximumBytes = -1;
+        private static long _pooledBytes = 0;
+        private static int _pooledTextureCount = 0;
+        private static long _reusedTextureCount = 0;
+        private static long _createdTextureCount = 0;
+        private static bool _disposed = false;
+
+        /// <summary>
+        /// The maximum total size of the textures kept in the pool, in bytes. Zero if
+        /// pooling is disabled.
+        /// </summary>
+        public static long maximumPooledBytes
+        {
+            get
+            {
+                if (_maximumBytes < 0)
+                {
+                    _maximumBytes = (long)Math.Min(
+                        CesiumRuntimeSettings.maxRasterOverlayTexturePoolBytes,
+                        (ulong)long.MaxValue);
+                }
+
+                return _disposed ? 0 : _maximumBytes;
+            }
+        }
+
+        /// <summary>
+        /// The total size of the textures currently in the pool waiting to be reused,
+        /// in bytes.
+        /// </summary>
+        public static long pooledBytes => _pooledBytes;
+
+        /// <summary>
+        /// The number of textures currently in the pool waiting to be reused.
+        /// </summary>
+        public static int pooledTextureCount => _pooledTextureCount;
+
+        /// <summary>
+        /// The number of textures created by the pool that are currently in use by
+        /// raster overlay tiles.
+        /// </summary>
+        public static int activeTextureCount => _activeTextures.Count;
+
+        /// <summary>
+        /// The total number of times a texture was taken from the pool instead of
+        /// being created.
+        /// </summary>
+        public static long reusedTextureCount => _reusedTextureCount;
+
+        /// <summary>
+        /// The total number of textures created because no suitable texture was
+        /// available in the pool.
+        /// </summary>
+        public static long createdTextureCount => _createdTextureCount;
+
+        internal static Texture2D Get(int width, int height, TextureFormat format, int mipCount, bool linear)
+        {
+            Key key = new Key()
+            {
+                width = width,
+                height = height,
+                format = format,
+                mipCount = mipCount,
+                linear = linear
+            };
+
+            Texture2D texture = null;
+
+            Bucket bucket;
+            if (_pool.TryGetValue(key, out bucket))
+            {
+                List<Texture2D> textures = bucket.textures;
+                while (texture == null && textures.Count > 0)
+                {
+                    // Pooled textures may be destroyed out from under the pool, for
+                    // example by an editor scene change.
+                    int pos = textures.Count - 1;
+                    texture = textures[pos];
+                    textures.RemoveAt(pos);
+                    --_pooledTextureCount;
+                    _pooledBytes -= bucket.bytesPerTexture;
+                }
+            }
+
+            if (texture != null)
+            {
+                ++_reusedTextureCount;
+            }
+            else
+            {
+                texture = new Texture2D(width, height, format, mipCount, linear);
+                texture.hideFlags = HideFlags.HideAndDontSave;
+                ++_createdTextureCount;
+
+                if (bucket == null)
+                {
+                    bucket = new Bucket()
+                    {
+                        bytesPerTexture = texture.GetRawTextureData<byte>().Length
+                    };
+                    _pool.Add(key, bucket);
+                }
+            }
+
+            _activeTextures[texture] = bucket;
+            return texture;
+        }
+
+        internal static void Release(Texture texture)
+        {
+            Texture2D texture2D = texture as Texture2D;
+            Bucket bucket;
+            if (ReferenceEquals(texture2D, null) || !_activeTextures.Remove(texture2D, out bucket))
+            {
+                // Not created by the pool.
+                if (texture != null)
+                    UnityLifetime.Destroy(texture);
+                return;
+            }
+
+            // Destroyed while in use, for example along with its tileset.
+            if (texture2D == null)
+                return;
+
+            if (_pooledBytes + bucket.bytesPerTexture > maximumPooledBytes)
+            {
+                UnityLifetime.Destroy(texture2D);
+                return;
+            }
+
+            bucket.textures.Add(texture2D);
+            ++_pooledTextureCount;
+            _pooledBytes += bucket.bytesPerTexture;
+        }
+
+        /// <summary>
+        /// Destroys all textures in the pool. Textures that are in use are unaffected
+        /// and will be added back to the pool when they are released.
+        /// </summary>
+        public static void Clear()
+        {
+            foreach (Bucket bucket in _pool.Values)
+            {
+                foreach (Texture2D texture in bucket.textures)
+                {
+                    if (texture != null)
+                        UnityLifetime.Destroy(texture);
+                }
+
+                bucket.textures.Clear();
+            }
+
+            _pooledTextureCount = 0;
+            _pooledBytes = 0;
+        }
+
+        internal static void Dispose()
+        {
+            Clear();
+
+            // Released textures are destroyed from now on, rather than being added
+            // back into the pool.
+            _disposed = true;
+        }
+    }
+}
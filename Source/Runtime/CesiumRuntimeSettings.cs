@@ -184,5 +184,128 @@ namespace CesiumForUnity
         {
             get => instance._maxItems;
         }
+
+        [SerializeField]
+        [Tooltip("Whether to keep a persistent cache of tile textures after they have been processed for rendering, such as by generating mipmaps. The cache shares the pruning settings above. Must restart Unity to apply changes.")]
+        private bool _cacheProcessedTextures = false;
+
+        /// <summary>
+        /// Whether to keep a persistent cache of tile textures after they have been processed
+        /// for rendering.
+        /// </summary>
+        /// <remarks>
+        /// Processed textures are stored in a separate database next to the request cache, keyed
+        /// by the tile URL, the image index, and the pixel format. They are pruned along with
+        /// the request cache, using <see cref="requestsPerCachePrune"/> and <see cref="maxItems"/>.
+        /// Enabling this trades disk space for less CPU time spent preparing textures when tiles
+        /// are loaded again in a later session.
+        /// </remarks>
+        public static bool cacheProcessedTextures
+        {
+            get => instance._cacheProcessedTextures;
+        }
+
+        [SerializeField]
+        [Tooltip("Whether to keep a persistent cache of tile meshes after they have been converted to Unity vertex and index buffers. The cache shares the pruning settings above. Must restart Unity to apply changes.")]
+        private bool _cacheProcessedMeshes = false;
+
+        /// <summary>
+        /// Whether to keep a persistent cache of tile meshes after they have been converted
+        /// to Unity vertex and index buffers.
+        /// </summary>
+        /// <remarks>
+        /// When a cached tile is loaded again, its vertex and index buffers are copied directly
+        /// into the mesh instead of being converted from the glTF, and its bounds do not need
+        /// to be recalculated. Entries are keyed by the tile URL and its <c>ETag</c> or
+        /// <c>Last-Modified</c> header, along with the tileset settings that affect the conversion.
+        /// Tiles served with neither header are not cached, since there is no way to tell when
+        /// they change. Entries are stored and pruned together with
+        /// <see cref="cacheProcessedTextures"/>.
+        /// </remarks>
+        public static bool cacheProcessedMeshes
+        {
+            get => instance._cacheProcessedMeshes;
+        }
+
+        [SerializeField]
+        [Tooltip("The maximum total size, in bytes, of released raster overlay textures to keep for reuse by other overlay tiles of the same size and format. Zero disables pooling. Must restart Unity to apply changes.")]
+        private ulong _maxRasterOverlayTexturePoolBytes = 0;
+
+        /// <summary>
+        /// The maximum total size, in bytes, of released raster overlay textures to keep for
+        /// reuse by other overlay tiles of the same size and format.
+        /// </summary>
+        /// <remarks>
+        /// Zero, the default, disables pooling. When pooling is enabled, overlay textures are
+        /// kept readable so that their pixels can be replaced in place, which keeps a copy of
+        /// each overlay texture in CPU memory. See <see cref="CesiumRasterOverlayTexturePool"/>
+        /// for statistics about the pool.
+        /// </remarks>
+        public static ulong maxRasterOverlayTexturePoolBytes
+        {
+            get => instance._maxRasterOverlayTexturePoolBytes;
+        }
+
+        [SerializeField]
+        [Tooltip("Whether the main thread time given to tile loading and unloading should adapt to the frame rate, instead of being fixed at 5 milliseconds each per tileset.")]
+        private bool _adaptiveMainThreadBudget = false;
+
+        /// <summary>
+        /// Whether the main thread time given to tile loading and unloading should adapt
+        /// to the frame rate.
+        /// </summary>
+        /// <remarks>
+        /// Disabled by default, in which case each tileset may spend 5 milliseconds loading
+        /// and 5 milliseconds unloading tiles in every update. When enabled, the budget
+        /// grows while frames finish within the target frame time and shrinks quickly when
+        /// they do not. Time that tilesets spend on other main thread work, such as
+        /// selecting tiles and dispatching main thread tasks, is subtracted from the
+        /// budget, and the remainder is shared by all tilesets. See
+        /// <see cref="CesiumMainThreadBudget"/> for the decisions made each frame.
+        /// </remarks>
+        public static bool adaptiveMainThreadBudget
+        {
+            get => instance._adaptiveMainThreadBudget;
+        }
+
+        [SerializeField]
+        [Tooltip("The frame rate that the adaptive main thread budget aims to maintain. Zero uses Application.targetFrameRate, or 60 if that is not set.")]
+        private int _mainThreadBudgetTargetFrameRate = 0;
+
+        /// <summary>
+        /// The frame rate that the adaptive main thread budget aims to maintain.
+        /// </summary>
+        /// <remarks>
+        /// Zero, the default, uses <see cref="Application.targetFrameRate"/>, or 60 frames
+        /// per second if that is not set. Set this explicitly for platforms that ignore
+        /// the target frame rate, such as XR devices that render at the display's refresh
+        /// rate.
+        /// </remarks>
+        public static int mainThreadBudgetTargetFrameRate
+        {
+            get => instance._mainThreadBudgetTargetFrameRate;
+        }
+
+        [SerializeField]
+        [Tooltip("The maximum number of tiles that may be loaded simultaneously by all tilesets in the scene combined. Zero lets each tileset load up to its own Maximum Simultaneous Tile Loads.")]
+        private int _maximumSimultaneousTileLoads = 0;
+
+        /// <summary>
+        /// The maximum number of tiles that may be loaded simultaneously by all tilesets
+        /// in the scene combined.
+        /// </summary>
+        /// <remarks>
+        /// Zero, the default, lets each tileset load up to its own
+        /// <see cref="Cesium3DTileset.maximumSimultaneousTileLoads"/>. Otherwise, this
+        /// limit is divided between tilesets according to their
+        /// <see cref="Cesium3DTileset.loadPriorityWeight"/>, so that tilesets in the same
+        /// scene do not compete blindly for the network and worker threads. Every tileset
+        /// with tiles waiting to load may still load at least one tile at a time, so the
+        /// limit can be exceeded when there are more such tilesets than the limit.
+        /// </remarks>
+        public static int maximumSimultaneousTileLoads
+        {
+            get => instance._maximumSimultaneousTileLoads;
+        }
     }
 }
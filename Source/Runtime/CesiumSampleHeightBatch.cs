@@ -0,0 +1,72 @@
+using System;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace CesiumForUnity
+{
+    /// <summary>
+    /// Tracks a call to <see cref="Cesium3DTileset.SampleHeights"/> that is in progress,
+    /// so that it can be cancelled before its results are written.
+    /// </summary>
+    internal class CesiumSampleHeightBatch
+    {
+        private readonly object _lock = new object();
+        private readonly TaskCompletionSource<string[]> _promise =
+            new TaskCompletionSource<string[]>();
+        private readonly CancellationToken _cancellationToken;
+        private CancellationTokenRegistration _registration;
+        private bool _isCancelled;
+        private bool _isCompleting;
+
+        internal CesiumSampleHeightBatch(CancellationToken cancellationToken)
+        {
+            this._cancellationToken = cancellationToken;
+            if (cancellationToken.CanBeCanceled)
+            {
+                this._registration = cancellationToken.Register(this.Cancel);
+            }
+        }
+
+        internal Task<string[]> task => this._promise.Task;
+
+        /// <summary>
+        /// Claims the right to write the results. Once this returns true, the
+        /// batch can no longer be cancelled. If it returns false, the batch was
+        /// cancelled and its arrays must not be touched.
+        /// </summary>
+        internal bool TryStartCompleting()
+        {
+            lock (this._lock)
+            {
+                if (this._isCancelled)
+                    return false;
+                this._isCompleting = true;
+                return true;
+            }
+        }
+
+        internal void Complete(string[] warnings)
+        {
+            this._registration.Dispose();
+            this._promise.TrySetResult(warnings);
+        }
+
+        internal void Fail(string message)
+        {
+            this._registration.Dispose();
+            this._promise.TrySetException(new Exception(message));
+        }
+
+        internal void Cancel()
+        {
+            lock (this._lock)
+            {
+                if (this._isCompleting)
+                    return;
+                this._isCancelled = true;
+            }
+
+            this._promise.TrySetCanceled(this._cancellationToken);
+        }
+    }
+}
@@ -0,0 +1,32 @@
+namespace CesiumForUnity
+{
+    /// <summary>
+    /// A height sampled from the tiles of a <see cref="Cesium3DTileset"/> that are already
+    /// loaded, as returned by <see cref="Cesium3DTileset.SampleHeightCached"/>.
+    /// </summary>
+    public struct CesiumTerrainHeightSample
+    {
+        /// <summary>
+        /// Whether a loaded tile has geometry at the position. If false, the other fields
+        /// are meaningless.
+        /// </summary>
+        public bool success;
+
+        /// <summary>
+        /// The sampled height, in meters above the ellipsoid.
+        /// </summary>
+        public double height;
+
+        /// <summary>
+        /// An estimate of the error in the height, in meters: the geometric error of the
+        /// tile that the height was sampled from, plus the most that the grid of heights
+        /// cached for the tile differs from its triangles.
+        /// </summary>
+        /// <remarks>
+        /// This is a measure of how coarse the tile is. When it is too large for the
+        /// caller's purpose, a more accurate height can be obtained with
+        /// <see cref="Cesium3DTileset.SampleHeightMostDetailed"/>.
+        /// </remarks>
+        public double geometricError;
+    }
+}
@@ -0,0 +1,62 @@
+using Reinterop;
+
+namespace CesiumForUnity
+{
+    /// <summary>
+    /// Records the stages that each tile passes through as it loads, so that the trace
+    /// can be inspected in <c>chrome://tracing</c> or Perfetto.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Tracing is available in every build, without rebuilding the native plugin. Each
+    /// tile appears as its own track, keyed by its content URL, with spans for:
+    /// </para>
+    /// <list type="bullet">
+    /// <item>waiting for the request to start and the HTTP request itself,</item>
+    /// <item>processing the response, which includes decompression, glTF parsing and
+    /// image decoding,</item>
+    /// <item>building the tile's mesh data on a worker thread,</item>
+    /// <item>creating the tile's meshes, and baking its physics meshes if enabled,</item>
+    /// <item>waiting for, and then running, the main thread work that creates the
+    /// tile's game object,</item>
+    /// </list>
+    /// <para>
+    /// followed by a moment for the first time the tile is shown. Requests that are not
+    /// for tile content, such as for raster overlay images, only have request spans.
+    /// </para>
+    /// </remarks>
+    [ReinteropNativeImplementation("CesiumForUnityNative::CesiumTileTracingImpl", "CesiumTileTracingImpl.h", staticOnly: true)]
+    public partial class CesiumTileTracing
+    {
+        private CesiumTileTracing()
+        {}
+
+        /// <summary>
+        /// Whether new tile events are being recorded.
+        /// </summary>
+        /// <remarks>
+        /// Events that were recorded before tracing was disabled are kept until
+        /// <see cref="Clear"/> is called, so a trace can be stopped and then written.
+        /// </remarks>
+        public static bool enabled
+        {
+            get => GetEnabled();
+            set => SetEnabled(value);
+        }
+
+        /// <summary>
+        /// Writes all recorded events to a file in the Chrome trace event format.
+        /// </summary>
+        /// <param name="path">The path of the JSON file to write.</param>
+        /// <returns>True if the file was written.</returns>
+        public static partial bool WriteTrace(string path);
+
+        /// <summary>
+        /// Discards all recorded events.
+        /// </summary>
+        public static partial void Clear();
+
+        private static partial bool GetEnabled();
+        private static partial void SetEnabled(bool value);
+    }
+}
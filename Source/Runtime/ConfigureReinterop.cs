@@ -131,6 +131,18 @@ namespace CesiumForUnity
             texture.wrapModeU = texture.wrapModeU;
             texture.wrapModeV = texture.wrapModeV;
             texture.wrapModeW = texture.wrapModeW;
+            int textureWidth = texture.width;
+            int textureHeight = texture.height;
+            int textureMipmapCount = texture.mipmapCount;
+            GraphicsFormat textureGraphicsFormat = texture.graphicsFormat;
+
+            Texture2DArray textureArray = new Texture2DArray(256, 256, 32, GraphicsFormat.R8G8B8A8_SRGB, TextureCreationFlags.MipChain, 9);
+            textureArray.hideFlags = HideFlags.HideAndDontSave;
+            textureArray.wrapMode = TextureWrapMode.Clamp;
+            textureArray.filterMode = FilterMode.Trilinear;
+            textureArray.anisoLevel = 16;
+            Graphics.CopyTexture(texture, 0, textureArray, 0);
+            CopyTextureSupport copyTextureSupport = SystemInfo.copyTextureSupport;
 
             Mesh mesh = new Mesh();
             Mesh[] meshes = new[] { mesh };
@@ -141,6 +153,7 @@ namespace CesiumForUnity
             mesh.SetUVs(0, new NativeArray<Vector2>());
             mesh.SetIndices(new NativeArray<int>(), MeshTopology.Triangles, 0, true, 0);
             mesh.RecalculateBounds();
+            mesh.bounds = mesh.bounds;
             int vertexCount = mesh.vertexCount;
 
             Vector3[] vertices = mesh.vertices;
@@ -150,6 +163,8 @@ namespace CesiumForUnity
 
             MeshCollider meshCollider = go.AddComponent<MeshCollider>();
             meshCollider.sharedMesh = mesh;
+            meshCollider = go.GetComponent<MeshCollider>();
+            meshCollider.enabled = meshCollider.enabled;
 
             Debug.Log("Logging");
             Debug.LogWarning("Warning");
@@ -158,6 +173,14 @@ namespace CesiumForUnity
             MeshRenderer meshRenderer = new MeshRenderer();
             GameObject meshGameObject = meshRenderer.gameObject;
             meshRenderer.material = UnityEngine.Object.Instantiate(meshRenderer.material);
+            meshRenderer.sharedMaterial = meshRenderer.sharedMaterial;
+
+            MaterialPropertyBlock propertyBlock = new MaterialPropertyBlock();
+            meshRenderer.GetPropertyBlock(propertyBlock);
+            propertyBlock.SetTexture(0, Texture2D.blackTexture);
+            propertyBlock.SetFloat(0, 0.0f);
+            propertyBlock.SetVector(0, new Vector4());
+            meshRenderer.SetPropertyBlock(propertyBlock);
 
             int id = Shader.PropertyToID("name");
             int crc = meshRenderer.material.ComputeCRC();
@@ -168,6 +191,7 @@ namespace CesiumForUnity
             meshRenderer.material.DisableKeyword("keywordName");
             meshRenderer.material.EnableKeyword("keywordName");
             meshRenderer.material.GetTexture(id);
+            meshRenderer.material.HasProperty(id);
             meshRenderer.material.SetTextureOffset(id, new Vector2());
             meshRenderer.material.SetTextureScale(id, new Vector2());
             var ids = new List<int>();
@@ -201,17 +225,38 @@ namespace CesiumForUnity
             NativeArray<Vector2> nav2 =
                 new NativeArray<Vector2>(1, Allocator.Temp, NativeArrayOptions.UninitializedMemory);
             NativeArray<int> nai = new NativeArray<int>(1, Allocator.Temp, NativeArrayOptions.UninitializedMemory);
+            NativeArray<ulong> naul = new NativeArray<ulong>(1, Allocator.Temp, NativeArrayOptions.UninitializedMemory);
+            NativeArray<Cesium3DTilesetFrameStats> nafs =
+                new NativeArray<Cesium3DTilesetFrameStats>(1, Allocator.Temp, NativeArrayOptions.UninitializedMemory);
+            int frameStatsLength = nafs.Length;
+            NativeArray<double3> nad3 =
+                new NativeArray<double3>(1, Allocator.Temp, NativeArrayOptions.UninitializedMemory);
+            NativeArray<bool> nab = new NativeArray<bool>(1, Allocator.Temp, NativeArrayOptions.UninitializedMemory);
+            int heightsLength = nad3.Length + nab.Length;
 
             unsafe
             {
                 NativeArrayUnsafeUtility.GetUnsafeBufferPointerWithoutChecks(nav);
                 NativeArrayUnsafeUtility.GetUnsafeBufferPointerWithoutChecks(nav2);
                 NativeArrayUnsafeUtility.GetUnsafeBufferPointerWithoutChecks(nai);
+                NativeArrayUnsafeUtility.GetUnsafeBufferPointerWithoutChecks(naul);
+                NativeArrayUnsafeUtility.GetUnsafeBufferPointerWithoutChecks(nafs);
+                NativeArrayUnsafeUtility.GetUnsafeBufferPointerWithoutChecks(nad3);
+                NativeArrayUnsafeUtility.GetUnsafeBufferPointerWithoutChecks(nab);
             }
 
+            Helpers.SetGameObjectsActive(naul, 0);
+
+            float unscaledDeltaTime = Time.unscaledDeltaTime;
+            double targetFrameRate = CesiumMainThreadBudget.GetTargetFrameRate();
+            CesiumMainThreadBudget.RecordDecision(
+                new CesiumMainThreadBudgetDecision(0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0));
+
             nav.Dispose();
             nav2.Dispose();
             nai.Dispose();
+            naul.Dispose();
+            nafs.Dispose();
 
             string temporaryCachePath = Application.temporaryCachePath;
             bool isEditor = Application.isEditor;
@@ -278,6 +323,7 @@ namespace CesiumForUnity
             tileset.ionAssetID = tileset.ionAssetID;
             tileset.ionAccessToken = tileset.ionAccessToken;
             tileset.logSelectionStats = tileset.logSelectionStats;
+            tileset.recordFrameStats = tileset.recordFrameStats;
             tileset.opaqueMaterial = tileset.opaqueMaterial;
             tileset.enabled = tileset.enabled;
             tileset.maximumScreenSpaceError = tileset.maximumScreenSpaceError;
@@ -289,12 +335,19 @@ namespace CesiumForUnity
             tileset.loadingDescendantLimit = tileset.loadingDescendantLimit;
             tileset.enableFrustumCulling = tileset.enableFrustumCulling;
             tileset.enableFogCulling = tileset.enableFogCulling;
+            tileset.enableOcclusionCulling = tileset.enableOcclusionCulling;
             tileset.enforceCulledScreenSpaceError = tileset.enforceCulledScreenSpaceError;
             tileset.culledScreenSpaceError = tileset.culledScreenSpaceError;
             //tileset.useLodTransitions = tileset.useLodTransitions;
             //tileset.lodTransitionLength = tileset.lodTransitionLength;
             tileset.generateSmoothNormals = tileset.generateSmoothNormals;
             tileset.ignoreKhrMaterialsUnlit = tileset.ignoreKhrMaterialsUnlit;
+            tileset.shareMaterials = tileset.shareMaterials;
+            tileset.useRasterOverlayAtlas = tileset.useRasterOverlayAtlas;
+            tileset.compositeRasterOverlays = tileset.compositeRasterOverlays;
+            tileset.loadPriorityWeight = tileset.loadPriorityWeight;
+            tileset.predictiveLoadingTime = tileset.predictiveLoadingTime;
+            tileset.warmStart = tileset.warmStart;
             tileset.createPhysicsMeshes = tileset.createPhysicsMeshes;
             tileset.suspendUpdate = tileset.suspendUpdate;
             tileset.previousSuspendUpdate = tileset.previousSuspendUpdate;
@@ -475,6 +528,9 @@ namespace CesiumForUnity
             inParent.changed += () => { };
 
             float time = Time.deltaTime;
+            double timeAsDouble = Time.timeAsDouble;
+            double realtime = Time.realtimeSinceStartupAsDouble;
+            Matrix4x4 georeferenceToWorld = georeference.transform.localToWorldMatrix;
 
             GameObject[] gos = GameObject.FindGameObjectsWithTag("test");
             for (int i = 0; i < gos.Length; ++i)
@@ -565,6 +621,10 @@ namespace CesiumForUnity
 
             int requestsPerCachePrune = CesiumRuntimeSettings.requestsPerCachePrune;
             ulong maxItems = CesiumRuntimeSettings.maxItems;
+            bool cacheProcessedTextures = CesiumRuntimeSettings.cacheProcessedTextures;
+            bool cacheProcessedMeshes = CesiumRuntimeSettings.cacheProcessedMeshes;
+            bool adaptiveMainThreadBudget = CesiumRuntimeSettings.adaptiveMainThreadBudget;
+            int globalMaximumSimultaneousTileLoads = CesiumRuntimeSettings.maximumSimultaneousTileLoads;
 
             Cesium3DTilesetLoadFailureDetails tilesetDetails
                 = new Cesium3DTilesetLoadFailureDetails(tileset, Cesium3DTilesetLoadType.Unknown, 0, "");
@@ -636,6 +696,11 @@ namespace CesiumForUnity
             info.dimensions = Vector3.zero;
             info.isTranslucent = true;
 
+            CesiumTerrainHeightSample terrainHeightSample;
+            terrainHeightSample.success = true;
+            terrainHeightSample.height = 0.0;
+            terrainHeightSample.geometricError = 0.0;
+
             CesiumPointCloudRenderer renderer = go.AddComponent<CesiumPointCloudRenderer>();
             renderer.tileInfo = info;
 
@@ -643,6 +708,17 @@ namespace CesiumForUnity
             Mesh pooledMesh = meshPool.Get();
             meshPool.Release(pooledMesh);
 
+            CesiumObjectPool<GameObject> tileGameObjectPool = CesiumObjectPools.TileGameObjectPool;
+            GameObject pooledTileGameObject = tileGameObjectPool.Get();
+            tileGameObjectPool.Release(pooledTileGameObject);
+            CesiumObjectPool<GameObject> primitiveGameObjectPool = CesiumObjectPools.PrimitiveGameObjectPool;
+            GameObject pooledPrimitiveGameObject = primitiveGameObjectPool.Get();
+            primitiveGameObjectPool.Release(pooledPrimitiveGameObject);
+
+            long maximumPooledBytes = CesiumRasterOverlayTexturePool.maximumPooledBytes;
+            Texture2D pooledTexture = CesiumRasterOverlayTexturePool.Get(256, 256, TextureFormat.RGBA32, 1, false);
+            CesiumRasterOverlayTexturePool.Release(pooledTexture);
+
             System.Object myObject = null;
 
             CesiumIntVec2 myIntVec2 = new CesiumIntVec2((SByte)1, (SByte)2);
@@ -1058,6 +1134,7 @@ namespace CesiumForUnity
             {
                 camera = manager.additionalCameras[i];
             }
+            ulong cameraManagerID = Helpers.GetObjectId(manager);
 
             TaskCompletionSource<CesiumSampleHeightResult> promise =
                 new TaskCompletionSource<CesiumSampleHeightResult>();
@@ -1069,6 +1146,13 @@ namespace CesiumForUnity
             promise.SetResult(result);
             Task<CesiumSampleHeightResult> task = promise.Task;
 
+            CesiumSampleHeightBatch sampleHeightBatch = null;
+            if (sampleHeightBatch.TryStartCompleting())
+            {
+                sampleHeightBatch.Complete(new string[0]);
+                sampleHeightBatch.Fail("message");
+            }
+
             double3[] positions = null;
             for (int i = 0; i < positions.Length; ++i)
             {
@@ -1,4 +1,5 @@
 ﻿using System;
+using Unity.Collections;
 using Unity.Mathematics;
 using UnityEditor;
 using UnityEngine;
@@ -219,6 +220,38 @@ namespace CesiumForUnity
 #endif
         }
 
+        /// <summary>
+        /// Activates or deactivates many game objects at once, given their IDs from
+        /// <see cref="GetObjectId"/>.
+        /// </summary>
+        /// <param name="objectIds">
+        /// The IDs of the game objects to deactivate, followed by the IDs of the game
+        /// objects to activate.
+        /// </param>
+        /// <param name="inactiveCount">The number of IDs to deactivate.</param>
+        public static void SetGameObjectsActive(NativeArray<ulong> objectIds, int inactiveCount)
+        {
+            int length = objectIds.Length;
+#if UNITY_6000_4_OR_NEWER
+            NativeArray<EntityId> ids =
+                new NativeArray<EntityId>(length, Allocator.Temp, NativeArrayOptions.UninitializedMemory);
+            for (int i = 0; i < length; ++i)
+                ids[i] = EntityId.FromULong(objectIds[i]);
+#else
+            NativeArray<int> ids =
+                new NativeArray<int>(length, Allocator.Temp, NativeArrayOptions.UninitializedMemory);
+            for (int i = 0; i < length; ++i)
+                ids[i] = (int)objectIds[i];
+#endif
+
+            if (inactiveCount > 0)
+                GameObject.SetGameObjectsActive(ids.GetSubArray(0, inactiveCount), false);
+            if (inactiveCount < length)
+                GameObject.SetGameObjectsActive(ids.GetSubArray(inactiveCount, length - inactiveCount), true);
+
+            ids.Dispose();
+        }
+
         public static void BakeMeshFromId(ulong id)
         {
 #if UNITY_6000_4_OR_NEWER
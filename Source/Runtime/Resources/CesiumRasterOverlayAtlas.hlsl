@@ -0,0 +1,38 @@
+#ifndef CESIUM_RASTER_OVERLAY_ATLAS
+#define CESIUM_RASTER_OVERLAY_ATLAS
+
+// Samples a raster overlay that has been packed into a Texture2DArray because
+// Cesium3DTileset.useRasterOverlayAtlas is enabled. This is intended for a
+// Shader Graph Custom Function node, with the inputs connected to the
+// following properties for an overlay's material key:
+//
+//   overlayTextureArray: _overlayTextureArray_KEY
+//   sliceIndex:          _overlayTextureSliceIndex_KEY
+//   translationAndScale: _overlayTranslationAndScale_KEY
+//
+// overlayUV should be the texture coordinates selected by
+// _overlayTextureCoordinateIndex_KEY. A negative slice index means that no
+// overlay is attached, in which case the result is transparent black.
+void CesiumSampleRasterOverlayAtlas_float(
+	UnityTexture2DArray overlayTextureArray,
+	UnitySamplerState samplerState,
+	float sliceIndex,
+	float2 overlayUV,
+	float4 translationAndScale,
+	out float4 color)
+{
+	if (sliceIndex < 0.0)
+	{
+		color = float4(0.0, 0.0, 0.0, 0.0);
+		return;
+	}
+
+	float2 uv = overlayUV * translationAndScale.zw + translationAndScale.xy;
+	color = SAMPLE_TEXTURE2D_ARRAY(
+		overlayTextureArray.tex,
+		samplerState.samplerstate,
+		uv,
+		sliceIndex);
+}
+
+#endif
@@ -2,7 +2,9 @@ using CesiumForUnity;
 using NUnit.Framework;
 using System;
 using System.Collections;
+using System.Threading;
 using System.Threading.Tasks;
+using Unity.Collections;
 using Unity.Mathematics;
 using UnityEngine;
 using UnityEngine.TestTools;
@@ -157,6 +159,147 @@ public class TestCesium3DTileset
         Assert.IsTrue(result.warnings[0].Contains("failed to load"));
     }
 
+    [UnityTest]
+    public IEnumerator SampleHeightsWorksWithAnEmptyArrayOfPositions()
+    {
+        GameObject go = new GameObject();
+        go.name = "Cesium World Terrain";
+        Cesium3DTileset tileset = go.AddComponent<Cesium3DTileset>();
+        tileset.ionAccessToken = Environment.GetEnvironmentVariable("CESIUM_ION_TOKEN_FOR_TESTS") ?? "";
+        tileset.ionAssetID = 1;
+
+        NativeArray<double3> positions = new NativeArray<double3>(0, Allocator.Persistent);
+        NativeArray<bool> sampleSuccess = new NativeArray<bool>(0, Allocator.Persistent);
+        try
+        {
+            Task<string[]> task = tileset.SampleHeights(positions, sampleSuccess);
+
+            yield return new WaitForTask(task);
+
+            string[] warnings = task.Result;
+            Assert.IsNotNull(warnings);
+            Assert.AreEqual(warnings.Length, 0);
+        }
+        finally
+        {
+            positions.Dispose();
+            sampleSuccess.Dispose();
+        }
+    }
+
+    [Test]
+    public void SampleHeightsThrowsIfSampleSuccessIsTooShort()
+    {
+        GameObject go = new GameObject();
+        go.name = "Cesium World Terrain";
+        Cesium3DTileset tileset = go.AddComponent<Cesium3DTileset>();
+        tileset.ionAccessToken = Environment.GetEnvironmentVariable("CESIUM_ION_TOKEN_FOR_TESTS") ?? "";
+        tileset.ionAssetID = 1;
+
+        NativeArray<double3> positions = new NativeArray<double3>(2, Allocator.Persistent);
+        NativeArray<bool> sampleSuccess = new NativeArray<bool>(1, Allocator.Persistent);
+        try
+        {
+            Assert.Throws<ArgumentException>(() => tileset.SampleHeights(positions, sampleSuccess));
+        }
+        finally
+        {
+            positions.Dispose();
+            sampleSuccess.Dispose();
+        }
+    }
+
+    [UnityTest]
+    public IEnumerator SampleHeightsIsCancelledWithoutWritingTheArrays()
+    {
+        GameObject go = new GameObject();
+        go.name = "Cesium World Terrain";
+        Cesium3DTileset tileset = go.AddComponent<Cesium3DTileset>();
+        tileset.ionAccessToken = Environment.GetEnvironmentVariable("CESIUM_ION_TOKEN_FOR_TESTS") ?? "";
+        tileset.ionAssetID = 1;
+
+        NativeArray<double3> positions = new NativeArray<double3>(1, Allocator.Persistent);
+        NativeArray<bool> sampleSuccess = new NativeArray<bool>(1, Allocator.Persistent);
+        CancellationTokenSource cancellation = new CancellationTokenSource();
+        try
+        {
+            positions[0] = new double3(-105.1, 40.1, 1.0);
+
+            Task<string[]> task = tileset.SampleHeights(
+                positions,
+                sampleSuccess,
+                false,
+                cancellation.Token);
+            cancellation.Cancel();
+
+            Assert.IsTrue(task.IsCanceled);
+
+            // Wait for the same position to be sampled again, by which time the cancelled
+            // query has also finished.
+            Task<CesiumSampleHeightResult> laterTask =
+                tileset.SampleHeightMostDetailed(new double3(-105.1, 40.1, 1.0));
+
+            yield return new WaitForTask(laterTask);
+            yield return null;
+
+            Assert.AreEqual(laterTask.Result.sampleSuccess[0], true);
+            Assert.AreEqual(sampleSuccess[0], false);
+            Assert.AreEqual(positions[0].x, -105.1, 1e-12);
+            Assert.AreEqual(positions[0].y, 40.1, 1e-12);
+            Assert.AreEqual(positions[0].z, 1.0, 1e-12);
+        }
+        finally
+        {
+            cancellation.Dispose();
+            positions.Dispose();
+            sampleSuccess.Dispose();
+        }
+    }
+
+    [UnityTest]
+    public IEnumerator SampleHeightsWithLoadedTilesOnlyUsesTheLoadedTiles()
+    {
+        GameObject go = new GameObject();
+        go.name = "Cesium World Terrain";
+        Cesium3DTileset tileset = go.AddComponent<Cesium3DTileset>();
+        tileset.ionAccessToken = Environment.GetEnvironmentVariable("CESIUM_ION_TOKEN_FOR_TESTS") ?? "";
+        tileset.ionAssetID = 1;
+
+        // Load the tiles at the position.
+        Task<CesiumSampleHeightResult> loadTask =
+            tileset.SampleHeightMostDetailed(new double3(-105.1, 40.1, 1.0));
+
+        yield return new WaitForTask(loadTask);
+
+        CesiumSampleHeightResult loadResult = loadTask.Result;
+        Assert.AreEqual(loadResult.sampleSuccess[0], true);
+
+        NativeArray<double3> positions = new NativeArray<double3>(1, Allocator.Persistent);
+        NativeArray<bool> sampleSuccess = new NativeArray<bool>(1, Allocator.Persistent);
+        try
+        {
+            positions[0] = new double3(-105.1, 40.1, 1.0);
+
+            Task<string[]> task = tileset.SampleHeights(positions, sampleSuccess, true);
+
+            // Only loaded tiles are used, so the arrays are filled right away.
+            Assert.IsTrue(task.IsCompleted);
+            Assert.AreEqual(task.Result.Length, 0);
+
+            Assert.AreEqual(sampleSuccess[0], true);
+            Assert.AreEqual(positions[0].x, -105.1, 1e-12);
+            Assert.AreEqual(positions[0].y, 40.1, 1e-12);
+            // The height is interpolated from the most detailed tile, so it should be close
+            // to the height sampled from that tile.
+            Assert.AreEqual(positions[0].z, loadResult.longitudeLatitudeHeightPositions[0].z, 10.0);
+        }
+        finally
+        {
+            positions.Dispose();
+            sampleSuccess.Dispose();
+        }
+    }
+
     [UnityTest]
     public IEnumerator UpgradeToLargerIndexType()
     {
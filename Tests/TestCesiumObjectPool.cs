@@ -1,6 +1,8 @@
 ﻿using NUnit.Framework;
 using CesiumForUnity;
 using System.Collections.Generic;
+using UnityEngine;
+using UnityEngine.Rendering;
 
 public class TestCesiumObjectPool
 {
@@ -73,4 +75,52 @@ public class TestCesiumObjectPool
         Assert.IsTrue(to.isReleased);
         Assert.IsTrue(to.isDestroyed);
     }
-}
\ No newline at end of file
+
+    [Test]
+    public void DestroyedUnityObjectsAreNotRetrievedFromPool()
+    {
+        var pool = new CesiumObjectPool<GameObject>(
+            () => new GameObject(),
+            (go) => go.SetActive(false),
+            (go) => Object.DestroyImmediate(go));
+
+        GameObject obj = pool.Get();
+        pool.Release(obj);
+        Object.DestroyImmediate(obj);
+
+        GameObject newObj = pool.Get();
+        Assert.IsTrue(newObj != null);
+        Assert.AreNotSame(obj, newObj);
+
+        Object.DestroyImmediate(newObj);
+    }
+
+    [Test]
+    public void ReusedPrimitiveGameObjectHasDefaultRendererSettings()
+    {
+        CesiumObjectPool<GameObject> pool = CesiumObjectPools.PrimitiveGameObjectPool;
+
+        GameObject obj = pool.Get();
+        MeshRenderer meshRenderer = obj.AddComponent<MeshRenderer>();
+        meshRenderer.enabled = false;
+        meshRenderer.shadowCastingMode = ShadowCastingMode.ShadowsOnly;
+        meshRenderer.receiveShadows = false;
+        meshRenderer.renderingLayerMask = 4;
+        meshRenderer.lightProbeUsage = LightProbeUsage.Off;
+        meshRenderer.reflectionProbeUsage = ReflectionProbeUsage.Off;
+        pool.Release(obj);
+
+        GameObject newObj = pool.Get();
+        Assert.AreSame(obj, newObj);
+
+        MeshRenderer newRenderer = newObj.GetComponent<MeshRenderer>();
+        Assert.IsTrue(newRenderer.enabled);
+        Assert.AreEqual(ShadowCastingMode.On, newRenderer.shadowCastingMode);
+        Assert.IsTrue(newRenderer.receiveShadows);
+        Assert.AreEqual(1u, newRenderer.renderingLayerMask);
+        Assert.AreEqual(LightProbeUsage.BlendProbes, newRenderer.lightProbeUsage);
+        Assert.AreEqual(ReflectionProbeUsage.BlendProbes, newRenderer.reflectionProbeUsage);
+
+        Object.DestroyImmediate(newObj);
+    }
+}
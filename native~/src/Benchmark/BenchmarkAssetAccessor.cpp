@@ -0,0 +1,157 @@
+#include "BenchmarkAssetAccessor.h"
+
+#include "BenchmarkMetrics.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+
+using namespace CesiumAsync;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+const std::string fileScheme = "file://";
+
+int hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  } else if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  } else if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  } else {
+    return -1;
+  }
+}
+
+std::string pathFromFileUrl(const std::string& url) {
+  std::string encoded = url.substr(fileScheme.size());
+  size_t queryStart = encoded.find_first_of("?#");
+  if (queryStart != std::string::npos) {
+    encoded.resize(queryStart);
+  }
+
+  std::string path;
+  path.reserve(encoded.size());
+  for (size_t i = 0; i < encoded.size(); ++i) {
+    if (encoded[i] == '%' && i + 2 < encoded.size()) {
+      int high = hexValue(encoded[i + 1]);
+      int low = hexValue(encoded[i + 2]);
+      if (high >= 0 && low >= 0) {
+        path += char(high * 16 + low);
+        i += 2;
+        continue;
+      }
+    }
+    path += encoded[i];
+  }
+
+  // file:///C:/tiles/tileset.json names C:/tiles/tileset.json on Windows.
+  if (path.size() > 2 && path[0] == '/' && path[2] == ':') {
+    path.erase(0, 1);
+  }
+
+  return path;
+}
+
+} // namespace
+
+BenchmarkAssetAccessor::BenchmarkAssetAccessor(
+    const std::shared_ptr<BenchmarkMetrics>& pMetrics)
+    : _pMetrics(pMetrics) {}
+
+Future<std::shared_ptr<IAssetRequest>> BenchmarkAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->request(asyncSystem, "GET", url, headers);
+}
+
+Future<std::shared_ptr<IAssetRequest>> BenchmarkAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const std::span<const std::byte>& /* contentPayload */) {
+  HttpHeaders requestHeaders(headers.begin(), headers.end());
+
+  if (url.rfind(fileScheme, 0) != 0) {
+    ++this->_pMetrics->failedRequests;
+    return asyncSystem.createResolvedFuture<std::shared_ptr<IAssetRequest>>(
+        std::make_shared<BenchmarkAssetRequest>(
+            verb,
+            url,
+            std::move(requestHeaders),
+            BenchmarkAssetResponse(501, {})));
+  }
+
+  return asyncSystem.runInWorkerThread(
+      [pMetrics = this->_pMetrics,
+       verb,
+       url,
+       requestHeaders = std::move(requestHeaders)]() mutable
+      -> std::shared_ptr<IAssetRequest> {
+        using Clock = BenchmarkMetrics::Clock;
+        Clock::time_point start = Clock::now();
+
+        std::ifstream file(
+            std::filesystem::path(pathFromFileUrl(url)),
+            std::ios::binary | std::ios::ate);
+        uint16_t statusCode = 404;
+        std::vector<std::byte> data;
+        if (file) {
+          data.resize(size_t(file.tellg()));
+          file.seekg(0);
+          file.read(reinterpret_cast<char*>(data.data()), data.size());
+          statusCode = file ? 200 : 500;
+        }
+
+        Clock::time_point end = Clock::now();
+        pMetrics->addSample(BenchmarkStage::ReadingFile, end - start);
+        if (statusCode == 200) {
+          ++pMetrics->filesRead;
+          pMetrics->fileBytesRead += int64_t(data.size());
+          pMetrics->recordResponse(url, end);
+        } else {
+          ++pMetrics->failedRequests;
+        }
+
+        return std::make_shared<BenchmarkAssetRequest>(
+            verb,
+            url,
+            std::move(requestHeaders),
+            BenchmarkAssetResponse(statusCode, std::move(data)));
+      });
+}
+
+/*static*/ std::string
+BenchmarkAssetAccessor::fileUrlFromPath(const std::string& path) {
+  std::string generic =
+      std::filesystem::absolute(std::filesystem::path(path)).generic_string();
+
+  std::string url = fileScheme;
+  if (generic.empty() || generic[0] != '/') {
+    url += '/';
+  }
+
+  const char* hexDigits = "0123456789ABCDEF";
+  for (char c : generic) {
+    unsigned char u = static_cast<unsigned char>(c);
+    if (std::isalnum(u) || c == '/' || c == ':' || c == '-' || c == '_' ||
+        c == '.' || c == '~') {
+      url += c;
+    } else {
+      url += '%';
+      url += hexDigits[u >> 4];
+      url += hexDigits[u & 0xF];
+    }
+  }
+
+  return url;
+}
+
+} // namespace CesiumForUnityNative
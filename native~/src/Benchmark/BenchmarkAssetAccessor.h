@@ -0,0 +1,108 @@
+#pragma once
+
+#include <CesiumAsync/HttpHeaders.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+class BenchmarkMetrics;
+
+class BenchmarkAssetResponse : public CesiumAsync::IAssetResponse {
+public:
+  BenchmarkAssetResponse(uint16_t statusCode, std::vector<std::byte>&& data)
+      : _statusCode(statusCode), _headers(), _data(std::move(data)) {}
+
+  virtual uint16_t statusCode() const override { return _statusCode; }
+
+  virtual std::string contentType() const override { return std::string(); }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return _headers;
+  }
+
+  virtual std::span<const std::byte> data() const override {
+    return this->_data;
+  }
+
+private:
+  uint16_t _statusCode;
+  CesiumAsync::HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+class BenchmarkAssetRequest : public CesiumAsync::IAssetRequest {
+public:
+  BenchmarkAssetRequest(
+      const std::string& method,
+      const std::string& url,
+      CesiumAsync::HttpHeaders&& headers,
+      BenchmarkAssetResponse&& response)
+      : _method(method),
+        _url(url),
+        _headers(std::move(headers)),
+        _response(std::move(response)) {}
+
+  virtual const std::string& method() const override { return _method; }
+
+  virtual const std::string& url() const override { return _url; }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return _headers;
+  }
+
+  virtual const CesiumAsync::IAssetResponse* response() const override {
+    return &_response;
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  CesiumAsync::HttpHeaders _headers;
+  BenchmarkAssetResponse _response;
+};
+
+/**
+ * @brief Serves `file://` URLs from the local file system, so that the
+ * benchmark measures tile processing rather than the network.
+ *
+ * Each file is read on a worker thread, and the time taken is recorded as the
+ * {@link BenchmarkStage::ReadingFile} stage. Missing files get a 404
+ * response, and other schemes fail with a 501 response.
+ */
+class BenchmarkAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  explicit BenchmarkAssetAccessor(
+      const std::shared_ptr<BenchmarkMetrics>& pMetrics);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers = {}) override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers = std::vector<THeader>(),
+      const std::span<const std::byte>& contentPayload = {}) override;
+
+  virtual void tick() noexcept override {}
+
+  /**
+   * @brief Converts a native file path to a `file://` URL.
+   */
+  static std::string fileUrlFromPath(const std::string& path);
+
+private:
+  std::shared_ptr<BenchmarkMetrics> _pMetrics;
+};
+
+} // namespace CesiumForUnityNative
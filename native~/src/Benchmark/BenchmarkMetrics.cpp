@@ -0,0 +1,83 @@
+#include "BenchmarkMetrics.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace CesiumForUnityNative {
+
+/*static*/ const char* BenchmarkMetrics::getStageName(BenchmarkStage stage) {
+  switch (stage) {
+  case BenchmarkStage::ReadingFile:
+    return "Reading file";
+  case BenchmarkStage::ProcessingResponse:
+    return "Processing response";
+  case BenchmarkStage::PreparingInLoadThread:
+    return "Preparing in load thread";
+  case BenchmarkStage::WaitingForMainThread:
+    return "Waiting for main thread";
+  case BenchmarkStage::PreparingInMainThread:
+    return "Preparing in main thread";
+  default:
+    return "Unknown";
+  }
+}
+
+void BenchmarkMetrics::addSample(
+    BenchmarkStage stage,
+    Clock::duration duration) {
+  double milliseconds =
+      std::chrono::duration<double, std::milli>(duration).count();
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_samples[size_t(stage)].emplace_back(milliseconds);
+}
+
+BenchmarkStageSummary BenchmarkMetrics::summarize(BenchmarkStage stage) const {
+  std::vector<double> samples;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    samples = this->_samples[size_t(stage)];
+  }
+
+  BenchmarkStageSummary summary;
+  if (samples.empty()) {
+    return summary;
+  }
+
+  std::sort(samples.begin(), samples.end());
+
+  auto percentile = [&samples](double fraction) {
+    size_t index = size_t(fraction * double(samples.size() - 1) + 0.5);
+    return samples[index];
+  };
+
+  summary.count = samples.size();
+  summary.mean = std::accumulate(samples.begin(), samples.end(), 0.0) /
+                 double(samples.size());
+  summary.median = percentile(0.5);
+  summary.percentile95 = percentile(0.95);
+  summary.maximum = samples.back();
+  return summary;
+}
+
+void BenchmarkMetrics::recordResponse(
+    const std::string& url,
+    Clock::time_point time) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_responseTimes[url] = time;
+}
+
+std::optional<BenchmarkMetrics::Clock::time_point>
+BenchmarkMetrics::takeResponse(const std::string& url) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  auto it = this->_responseTimes.find(url);
+  if (it == this->_responseTimes.end()) {
+    return std::nullopt;
+  }
+
+  Clock::time_point time = it->second;
+  this->_responseTimes.erase(it);
+  return time;
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief The stages of a tile load that the benchmark times separately.
+ */
+enum class BenchmarkStage {
+  /** @brief Reading the tile's file from disk, on a worker thread. */
+  ReadingFile,
+  /**
+   * @brief Decompressing, parsing, and decoding the response inside
+   * cesium-native, on a worker thread.
+   */
+  ProcessingResponse,
+  /** @brief Preparing renderer resources on a worker thread. */
+  PreparingInLoadThread,
+  /** @brief Waiting for the main thread to pick up the prepared tile. */
+  WaitingForMainThread,
+  /** @brief Preparing renderer resources on the main thread. */
+  PreparingInMainThread,
+  Count
+};
+
+/**
+ * @brief Summary statistics of the times spent in one stage, in milliseconds.
+ */
+struct BenchmarkStageSummary {
+  size_t count = 0;
+  double mean = 0.0;
+  double median = 0.0;
+  double percentile95 = 0.0;
+  double maximum = 0.0;
+};
+
+/**
+ * @brief Collects the per-tile measurements of a benchmark run. All methods
+ * may be called from any thread.
+ */
+class BenchmarkMetrics {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Gets the name of a stage as it appears in the report.
+   */
+  static const char* getStageName(BenchmarkStage stage);
+
+  /**
+   * @brief Records the time spent by one tile in a stage.
+   */
+  void addSample(BenchmarkStage stage, Clock::duration duration);
+
+  /**
+   * @brief Summarizes the times recorded for a stage.
+   */
+  BenchmarkStageSummary summarize(BenchmarkStage stage) const;
+
+  /**
+   * @brief Remembers when the response for a URL was complete, so that the
+   * time cesium-native spends processing it can be measured once the glTF
+   * reaches the renderer.
+   */
+  void recordResponse(const std::string& url, Clock::time_point time);
+
+  /**
+   * @brief Gets and forgets the time at which the response for a URL was
+   * complete, if it was recorded.
+   */
+  std::optional<Clock::time_point> takeResponse(const std::string& url);
+
+  std::atomic<int64_t> filesRead{0};
+  std::atomic<int64_t> fileBytesRead{0};
+  std::atomic<int64_t> failedRequests{0};
+  std::atomic<int64_t> tilesLoaded{0};
+  std::atomic<int64_t> modelBytesLoaded{0};
+  std::atomic<int64_t> tilesUnloaded{0};
+
+private:
+  mutable std::mutex _mutex;
+  std::array<std::vector<double>, size_t(BenchmarkStage::Count)> _samples;
+  std::unordered_map<std::string, Clock::time_point> _responseTimes;
+};
+
+} // namespace CesiumForUnityNative
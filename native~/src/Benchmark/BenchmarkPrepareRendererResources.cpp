@@ -0,0 +1,158 @@
+#include "BenchmarkPrepareRendererResources.h"
+
+#include "BenchmarkMetrics.h"
+
+#include <Cesium3DTilesSelection/Tile.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumGltf/Model.h>
+
+#include <optional>
+#include <variant>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+using namespace CesiumGltf;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+/**
+ * @brief What the benchmark keeps for a tile between its load thread and main
+ * thread stages, and while it is loaded.
+ */
+struct BenchmarkTileResources {
+  BenchmarkMetrics::Clock::time_point loadThreadEnd;
+  int64_t modelBytes;
+};
+
+int64_t computeModelBytes(const Model& model) {
+  int64_t bytes = 0;
+  for (const Buffer& buffer : model.buffers) {
+    bytes += int64_t(buffer.cesium.data.size());
+  }
+  for (const Image& image : model.images) {
+    if (image.pAsset) {
+      bytes += int64_t(image.pAsset->pixelData.size());
+    }
+  }
+  return bytes;
+}
+
+} // namespace
+
+BenchmarkPrepareRendererResources::BenchmarkPrepareRendererResources(
+    const std::shared_ptr<BenchmarkMetrics>& pMetrics)
+    : _pMetrics(pMetrics) {}
+
+Future<TileLoadResultAndRenderResources>
+BenchmarkPrepareRendererResources::prepareInLoadThread(
+    const AsyncSystem& asyncSystem,
+    TileLoadResult&& tileLoadResult,
+    const glm::dmat4& /* transform */,
+    const std::any& /* rendererOptions */) {
+  using Clock = BenchmarkMetrics::Clock;
+  Clock::time_point start = Clock::now();
+
+  const Model* pModel = std::get_if<Model>(&tileLoadResult.contentKind);
+  if (!pModel) {
+    return asyncSystem.createResolvedFuture(
+        TileLoadResultAndRenderResources{std::move(tileLoadResult), nullptr});
+  }
+
+  // cesium-native records the URL of each tile's content in the glTF extras,
+  // which ties this tile back to the response that it was processed from.
+  auto urlIt = pModel->extras.find("Cesium3DTiles_TileUrl");
+  if (urlIt != pModel->extras.end()) {
+    std::optional<Clock::time_point> maybeResponse =
+        this->_pMetrics->takeResponse(urlIt->second.getStringOrDefault(""));
+    if (maybeResponse) {
+      this->_pMetrics->addSample(
+          BenchmarkStage::ProcessingResponse,
+          start - *maybeResponse);
+    }
+  }
+
+  int64_t modelBytes = computeModelBytes(*pModel);
+
+  Clock::time_point end = Clock::now();
+  this->_pMetrics->addSample(
+      BenchmarkStage::PreparingInLoadThread,
+      end - start);
+
+  return asyncSystem.createResolvedFuture(TileLoadResultAndRenderResources{
+      std::move(tileLoadResult),
+      new BenchmarkTileResources{end, modelBytes}});
+}
+
+void* BenchmarkPrepareRendererResources::prepareInMainThread(
+    Tile& /* tile */,
+    void* pLoadThreadResult) {
+  using Clock = BenchmarkMetrics::Clock;
+  Clock::time_point start = Clock::now();
+
+  BenchmarkTileResources* pResources =
+      static_cast<BenchmarkTileResources*>(pLoadThreadResult);
+  if (!pResources) {
+    return nullptr;
+  }
+
+  this->_pMetrics->addSample(
+      BenchmarkStage::WaitingForMainThread,
+      start - pResources->loadThreadEnd);
+
+  ++this->_pMetrics->tilesLoaded;
+  this->_pMetrics->modelBytesLoaded += pResources->modelBytes;
+
+  this->_pMetrics->addSample(
+      BenchmarkStage::PreparingInMainThread,
+      Clock::now() - start);
+
+  // The same resources are kept for as long as the tile is loaded.
+  return pResources;
+}
+
+void BenchmarkPrepareRendererResources::free(
+    Tile& /* tile */,
+    void* pLoadThreadResult,
+    void* pMainThreadResult) noexcept {
+  if (pMainThreadResult) {
+    ++this->_pMetrics->tilesUnloaded;
+    delete static_cast<BenchmarkTileResources*>(pMainThreadResult);
+  } else if (pLoadThreadResult) {
+    delete static_cast<BenchmarkTileResources*>(pLoadThreadResult);
+  }
+}
+
+void* BenchmarkPrepareRendererResources::prepareRasterInLoadThread(
+    CesiumImage::ImageAsset& /* image */,
+    const std::any& /* rendererOptions */) {
+  return nullptr;
+}
+
+void* BenchmarkPrepareRendererResources::prepareRasterInMainThread(
+    CesiumRasterOverlays::RasterOverlayTile& /* rasterTile */,
+    void* /* pLoadThreadResult */) {
+  return nullptr;
+}
+
+void BenchmarkPrepareRendererResources::freeRaster(
+    const CesiumRasterOverlays::RasterOverlayTile& /* rasterTile */,
+    void* /* pLoadThreadResult */,
+    void* /* pMainThreadResult */) noexcept {}
+
+void BenchmarkPrepareRendererResources::attachRasterInMainThread(
+    const Tile& /* tile */,
+    int32_t /* overlayTextureCoordinateID */,
+    const CesiumRasterOverlays::RasterOverlayTile& /* rasterTile */,
+    void* /* pMainThreadRendererResources */,
+    const glm::dvec2& /* translation */,
+    const glm::dvec2& /* scale */) {}
+
+void BenchmarkPrepareRendererResources::detachRasterInMainThread(
+    const Tile& /* tile */,
+    int32_t /* overlayTextureCoordinateID */,
+    const CesiumRasterOverlays::RasterOverlayTile& /* rasterTile */,
+    void* /* pMainThreadRendererResources */) noexcept {}
+
+} // namespace CesiumForUnityNative
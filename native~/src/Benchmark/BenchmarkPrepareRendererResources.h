@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/IPrepareRendererResources.h>
+
+#include <memory>
+
+namespace CesiumForUnityNative {
+
+class BenchmarkMetrics;
+
+/**
+ * @brief Stands in for `UnityPrepareRendererResources` in the benchmark. It
+ * creates no meshes or textures, but records when each tile passes through
+ * the renderer and how large its glTF is, so that the rest of the pipeline
+ * can be timed without Unity.
+ */
+class BenchmarkPrepareRendererResources
+    : public Cesium3DTilesSelection::IPrepareRendererResources {
+public:
+  explicit BenchmarkPrepareRendererResources(
+      const std::shared_ptr<BenchmarkMetrics>& pMetrics);
+
+  virtual CesiumAsync::Future<
+      Cesium3DTilesSelection::TileLoadResultAndRenderResources>
+  prepareInLoadThread(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      Cesium3DTilesSelection::TileLoadResult&& tileLoadResult,
+      const glm::dmat4& transform,
+      const std::any& rendererOptions) override;
+
+  virtual void* prepareInMainThread(
+      Cesium3DTilesSelection::Tile& tile,
+      void* pLoadThreadResult) override;
+
+  virtual void free(
+      Cesium3DTilesSelection::Tile& tile,
+      void* pLoadThreadResult,
+      void* pMainThreadResult) noexcept override;
+
+  virtual void* prepareRasterInLoadThread(
+      CesiumImage::ImageAsset& image,
+      const std::any& rendererOptions) override;
+
+  virtual void* prepareRasterInMainThread(
+      CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+      void* pLoadThreadResult) override;
+
+  virtual void freeRaster(
+      const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+      void* pLoadThreadResult,
+      void* pMainThreadResult) noexcept override;
+
+  virtual void attachRasterInMainThread(
+      const Cesium3DTilesSelection::Tile& tile,
+      int32_t overlayTextureCoordinateID,
+      const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+      void* pMainThreadRendererResources,
+      const glm::dvec2& translation,
+      const glm::dvec2& scale) override;
+
+  virtual void detachRasterInMainThread(
+      const Cesium3DTilesSelection::Tile& tile,
+      int32_t overlayTextureCoordinateID,
+      const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+      void* pMainThreadRendererResources) noexcept override;
+
+private:
+  std::shared_ptr<BenchmarkMetrics> _pMetrics;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,55 @@
+#include "BenchmarkTaskProcessor.h"
+
+namespace CesiumForUnityNative {
+
+BenchmarkTaskProcessor::BenchmarkTaskProcessor(size_t threadCount)
+    : _mutex(), _condition(), _tasks(), _threads(), _stopping(false) {
+  this->_threads.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; ++i) {
+    this->_threads.emplace_back([this]() { this->run(); });
+  }
+}
+
+BenchmarkTaskProcessor::~BenchmarkTaskProcessor() {
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_stopping = true;
+  }
+  this->_condition.notify_all();
+
+  for (std::thread& thread : this->_threads) {
+    thread.join();
+  }
+}
+
+void BenchmarkTaskProcessor::startTask(std::function<void()> f) {
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_tasks.emplace_back(std::move(f));
+  }
+  this->_condition.notify_one();
+}
+
+void BenchmarkTaskProcessor::run() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      this->_condition.wait(lock, [this]() {
+        return this->_stopping || !this->_tasks.empty();
+      });
+
+      // Remaining tasks are dropped on shutdown, as nothing waits for them.
+      if (this->_stopping) {
+        return;
+      }
+
+      task = std::move(this->_tasks.front());
+      this->_tasks.pop_front();
+    }
+
+    task();
+  }
+}
+
+} // namespace CesiumForUnityNative
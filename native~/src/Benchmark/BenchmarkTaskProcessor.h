@@ -0,0 +1,36 @@
+#pragma once
+
+#include <CesiumAsync/ITaskProcessor.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Runs cesium-native's worker thread tasks on a fixed pool of threads,
+ * standing in for Unity's job system in the benchmark.
+ */
+class BenchmarkTaskProcessor : public CesiumAsync::ITaskProcessor {
+public:
+  explicit BenchmarkTaskProcessor(size_t threadCount);
+  virtual ~BenchmarkTaskProcessor() override;
+
+  virtual void startTask(std::function<void()> f) override;
+
+private:
+  void run();
+
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  std::deque<std::function<void()>> _tasks;
+  std::vector<std::thread> _threads;
+  bool _stopping;
+};
+
+} // namespace CesiumForUnityNative
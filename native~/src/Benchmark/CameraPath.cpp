@@ -0,0 +1,240 @@
+#include "CameraPath.h"
+
+#include <CesiumUtility/ErrorList.h>
+#include <CesiumUtility/Math.h>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <rapidjson/document.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace CesiumUtility;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+bool readVector(
+    const rapidjson::Value& object,
+    const char* key,
+    glm::dvec3& out) {
+  auto it = object.FindMember(key);
+  if (it == object.MemberEnd() || !it->value.IsArray() ||
+      it->value.Size() != 3) {
+    return false;
+  }
+
+  for (rapidjson::SizeType i = 0; i < 3; ++i) {
+    if (!it->value[i].IsNumber()) {
+      return false;
+    }
+    out[glm::length_t(i)] = it->value[i].GetDouble();
+  }
+
+  return true;
+}
+
+double readNumber(
+    const rapidjson::Value& object,
+    const char* key,
+    double defaultValue) {
+  auto it = object.FindMember(key);
+  if (it == object.MemberEnd() || !it->value.IsNumber()) {
+    return defaultValue;
+  }
+  return it->value.GetDouble();
+}
+
+Result<std::vector<CameraKeyframe>> parseJson(const std::string& text) {
+  rapidjson::Document document;
+  document.Parse(text.data(), text.size());
+  if (document.HasParseError()) {
+    return ErrorList::error(
+        "The camera path is not valid JSON, error code " +
+        std::to_string(int(document.GetParseError())) + " at byte offset " +
+        std::to_string(document.GetErrorOffset()) + ".");
+  }
+
+  const rapidjson::Value* pKeyframes = &document;
+  if (document.IsObject()) {
+    auto it = document.FindMember("keyframes");
+    pKeyframes = it == document.MemberEnd() ? nullptr : &it->value;
+  }
+
+  if (!pKeyframes || !pKeyframes->IsArray()) {
+    return ErrorList::error("The camera path has no keyframes array.");
+  }
+
+  const CameraKeyframe defaults;
+  std::vector<CameraKeyframe> keyframes;
+  for (const rapidjson::Value& value : pKeyframes->GetArray()) {
+    CameraKeyframe keyframe;
+    if (!value.IsObject() ||
+        !readVector(value, "position", keyframe.position) ||
+        !readVector(value, "direction", keyframe.direction) ||
+        !readVector(value, "up", keyframe.up)) {
+      return ErrorList::error(
+          "Keyframe " + std::to_string(keyframes.size()) +
+          " needs a position, direction, and up, each an array of three "
+          "numbers.");
+    }
+
+    keyframe.time = readNumber(value, "time", 0.0);
+    keyframe.verticalFieldOfView = Math::degreesToRadians(readNumber(
+        value,
+        "verticalFieldOfView",
+        Math::radiansToDegrees(defaults.verticalFieldOfView)));
+    keyframe.viewportSize.x =
+        readNumber(value, "viewportWidth", defaults.viewportSize.x);
+    keyframe.viewportSize.y =
+        readNumber(value, "viewportHeight", defaults.viewportSize.y);
+    keyframes.emplace_back(keyframe);
+  }
+
+  return keyframes;
+}
+
+Result<std::vector<CameraKeyframe>>
+parseCsv(const std::string& text, bool& isRecording) {
+  constexpr size_t columnCount = 13;
+  constexpr size_t cameraColumn = 14;
+
+  std::vector<CameraKeyframe> keyframes;
+  std::istringstream lines(text);
+  std::string line;
+  size_t lineNumber = 0;
+  while (std::getline(lines, line)) {
+    ++lineNumber;
+
+    size_t first = line.find_first_not_of(" \t");
+    if (first == std::string::npos ||
+        !(std::isdigit(static_cast<unsigned char>(line[first])) ||
+          line[first] == '-' || line[first] == '+' || line[first] == '.')) {
+      continue;
+    }
+
+    std::vector<double> values;
+    std::istringstream cells(line);
+    std::string cell;
+    while (std::getline(cells, cell, ',')) {
+      try {
+        values.emplace_back(std::stod(cell));
+      } catch (const std::exception&) {
+        break;
+      }
+    }
+
+    if (values.size() < columnCount) {
+      return ErrorList::error(
+          "Line " + std::to_string(lineNumber) + " of the camera path has " +
+          std::to_string(values.size()) + " numeric columns, but " +
+          std::to_string(columnCount) + " are required.");
+    }
+
+    // Recordings from CesiumCameraPathRecorder have a row for every camera in
+    // every frame. Only the first camera is replayed.
+    if (values.size() > cameraColumn) {
+      isRecording = true;
+      if (values[cameraColumn] != 0.0) {
+        continue;
+      }
+    }
+
+    CameraKeyframe& keyframe = keyframes.emplace_back();
+    keyframe.time = values[0];
+    keyframe.position = glm::dvec3(values[1], values[2], values[3]);
+    keyframe.direction = glm::dvec3(values[4], values[5], values[6]);
+    keyframe.up = glm::dvec3(values[7], values[8], values[9]);
+    keyframe.verticalFieldOfView = Math::degreesToRadians(values[10]);
+    keyframe.viewportSize = glm::dvec2(values[11], values[12]);
+  }
+
+  return keyframes;
+}
+
+} // namespace
+
+/*static*/ Result<CameraPath> CameraPath::load(const std::string& path) {
+  std::ifstream file{std::filesystem::path(path)};
+  if (!file) {
+    return ErrorList::error("Could not open the camera path " + path + ".");
+  }
+
+  std::stringstream contents;
+  contents << file.rdbuf();
+
+  std::string extension = std::filesystem::path(path).extension().string();
+  std::transform(
+      extension.begin(),
+      extension.end(),
+      extension.begin(),
+      [](unsigned char c) { return char(std::tolower(c)); });
+
+  bool isRecording = false;
+  Result<std::vector<CameraKeyframe>> keyframes =
+      extension == ".json" ? parseJson(contents.str())
+                           : parseCsv(contents.str(), isRecording);
+  if (!keyframes.value) {
+    return keyframes.errors;
+  }
+
+  if (keyframes.value->empty()) {
+    return ErrorList::error("The camera path has no keyframes.");
+  }
+
+  for (size_t i = 1; i < keyframes.value->size(); ++i) {
+    if ((*keyframes.value)[i].time < (*keyframes.value)[i - 1].time) {
+      return ErrorList::error(
+          "The time of keyframe " + std::to_string(i) +
+          " is earlier than the keyframe before it.");
+    }
+  }
+
+  for (CameraKeyframe& keyframe : *keyframes.value) {
+    keyframe.direction = glm::normalize(keyframe.direction);
+    keyframe.up = glm::normalize(keyframe.up);
+  }
+
+  CameraPath result;
+  result._keyframes = std::move(*keyframes.value);
+  result._isRecording = isRecording;
+  return result;
+}
+
+CameraKeyframe CameraPath::getViewAt(double time) const {
+  auto next = std::upper_bound(
+      this->_keyframes.begin(),
+      this->_keyframes.end(),
+      time,
+      [](double t, const CameraKeyframe& keyframe) {
+        return t < keyframe.time;
+      });
+
+  if (next == this->_keyframes.begin()) {
+    return this->_keyframes.front();
+  } else if (next == this->_keyframes.end()) {
+    return this->_keyframes.back();
+  }
+
+  const CameraKeyframe& a = *(next - 1);
+  const CameraKeyframe& b = *next;
+  double span = b.time - a.time;
+  double t = span > 0.0 ? (time - a.time) / span : 1.0;
+
+  CameraKeyframe result;
+  result.time = time;
+  result.position = glm::mix(a.position, b.position, t);
+  result.direction = glm::normalize(glm::mix(a.direction, b.direction, t));
+  result.up = glm::normalize(glm::mix(a.up, b.up, t));
+  result.verticalFieldOfView =
+      glm::mix(a.verticalFieldOfView, b.verticalFieldOfView, t);
+  result.viewportSize = glm::mix(a.viewportSize, b.viewportSize, t);
+  return result;
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <CesiumUtility/Result.h>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <string>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief A camera view at a moment of a recorded camera path.
+ */
+struct CameraKeyframe {
+  /** @brief The time of this view, in seconds from the start of the path. */
+  double time = 0.0;
+  /** @brief The position of the camera, in ECEF coordinates. */
+  glm::dvec3 position{0.0};
+  /** @brief The forward direction of the camera, in ECEF coordinates. */
+  glm::dvec3 direction{0.0, 0.0, 1.0};
+  /** @brief The up direction of the camera, in ECEF coordinates. */
+  glm::dvec3 up{0.0, 1.0, 0.0};
+  /** @brief The vertical field of view, in radians. */
+  double verticalFieldOfView = 1.0471975511965976;
+  /** @brief The size of the viewport, in pixels. */
+  glm::dvec2 viewportSize{1920.0, 1080.0};
+};
+
+/**
+ * @brief A recorded camera path, replayed by the tile streaming benchmark.
+ *
+ * A path is read from either a JSON or a CSV file. The JSON form is an object
+ * with a `keyframes` array, or the array itself, where each keyframe is:
+ *
+ * ```
+ * {
+ *   "time": 0.0,
+ *   "position": [x, y, z],
+ *   "direction": [x, y, z],
+ *   "up": [x, y, z],
+ *   "verticalFieldOfView": 60.0,
+ *   "viewportWidth": 1920,
+ *   "viewportHeight": 1080
+ * }
+ * ```
+ *
+ * The CSV form has one keyframe per line, with the columns `time`, `positionX`,
+ * `positionY`, `positionZ`, `directionX`, `directionY`, `directionZ`, `upX`,
+ * `upY`, `upZ`, `verticalFieldOfView`, `viewportWidth`, and `viewportHeight`.
+ * Lines that do not start with a number, such as a header, are skipped.
+ * Further columns are ignored, except that when there is a fifteenth column,
+ * as in the files written by `CesiumCameraPathRecorder`, it is the index of
+ * the camera and only rows for the first camera are used. Such a path is a
+ * recording, with a keyframe for every frame.
+ *
+ * Positions and directions are in ECEF coordinates, and the field of view is
+ * in degrees. Times are in seconds and must not decrease.
+ */
+class CameraPath {
+public:
+  /**
+   * @brief Reads a camera path from a file. Files with a `.json` extension are
+   * read as JSON, and all others as CSV.
+   */
+  static CesiumUtility::Result<CameraPath> load(const std::string& path);
+
+  const std::vector<CameraKeyframe>& getKeyframes() const noexcept {
+    return this->_keyframes;
+  }
+
+  /**
+   * @brief Whether this path was recorded by `CesiumCameraPathRecorder`, so
+   * that each keyframe is one frame of the recording rather than a stop along
+   * the path.
+   */
+  bool isRecording() const noexcept { return this->_isRecording; }
+
+  /**
+   * @brief Gets the camera view at the given time, interpolated between the
+   * keyframes on either side of it.
+   */
+  CameraKeyframe getViewAt(double time) const;
+
+private:
+  std::vector<CameraKeyframe> _keyframes;
+  bool _isRecording = false;
+};
+
+} // namespace CesiumForUnityNative
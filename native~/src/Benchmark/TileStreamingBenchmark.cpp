@@ -0,0 +1,651 @@
+// A headless benchmark of tile streaming. It loads a tileset from the local
+// file system, replays a recorded camera path against it at a fixed frame
+// rate, and reports how quickly tiles reach the screen. A path of keyframes
+// stops at each one until it reaches full detail, while a recording from
+// CesiumCameraPathRecorder is replayed a row per frame, without stopping.
+// Unity is not involved: files are read directly, and renderer resources are
+// stubbed out, so the numbers reflect cesium-native's loading pipeline and the
+// tileset itself.
+//
+// Usage:
+//   CesiumForUnityBenchmark <tileset> <camera path> [options]
+//
+// <tileset> is a tileset.json file, a directory containing one, or a file://
+// URL. See CameraPath.h for the camera path formats. Run with --help for the
+// options.
+
+#include "BenchmarkAssetAccessor.h"
+#include "BenchmarkMetrics.h"
+#include "BenchmarkPrepareRendererResources.h"
+#include "BenchmarkTaskProcessor.h"
+#include "CameraPath.h"
+
+#include <Cesium3DTilesSelection/Tileset.h>
+#include <Cesium3DTilesSelection/TilesetExternals.h>
+#include <Cesium3DTilesSelection/TilesetLoadFailureDetails.h>
+#include <Cesium3DTilesSelection/TilesetOptions.h>
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <Cesium3DTilesSelection/ViewUpdateResult.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumUtility/CreditSystem.h>
+
+#include <glm/trigonometric.hpp>
+#include <rapidjson/ostreamwrapper.h>
+#include <rapidjson/prettywriter.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+using namespace CesiumForUnityNative;
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace {
+
+using Clock = BenchmarkMetrics::Clock;
+
+enum class ReplayMode {
+  // Continuous for recordings, and stops for other paths.
+  Automatic,
+  // The camera stops at each keyframe until it reaches full detail.
+  Stops,
+  // The camera moves to the next keyframe every frame.
+  Continuous
+};
+
+struct BenchmarkOptions {
+  std::string tileset;
+  std::string cameraPath;
+  std::string reportPath;
+  double framesPerSecond = 60.0;
+  double keyframeTimeout = 30.0;
+  ReplayMode replayMode = ReplayMode::Automatic;
+  size_t threadCount = std::max(2u, std::thread::hardware_concurrency());
+  TilesetOptions tilesetOptions;
+};
+
+struct KeyframeResult {
+  double time;
+  // The time taken, after the camera reached the keyframe, until every tile
+  // for it was loaded, or nothing if that did not happen within the timeout.
+  std::optional<double> timeToFullDetail;
+  size_t tilesRendered;
+};
+
+struct BenchmarkResult {
+  bool tilesetFailed = false;
+  bool continuous = false;
+  std::optional<double> timeToFirstRender;
+  std::vector<KeyframeResult> keyframes;
+  // For a continuous replay, the frames of the replay before its final stop,
+  // and how many of them had every tile for the view loaded.
+  int64_t replayFrames = 0;
+  int64_t fullDetailFrames = 0;
+  double totalTime = 0.0;
+  int64_t frameCount = 0;
+  int64_t peakTotalDataBytes = 0;
+  int64_t peakProcessMemoryBytes = 0;
+};
+
+void printUsage() {
+  std::printf(
+      "Usage: CesiumForUnityBenchmark <tileset> <camera path> [options]\n"
+      "\n"
+      "  <tileset>       A tileset.json file, a directory containing one, or "
+      "a file:// URL.\n"
+      "  <camera path>   A .json or .csv camera path.\n"
+      "\n"
+      "Options:\n"
+      "  --fps <n>                          Simulated frame rate (60).\n"
+      "  --threads <n>                      Worker threads.\n"
+      "  --keyframe-timeout <seconds>       Longest wait for full detail at "
+      "each keyframe (30).\n"
+      "  --replay <stops|continuous>        Stop at each keyframe, or move to "
+      "the next\n"
+      "                                     one every frame. Recordings are "
+      "continuous\n"
+      "                                     and other paths stop by "
+      "default.\n"
+      "  --maximum-screen-space-error <n>   The tileset's SSE (16).\n"
+      "  --maximum-cached-bytes <n>         The tileset's cache size.\n"
+      "  --maximum-simultaneous-tile-loads <n>\n"
+      "  --report <file>                    Also write the results as JSON.\n");
+}
+
+std::optional<BenchmarkOptions> parseArguments(int argc, char** argv) {
+  BenchmarkOptions options;
+  std::vector<std::string> positional;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string argument = argv[i];
+    if (argument == "--help" || argument == "-h") {
+      return std::nullopt;
+    }
+
+    if (argument.rfind("--", 0) != 0) {
+      positional.emplace_back(argument);
+      continue;
+    }
+
+    if (i + 1 >= argc) {
+      std::fprintf(stderr, "%s needs a value.\n", argument.c_str());
+      return std::nullopt;
+    }
+
+    std::string value = argv[++i];
+    try {
+      if (argument == "--fps") {
+        options.framesPerSecond = std::stod(value);
+      } else if (argument == "--threads") {
+        options.threadCount = std::max<size_t>(1, std::stoul(value));
+      } else if (argument == "--keyframe-timeout") {
+        options.keyframeTimeout = std::stod(value);
+      } else if (argument == "--replay") {
+        if (value == "stops") {
+          options.replayMode = ReplayMode::Stops;
+        } else if (value == "continuous") {
+          options.replayMode = ReplayMode::Continuous;
+        } else {
+          throw std::invalid_argument(value);
+        }
+      } else if (argument == "--maximum-screen-space-error") {
+        options.tilesetOptions.maximumScreenSpaceError = std::stod(value);
+      } else if (argument == "--maximum-cached-bytes") {
+        options.tilesetOptions.maximumCachedBytes = std::stoll(value);
+      } else if (argument == "--maximum-simultaneous-tile-loads") {
+        options.tilesetOptions.maximumSimultaneousTileLoads =
+            uint32_t(std::stoul(value));
+      } else if (argument == "--report") {
+        options.reportPath = value;
+      } else {
+        std::fprintf(stderr, "Unknown option %s.\n", argument.c_str());
+        return std::nullopt;
+      }
+    } catch (const std::exception&) {
+      std::fprintf(
+          stderr,
+          "%s is not a valid value for %s.\n",
+          value.c_str(),
+          argument.c_str());
+      return std::nullopt;
+    }
+  }
+
+  if (positional.size() != 2 || options.framesPerSecond <= 0.0) {
+    return std::nullopt;
+  }
+
+  options.tileset = positional[0];
+  options.cameraPath = positional[1];
+  return options;
+}
+
+std::string getTilesetUrl(const std::string& tileset) {
+  if (tileset.rfind("file://", 0) == 0) {
+    return tileset;
+  }
+
+  std::filesystem::path path(tileset);
+  if (std::filesystem::is_directory(path)) {
+    path /= "tileset.json";
+  }
+  return BenchmarkAssetAccessor::fileUrlFromPath(path.string());
+}
+
+int64_t getPeakProcessMemoryBytes() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return int64_t(counters.PeakWorkingSetSize);
+  }
+  return 0;
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  return int64_t(usage.ru_maxrss);
+#else
+  // Linux reports kilobytes.
+  return int64_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+ViewState createViewState(const CameraKeyframe& view) {
+  double aspectRatio = view.viewportSize.x / view.viewportSize.y;
+  double horizontalFieldOfView =
+      2.0 * std::atan(std::tan(view.verticalFieldOfView * 0.5) * aspectRatio);
+  return ViewState(
+      view.position,
+      view.direction,
+      view.up,
+      view.viewportSize,
+      horizontalFieldOfView,
+      view.verticalFieldOfView,
+      Ellipsoid::WGS84);
+}
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Drives the tileset the way Cesium3DTilesetImpl does each Unity
+ * frame, then sleeps out the rest of the frame.
+ */
+class FrameDriver {
+public:
+  FrameDriver(
+      Tileset& tileset,
+      const AsyncSystem& asyncSystem,
+      const BenchmarkOptions& options,
+      BenchmarkResult& result)
+      : _tileset(tileset),
+        _asyncSystem(asyncSystem),
+        _frameDuration(std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / options.framesPerSecond))),
+        _result(result),
+        _start(Clock::now()) {}
+
+  const ViewUpdateResult& step(const CameraKeyframe& view) {
+    Clock::time_point frameStart = Clock::now();
+
+    this->_asyncSystem.dispatchMainThreadTasks();
+
+    const ViewUpdateResult& updateResult = this->_tileset.updateViewGroup(
+        this->_tileset.getDefaultViewGroup(),
+        {createViewState(view)},
+        float(std::chrono::duration<double>(this->_frameDuration).count()));
+    this->_tileset.loadTiles();
+
+    ++this->_result.frameCount;
+    if (!this->_result.timeToFirstRender &&
+        !updateResult.tilesToRenderThisFrame.empty()) {
+      this->_result.timeToFirstRender = this->elapsed();
+    }
+    this->_result.peakTotalDataBytes = std::max(
+        this->_result.peakTotalDataBytes,
+        this->_tileset.getTotalDataBytes());
+
+    std::this_thread::sleep_until(frameStart + this->_frameDuration);
+    return updateResult;
+  }
+
+  bool isFullyLoaded(const ViewUpdateResult& updateResult) {
+    return updateResult.workerThreadTileLoadQueueLength == 0 &&
+           updateResult.mainThreadTileLoadQueueLength == 0 &&
+           !updateResult.tilesToRenderThisFrame.empty() &&
+           this->_tileset.computeLoadProgress() >= 100.0f;
+  }
+
+  double elapsed() const { return secondsSince(this->_start); }
+
+private:
+  Tileset& _tileset;
+  AsyncSystem _asyncSystem;
+  Clock::duration _frameDuration;
+  BenchmarkResult& _result;
+  Clock::time_point _start;
+};
+
+/**
+ * @brief Holds the camera at a keyframe until every tile for that view is
+ * loaded, or the keyframe timeout passes.
+ */
+void stopAt(
+    const CameraKeyframe& keyframe,
+    FrameDriver& driver,
+    const BenchmarkOptions& options,
+    BenchmarkResult& result) {
+  Clock::time_point arrival = Clock::now();
+  KeyframeResult& keyframeResult =
+      result.keyframes.emplace_back(KeyframeResult{keyframe.time, {}, 0});
+  while (secondsSince(arrival) < options.keyframeTimeout &&
+         !result.tilesetFailed) {
+    const ViewUpdateResult& updateResult = driver.step(keyframe);
+    keyframeResult.tilesRendered = updateResult.tilesToRenderThisFrame.size();
+    if (driver.isFullyLoaded(updateResult)) {
+      keyframeResult.timeToFullDetail = secondsSince(arrival);
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Flies the camera along the path. At each keyframe the camera stops
+ * until every tile for that view is loaded, so that the time to full detail
+ * of each keyframe is measured on its own.
+ */
+void replayWithStops(
+    const CameraPath& cameraPath,
+    FrameDriver& driver,
+    const BenchmarkOptions& options,
+    BenchmarkResult& result) {
+  const double frameDuration = 1.0 / options.framesPerSecond;
+  double pathTime = cameraPath.getKeyframes().front().time;
+
+  for (const CameraKeyframe& keyframe : cameraPath.getKeyframes()) {
+    while (pathTime < keyframe.time && !result.tilesetFailed) {
+      driver.step(cameraPath.getViewAt(pathTime));
+      pathTime += frameDuration;
+    }
+    pathTime = keyframe.time;
+
+    stopAt(keyframe, driver, options, result);
+  }
+}
+
+/**
+ * @brief Replays the path a keyframe per frame, as a recording was captured,
+ * and counts the frames in which every tile for the view was loaded. The
+ * camera only stops at the last keyframe. The times of the keyframes are
+ * ignored, so the frame rate should match the recording's.
+ */
+void replayContinuously(
+    const CameraPath& cameraPath,
+    FrameDriver& driver,
+    const BenchmarkOptions& options,
+    BenchmarkResult& result) {
+  for (const CameraKeyframe& keyframe : cameraPath.getKeyframes()) {
+    if (result.tilesetFailed) {
+      break;
+    }
+
+    const ViewUpdateResult& updateResult = driver.step(keyframe);
+    ++result.replayFrames;
+    if (driver.isFullyLoaded(updateResult)) {
+      ++result.fullDetailFrames;
+    }
+  }
+
+  stopAt(cameraPath.getKeyframes().back(), driver, options, result);
+}
+
+void replay(
+    const CameraPath& cameraPath,
+    FrameDriver& driver,
+    const BenchmarkOptions& options,
+    BenchmarkResult& result) {
+  result.continuous =
+      options.replayMode == ReplayMode::Continuous ||
+      (options.replayMode == ReplayMode::Automatic &&
+       cameraPath.isRecording());
+  if (result.continuous) {
+    replayContinuously(cameraPath, driver, options, result);
+  } else {
+    replayWithStops(cameraPath, driver, options, result);
+  }
+
+  result.totalTime = driver.elapsed();
+  result.peakProcessMemoryBytes = getPeakProcessMemoryBytes();
+}
+
+void printReport(
+    const BenchmarkResult& result,
+    const BenchmarkMetrics& metrics) {
+  std::printf("\nTile streaming benchmark\n\n");
+  if (result.timeToFirstRender) {
+    std::printf("Time to first render:  %.3f s\n", *result.timeToFirstRender);
+  } else {
+    std::printf("Time to first render:  never\n");
+  }
+  std::printf("Total time:            %.3f s\n", result.totalTime);
+  std::printf("Frames:                %lld\n", (long long)result.frameCount);
+  if (result.continuous) {
+    std::printf(
+        "Frames at full detail: %lld of %lld replayed (%.1f%%)\n",
+        (long long)result.fullDetailFrames,
+        (long long)result.replayFrames,
+        result.replayFrames > 0 ? 100.0 * double(result.fullDetailFrames) /
+                                      double(result.replayFrames)
+                                : 0.0);
+  }
+  std::printf(
+      "Tiles loaded:          %lld (%lld unloaded)\n",
+      (long long)metrics.tilesLoaded.load(),
+      (long long)metrics.tilesUnloaded.load());
+  std::printf(
+      "Files read:            %lld, %.2f MB (%lld failed)\n",
+      (long long)metrics.filesRead.load(),
+      double(metrics.fileBytesRead.load()) / (1024.0 * 1024.0),
+      (long long)metrics.failedRequests.load());
+  std::printf(
+      "Model bytes loaded:    %.2f MB\n",
+      double(metrics.modelBytesLoaded.load()) / (1024.0 * 1024.0));
+  std::printf(
+      "Peak tileset memory:   %.2f MB\n",
+      double(result.peakTotalDataBytes) / (1024.0 * 1024.0));
+  std::printf(
+      "Peak process memory:   %.2f MB\n",
+      double(result.peakProcessMemoryBytes) / (1024.0 * 1024.0));
+
+  std::printf(
+      result.continuous ? "\nTime to full detail at the end of the path:\n"
+                        : "\nTime to full detail per keyframe:\n");
+  for (size_t i = 0; i < result.keyframes.size(); ++i) {
+    const KeyframeResult& keyframe = result.keyframes[i];
+    if (keyframe.timeToFullDetail) {
+      std::printf(
+          "  %4zu  t=%8.3f s  %8.3f s  %zu tiles\n",
+          i,
+          keyframe.time,
+          *keyframe.timeToFullDetail,
+          keyframe.tilesRendered);
+    } else {
+      std::printf(
+          "  %4zu  t=%8.3f s  timed out  %zu tiles\n",
+          i,
+          keyframe.time,
+          keyframe.tilesRendered);
+    }
+  }
+
+  std::printf(
+      "\n%-26s %8s %10s %10s %10s %10s\n",
+      "Stage (ms)",
+      "Count",
+      "Mean",
+      "Median",
+      "95th",
+      "Max");
+  for (size_t i = 0; i < size_t(BenchmarkStage::Count); ++i) {
+    BenchmarkStage stage = BenchmarkStage(i);
+    BenchmarkStageSummary summary = metrics.summarize(stage);
+    std::printf(
+        "%-26s %8zu %10.3f %10.3f %10.3f %10.3f\n",
+        BenchmarkMetrics::getStageName(stage),
+        summary.count,
+        summary.mean,
+        summary.median,
+        summary.percentile95,
+        summary.maximum);
+  }
+}
+
+bool writeReport(
+    const std::string& path,
+    const BenchmarkResult& result,
+    const BenchmarkMetrics& metrics) {
+  std::ofstream file{std::filesystem::path(path)};
+  if (!file) {
+    return false;
+  }
+
+  rapidjson::OStreamWrapper stream(file);
+  rapidjson::PrettyWriter<rapidjson::OStreamWrapper> writer(stream);
+
+  writer.StartObject();
+  writer.Key("timeToFirstRender");
+  if (result.timeToFirstRender) {
+    writer.Double(*result.timeToFirstRender);
+  } else {
+    writer.Null();
+  }
+  writer.Key("totalTime");
+  writer.Double(result.totalTime);
+  writer.Key("frameCount");
+  writer.Int64(result.frameCount);
+  writer.Key("replay");
+  writer.String(result.continuous ? "continuous" : "stops");
+  if (result.continuous) {
+    writer.Key("replayFrames");
+    writer.Int64(result.replayFrames);
+    writer.Key("fullDetailFrames");
+    writer.Int64(result.fullDetailFrames);
+  }
+  writer.Key("tilesLoaded");
+  writer.Int64(metrics.tilesLoaded.load());
+  writer.Key("tilesUnloaded");
+  writer.Int64(metrics.tilesUnloaded.load());
+  writer.Key("filesRead");
+  writer.Int64(metrics.filesRead.load());
+  writer.Key("fileBytesRead");
+  writer.Int64(metrics.fileBytesRead.load());
+  writer.Key("failedRequests");
+  writer.Int64(metrics.failedRequests.load());
+  writer.Key("modelBytesLoaded");
+  writer.Int64(metrics.modelBytesLoaded.load());
+  writer.Key("peakTotalDataBytes");
+  writer.Int64(result.peakTotalDataBytes);
+  writer.Key("peakProcessMemoryBytes");
+  writer.Int64(result.peakProcessMemoryBytes);
+
+  writer.Key("keyframes");
+  writer.StartArray();
+  for (const KeyframeResult& keyframe : result.keyframes) {
+    writer.StartObject();
+    writer.Key("time");
+    writer.Double(keyframe.time);
+    writer.Key("timeToFullDetail");
+    if (keyframe.timeToFullDetail) {
+      writer.Double(*keyframe.timeToFullDetail);
+    } else {
+      writer.Null();
+    }
+    writer.Key("tilesRendered");
+    writer.Uint64(keyframe.tilesRendered);
+    writer.EndObject();
+  }
+  writer.EndArray();
+
+  writer.Key("stages");
+  writer.StartObject();
+  for (size_t i = 0; i < size_t(BenchmarkStage::Count); ++i) {
+    BenchmarkStage stage = BenchmarkStage(i);
+    BenchmarkStageSummary summary = metrics.summarize(stage);
+    writer.Key(BenchmarkMetrics::getStageName(stage));
+    writer.StartObject();
+    writer.Key("count");
+    writer.Uint64(summary.count);
+    writer.Key("mean");
+    writer.Double(summary.mean);
+    writer.Key("median");
+    writer.Double(summary.median);
+    writer.Key("percentile95");
+    writer.Double(summary.percentile95);
+    writer.Key("maximum");
+    writer.Double(summary.maximum);
+    writer.EndObject();
+  }
+  writer.EndObject();
+
+  writer.EndObject();
+  return bool(file);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::optional<BenchmarkOptions> maybeOptions = parseArguments(argc, argv);
+  if (!maybeOptions) {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+  BenchmarkOptions& options = *maybeOptions;
+
+  Result<CameraPath> cameraPath = CameraPath::load(options.cameraPath);
+  if (!cameraPath.value) {
+    for (const std::string& error : cameraPath.errors.errors) {
+      std::fprintf(stderr, "%s\n", error.c_str());
+    }
+    return EXIT_FAILURE;
+  }
+
+  std::shared_ptr<BenchmarkMetrics> pMetrics =
+      std::make_shared<BenchmarkMetrics>();
+  AsyncSystem asyncSystem(
+      std::make_shared<BenchmarkTaskProcessor>(options.threadCount));
+
+  TilesetExternals externals{
+      std::make_shared<BenchmarkAssetAccessor>(pMetrics),
+      std::make_shared<BenchmarkPrepareRendererResources>(pMetrics),
+      asyncSystem,
+      std::make_shared<CreditSystem>(),
+      spdlog::default_logger()};
+
+  BenchmarkResult result;
+  options.tilesetOptions.loadErrorCallback =
+      [&result](const TilesetLoadFailureDetails& details) {
+        spdlog::error(details.message);
+        if (details.type == TilesetLoadType::TilesetJson) {
+          result.tilesetFailed = true;
+        }
+      };
+
+  std::unique_ptr<Tileset> pTileset = std::make_unique<Tileset>(
+      externals,
+      getTilesetUrl(options.tileset),
+      options.tilesetOptions);
+
+  FrameDriver driver(*pTileset, asyncSystem, options, result);
+  replay(*cameraPath.value, driver, options, result);
+
+  // In-flight loads must finish before the tileset can be destroyed.
+  SharedFuture<void> destroyed = pTileset->getAsyncDestructionCompleteEvent();
+  pTileset.reset();
+  while (!destroyed.isReady()) {
+    asyncSystem.dispatchMainThreadTasks();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  if (result.tilesetFailed) {
+    std::fprintf(stderr, "The tileset could not be loaded.\n");
+    return EXIT_FAILURE;
+  }
+
+  printReport(result, *pMetrics);
+
+  if (!options.reportPath.empty() &&
+      !writeReport(options.reportPath, result, *pMetrics)) {
+    std::fprintf(
+        stderr,
+        "Could not write the report to %s.\n",
+        options.reportPath.c_str());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
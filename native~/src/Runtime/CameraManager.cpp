@@ -2,6 +2,7 @@
 
 #include "Cesium3DTilesetImpl.h"
 #include "CesiumGeoreferenceImpl.h"
+#include "TilesetUpdateTick.h"
 #include "UnityTransforms.h"
 
 #include <CesiumGeometry/Transforms.h>
@@ -10,12 +11,15 @@
 #include <CesiumUtility/Math.h>
 
 #include <DotNet/CesiumForUnity/Cesium3DTileset.h>
+#include <DotNet/CesiumForUnity/CesiumCameraManager.h>
 #include <DotNet/CesiumForUnity/CesiumEllipsoid.h>
 #include <DotNet/CesiumForUnity/CesiumGeoreference.h>
+#include <DotNet/CesiumForUnity/Helpers.h>
 #include <DotNet/System/Collections/Generic/List1.h>
 #include <DotNet/UnityEngine/Camera.h>
 #include <DotNet/UnityEngine/GameObject.h>
 #include <DotNet/UnityEngine/Matrix4x4.h>
+#include <DotNet/UnityEngine/Time.h>
 #include <DotNet/UnityEngine/Transform.h>
 #include <DotNet/UnityEngine/Vector3.h>
 #include <glm/trigonometric.hpp>
@@ -25,6 +29,10 @@
 #include <DotNet/UnityEditor/SceneView.h>
 #endif
 
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+
 using namespace Cesium3DTilesSelection;
 using namespace CesiumGeospatial;
 using namespace CesiumUtility;
@@ -40,124 +48,222 @@ namespace CesiumForUnityNative {
 
 namespace {
 
-ViewState unityCameraToViewState(
-    const CesiumGeoreference& georeference,
-    const LocalHorizontalCoordinateSystem* pCoordinateSystem,
-    const glm::dmat4& unityWorldToTileset,
-    const Camera& camera) {
+/**
+ * @brief The parameters of a Unity camera, in Unity world coordinates. These
+ * are the same for every tileset, so they are read from Unity only once per
+ * frame.
+ */
+struct UnityCameraParameters {
+  glm::dvec3 position;
+  glm::dvec3 direction;
+  glm::dvec3 up;
+  glm::dvec2 viewportSize;
+  bool orthographic;
+  double halfWidth;
+  double halfHeight;
+  double horizontalFOV;
+  double verticalFOV;
+};
+
+UnityCameraParameters getCameraParameters(const Camera& camera) {
   Transform transform = camera.transform();
+  Vector3 position = transform.position();
+  Vector3 direction = transform.forward();
+  Vector3 up = transform.up();
+
+  UnityCameraParameters result{};
+  result.position = glm::dvec3(position.x, position.y, position.z);
+  result.direction = glm::dvec3(direction.x, direction.y, direction.z);
+  result.up = glm::dvec3(up.x, up.y, up.z);
+  result.viewportSize = glm::dvec2(camera.pixelWidth(), camera.pixelHeight());
+
+  float aspect = camera.aspect();
+  result.orthographic =
+      camera.orthographic() && camera.orthographicSize() > 0.0;
+  if (result.orthographic) {
+    const float halfHeight = camera.orthographicSize();
+    result.halfHeight = halfHeight;
+    result.halfWidth = halfHeight * aspect;
+  } else {
+    result.verticalFOV = Math::degreesToRadians(camera.fieldOfView());
+    result.horizontalFOV =
+        2 * glm::atan(aspect * glm::tan(result.verticalFOV * 0.5));
+  }
 
-  Vector3 cameraPositionUnity = transform.position();
-  glm::dvec3 cameraPosition = glm::dvec3(
-      unityWorldToTileset * glm::dvec4(
-                                cameraPositionUnity.x,
-                                cameraPositionUnity.y,
-                                cameraPositionUnity.z,
-                                1.0));
-
-  Vector3 cameraDirectionUnity = transform.forward();
-  glm::dvec3 cameraDirection = glm::dvec3(
-      unityWorldToTileset * glm::dvec4(
-                                cameraDirectionUnity.x,
-                                cameraDirectionUnity.y,
-                                cameraDirectionUnity.z,
-                                0.0));
-
-  Vector3 cameraUpUnity = transform.up();
-  glm::dvec3 cameraUp = glm::dvec3(
-      unityWorldToTileset *
-      glm::dvec4(cameraUpUnity.x, cameraUpUnity.y, cameraUpUnity.z, 0.0));
+  return result;
+}
+
+CameraPose unityCameraToPose(
+    const LocalHorizontalCoordinateSystem* pCoordinateSystem,
+    const glm::dmat4& unityWorldToTileset,
+    const UnityCameraParameters& camera) {
+  CameraPose pose{
+      glm::dvec3(unityWorldToTileset * glm::dvec4(camera.position, 1.0)),
+      glm::dvec3(unityWorldToTileset * glm::dvec4(camera.direction, 0.0)),
+      glm::dvec3(unityWorldToTileset * glm::dvec4(camera.up, 0.0))};
 
   if (pCoordinateSystem) {
-    cameraPosition = pCoordinateSystem->localPositionToEcef(cameraPosition);
-    cameraDirection = pCoordinateSystem->localDirectionToEcef(cameraDirection);
-    cameraUp = pCoordinateSystem->localDirectionToEcef(cameraUp);
+    pose.position = pCoordinateSystem->localPositionToEcef(pose.position);
+    pose.direction = pCoordinateSystem->localDirectionToEcef(pose.direction);
+    pose.up = pCoordinateSystem->localDirectionToEcef(pose.up);
   }
 
-  const CesiumGeospatial::Ellipsoid& ellipsoid =
-      georeference != nullptr
-          ? georeference.ellipsoid().NativeImplementation().GetEllipsoid()
-          : CesiumGeospatial::Ellipsoid::WGS84;
-
-  if (camera.orthographic() && camera.orthographicSize() > 0.0) {
-    const float halfHeight = camera.orthographicSize();
-    const float halfWidth = halfHeight * camera.aspect();
+  pose.direction = glm::normalize(pose.direction);
+  pose.up = glm::normalize(pose.up);
+  return pose;
+}
 
+ViewState createViewState(
+    const CameraPose& pose,
+    const UnityCameraParameters& camera,
+    const CesiumGeospatial::Ellipsoid& ellipsoid) {
+  if (camera.orthographic) {
     return ViewState(
-        cameraPosition,
-        glm::normalize(cameraDirection),
-        glm::normalize(cameraUp),
-        glm::dvec2(camera.pixelWidth(), camera.pixelHeight()),
-        -halfWidth,
-        halfWidth,
-        -halfHeight,
-        halfHeight,
+        pose.position,
+        pose.direction,
+        pose.up,
+        camera.viewportSize,
+        -camera.halfWidth,
+        camera.halfWidth,
+        -camera.halfHeight,
+        camera.halfHeight,
         ellipsoid);
   } else {
-    const double verticalFOV = Math::degreesToRadians(camera.fieldOfView());
-    const double horizontalFOV =
-        2 * glm::atan(camera.aspect() * glm::tan(verticalFOV * 0.5));
-
     return ViewState(
-        cameraPosition,
-        glm::normalize(cameraDirection),
-        glm::normalize(cameraUp),
-        glm::dvec2(camera.pixelWidth(), camera.pixelHeight()),
-        horizontalFOV,
-        verticalFOV,
+        pose.position,
+        pose.direction,
+        pose.up,
+        camera.viewportSize,
+        camera.horizontalFOV,
+        camera.verticalFOV,
         ellipsoid);
   }
 }
 
-} // namespace
-
-namespace {
+/**
+ * @brief The camera parameters read so far in the current
+ * {@link TilesetUpdateTick}. Each camera is read the first time a tileset asks
+ * for it, and the cache is discarded when the tick changes. Outside Play mode,
+ * the frame count may not change between Editor updates while the scene view
+ * camera moves, so it can't be used to discard the cache.
+ */
+class CameraParametersCache {
+public:
+  static CameraParametersCache& getInstance() {
+    static CameraParametersCache instance;
+    instance.beginTick(TilesetUpdateTick::getInstance().getCurrentTick());
+    return instance;
+  }
 
-void addMainCamera(
-    std::vector<ViewState>& result,
-    const CesiumGeoreference& georeferenceComponent,
-    const CesiumGeospatial::LocalHorizontalCoordinateSystem* pCoordinateSystem,
-    const glm::dmat4& unityWorldToTileset) {
-  Camera camera = Camera::main();
-  if (camera != nullptr) {
-    result.emplace_back(unityCameraToViewState(
-        georeferenceComponent,
-        pCoordinateSystem,
-        unityWorldToTileset,
-        camera));
+  const std::optional<UnityCameraParameters>& getMainCamera() {
+    if (!this->_mainCameraRead) {
+      Camera camera = Camera::main();
+      if (camera != nullptr) {
+        this->_mainCamera = getCameraParameters(camera);
+      }
+      this->_mainCameraRead = true;
+    }
+    return this->_mainCamera;
   }
-}
 
-void addActiveSceneCameraInEditor(
-    std::vector<ViewState>& result,
-    const CesiumGeoreference& georeferenceComponent,
-    const CesiumGeospatial::LocalHorizontalCoordinateSystem* pCoordinateSystem,
-    const glm::dmat4& unityWorldToTileset) {
+  const std::optional<UnityCameraParameters>& getSceneViewCamera() {
+    if (!this->_sceneViewCameraRead) {
 #if UNITY_EDITOR
-  if (!EditorApplication::isPlaying()) {
-    SceneView lastActiveEditorView = SceneView::lastActiveSceneView();
-    if (lastActiveEditorView != nullptr) {
-      Camera editorCamera = lastActiveEditorView.camera();
-      if (editorCamera != nullptr) {
-        result.emplace_back(unityCameraToViewState(
-            georeferenceComponent,
-            pCoordinateSystem,
-            unityWorldToTileset,
-            editorCamera));
+      if (!EditorApplication::isPlaying()) {
+        SceneView lastActiveEditorView = SceneView::lastActiveSceneView();
+        if (lastActiveEditorView != nullptr) {
+          Camera editorCamera = lastActiveEditorView.camera();
+          if (editorCamera != nullptr) {
+            this->_sceneViewCamera = getCameraParameters(editorCamera);
+          }
+        }
       }
+#endif
+      this->_sceneViewCameraRead = true;
     }
+    return this->_sceneViewCamera;
   }
-#endif
-}
 
-} // namespace
+  const std::vector<UnityCameraParameters>&
+  getAdditionalCameras(const CesiumCameraManager& cameraManager) {
+    uint64_t cameraManagerID = Helpers::GetObjectId(cameraManager);
+    auto it = this->_additionalCameras.find(cameraManagerID);
+    if (it != this->_additionalCameras.end()) {
+      return it->second;
+    }
 
-/*static*/ std::vector<Cesium3DTilesSelection::ViewState>
-CameraManager::getAllCameras(
-    const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
-    const CesiumForUnityNative::Cesium3DTilesetImpl& impl) {
-  const LocalHorizontalCoordinateSystem* pCoordinateSystem = nullptr;
+    std::vector<UnityCameraParameters>& result =
+        this->_additionalCameras[cameraManagerID];
+    System::Collections::Generic::List1<Camera> cameras =
+        cameraManager.additionalCameras();
+    for (int32_t i = 0, len = cameras.Count(); i < len; ++i) {
+      Camera camera = cameras[i];
+      if (camera == nullptr)
+        continue;
 
+      result.emplace_back(getCameraParameters(camera));
+    }
+    return result;
+  }
+
+private:
+  CameraParametersCache()
+      : _tick(0),
+        _mainCameraRead(false),
+        _mainCamera(),
+        _sceneViewCameraRead(false),
+        _sceneViewCamera(),
+        _additionalCameras() {}
+
+  void beginTick(uint64_t tick) {
+    if (tick == this->_tick) {
+      return;
+    }
+
+    this->_tick = tick;
+    this->_mainCameraRead = false;
+    this->_mainCamera.reset();
+    this->_sceneViewCameraRead = false;
+    this->_sceneViewCamera.reset();
+    this->_additionalCameras.clear();
+  }
+
+  uint64_t _tick;
+  bool _mainCameraRead;
+  std::optional<UnityCameraParameters> _mainCamera;
+  bool _sceneViewCameraRead;
+  std::optional<UnityCameraParameters> _sceneViewCamera;
+  // Keyed by the object ID of the CesiumCameraManager.
+  std::unordered_map<uint64_t, std::vector<UnityCameraParameters>>
+      _additionalCameras;
+};
+
+/**
+ * @brief The views a camera is expected to have along a planned path, such as
+ * a flight, in ECEF coordinates.
+ */
+struct CameraPlan {
+  UnityCameraParameters camera;
+  std::vector<CameraPose> poses;
+  // The value of Time.timeAsDouble when the camera is expected to reach each
+  // pose, in increasing order.
+  std::vector<double> arrivalTimes;
+};
+
+// Keyed by the ID passed to setCameraPlan.
+std::unordered_map<uint64_t, CameraPlan> cameraPlans;
+
+/**
+ * @brief What is needed to convert Unity world coordinates into the ECEF
+ * coordinates of a tileset.
+ */
+struct TilesetFrame {
+  glm::dmat4 unityWorldToTileset;
+  CesiumGeoreference georeference;
+  const LocalHorizontalCoordinateSystem* pCoordinateSystem;
+};
+
+std::optional<TilesetFrame> getTilesetFrame(const Cesium3DTileset& tileset) {
   glm::dmat4 unityWorldToTileset =
       UnityTransforms::fromUnity(tileset.transform().worldToLocalMatrix());
 
@@ -170,53 +276,184 @@ CameraManager::getAllCameras(
 
   // check for invalid scale
   if (worldScale.x == 0.0 || worldScale.y == 0.0 || worldScale.z == 0.0)
-    return {};
+    return std::nullopt;
 
-  CesiumGeoreference georeferenceComponent =
+  TilesetFrame result{unityWorldToTileset, nullptr, nullptr};
+  result.georeference =
       tileset.gameObject().GetComponentInParent<CesiumGeoreference>();
-  if (georeferenceComponent != nullptr) {
+  if (result.georeference != nullptr) {
     CesiumGeoreferenceImpl& georeference =
-        georeferenceComponent.NativeImplementation();
-    pCoordinateSystem =
-        &georeference.getCoordinateSystem(georeferenceComponent);
+        result.georeference.NativeImplementation();
+    result.pCoordinateSystem =
+        &georeference.getCoordinateSystem(result.georeference);
   }
 
-  std::vector<ViewState> result;
+  return result;
+}
 
+const CesiumGeospatial::Ellipsoid&
+getEllipsoid(const CesiumGeoreference& georeference) {
+  return georeference != nullptr
+             ? georeference.ellipsoid().NativeImplementation().GetEllipsoid()
+             : CesiumGeospatial::Ellipsoid::WGS84;
+}
+
+} // namespace
+
+/*static*/ std::vector<Cesium3DTilesSelection::ViewState>
+CameraManager::getAllCameras(
+    const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+    const CesiumForUnityNative::Cesium3DTilesetImpl& impl,
+    CameraMotionPredictor* pPredictor,
+    double lookAheadTime,
+    std::vector<Cesium3DTilesSelection::ViewState>* pPredictedViewStates) {
+  std::optional<TilesetFrame> maybeFrame = getTilesetFrame(tileset);
+  if (!maybeFrame)
+    return {};
+
+  const glm::dmat4& unityWorldToTileset = maybeFrame->unityWorldToTileset;
+  const LocalHorizontalCoordinateSystem* pCoordinateSystem =
+      maybeFrame->pCoordinateSystem;
+  const CesiumGeospatial::Ellipsoid& ellipsoid =
+      getEllipsoid(maybeFrame->georeference);
+
+  CameraParametersCache& cache = CameraParametersCache::getInstance();
   const CesiumCameraManager& cameraManager = impl.getCameraManager();
 
+  std::vector<UnityCameraParameters> cameras;
+
   if (cameraManager == nullptr || cameraManager.useMainCamera()) {
-    addMainCamera(
-        result,
-        georeferenceComponent,
-        pCoordinateSystem,
-        unityWorldToTileset);
+    const std::optional<UnityCameraParameters>& mainCamera =
+        cache.getMainCamera();
+    if (mainCamera) {
+      cameras.emplace_back(*mainCamera);
+    }
   }
 
   if (cameraManager == nullptr || cameraManager.useSceneViewCameraInEditor()) {
-    addActiveSceneCameraInEditor(
-        result,
-        georeferenceComponent,
-        pCoordinateSystem,
-        unityWorldToTileset);
+    const std::optional<UnityCameraParameters>& sceneViewCamera =
+        cache.getSceneViewCamera();
+    if (sceneViewCamera) {
+      cameras.emplace_back(*sceneViewCamera);
+    }
   }
 
   if (cameraManager != nullptr) {
-    System::Collections::Generic::List1<Camera> cameras =
-        cameraManager.additionalCameras();
-    for (int32_t i = 0, len = cameras.Count(); i < len; ++i) {
-      Camera camera = cameras[i];
-      if (camera == nullptr)
+    const std::vector<UnityCameraParameters>& additionalCameras =
+        cache.getAdditionalCameras(cameraManager);
+    cameras.insert(
+        cameras.end(),
+        additionalCameras.begin(),
+        additionalCameras.end());
+  }
+
+  std::vector<CameraPose> poses;
+  poses.reserve(cameras.size());
+  for (const UnityCameraParameters& camera : cameras) {
+    poses.emplace_back(
+        unityCameraToPose(pCoordinateSystem, unityWorldToTileset, camera));
+  }
+
+  std::vector<ViewState> result;
+  result.reserve(cameras.size());
+  for (size_t i = 0; i < cameras.size(); ++i) {
+    result.emplace_back(createViewState(poses[i], cameras[i], ellipsoid));
+  }
+
+  if (pPredictor && pPredictedViewStates) {
+    std::vector<std::optional<CameraPose>> predictedPoses =
+        pPredictor->update(poses, lookAheadTime);
+    for (size_t i = 0; i < cameras.size(); ++i) {
+      if (predictedPoses[i]) {
+        pPredictedViewStates->emplace_back(
+            createViewState(*predictedPoses[i], cameras[i], ellipsoid));
+      }
+    }
+  }
+
+  return result;
+}
+
+/*static*/ void CameraManager::setCameraPlan(
+    uint64_t planID,
+    const DotNet::UnityEngine::Camera& camera,
+    std::vector<CameraPose>&& poses,
+    std::vector<double>&& arrivalTimes) {
+  if (camera == nullptr || poses.empty() ||
+      poses.size() != arrivalTimes.size()) {
+    cameraPlans.erase(planID);
+    return;
+  }
+
+  cameraPlans[planID] = CameraPlan{
+      getCameraParameters(camera),
+      std::move(poses),
+      std::move(arrivalTimes)};
+}
+
+/*static*/ void CameraManager::clearCameraPlan(uint64_t planID) {
+  cameraPlans.erase(planID);
+}
+
+/*static*/ std::vector<CameraManager::PlannedView>
+CameraManager::getPlannedViews(
+    const DotNet::CesiumForUnity::Cesium3DTileset& tileset) {
+  if (cameraPlans.empty()) {
+    return {};
+  }
+
+  std::optional<TilesetFrame> maybeFrame = getTilesetFrame(tileset);
+  if (!maybeFrame || !maybeFrame->pCoordinateSystem) {
+    return {};
+  }
+
+  // Plans are in true ECEF coordinates. Move them into the georeference's
+  // local coordinates and through Unity's world coordinates into the
+  // tileset's, in case the tileset has been moved relative to its
+  // georeference.
+  const LocalHorizontalCoordinateSystem& coordinateSystem =
+      *maybeFrame->pCoordinateSystem;
+  glm::dmat4 georeferenceToUnityWorld = UnityTransforms::fromUnity(
+      maybeFrame->georeference.transform().localToWorldMatrix());
+  glm::dmat4 ecefToTileset = coordinateSystem.getLocalToEcefTransformation() *
+                             maybeFrame->unityWorldToTileset *
+                             georeferenceToUnityWorld *
+                             coordinateSystem.getEcefToLocalTransformation();
+
+  const CesiumGeospatial::Ellipsoid& ellipsoid =
+      getEllipsoid(maybeFrame->georeference);
+  const double now = Time::timeAsDouble();
+
+  std::vector<PlannedView> result;
+  for (const auto& [planID, plan] : cameraPlans) {
+    for (size_t i = 0; i < plan.poses.size(); ++i) {
+      // Poses that should already have been reached are skipped, except for
+      // the last, which stays until the plan is cleared.
+      double timeToArrival = plan.arrivalTimes[i] - now;
+      if (timeToArrival < 0.0 && i + 1 < plan.poses.size()) {
         continue;
+      }
 
-      result.emplace_back(unityCameraToViewState(
-          georeferenceComponent,
-          pCoordinateSystem,
-          unityWorldToTileset,
-          camera));
+      const CameraPose& pose = plan.poses[i];
+      CameraPose tilesetPose{
+          glm::dvec3(ecefToTileset * glm::dvec4(pose.position, 1.0)),
+          glm::normalize(
+              glm::dvec3(ecefToTileset * glm::dvec4(pose.direction, 0.0))),
+          glm::normalize(
+              glm::dvec3(ecefToTileset * glm::dvec4(pose.up, 0.0)))};
+      result.emplace_back(PlannedView{
+          createViewState(tilesetPose, plan.camera, ellipsoid),
+          std::max(timeToArrival, 0.0)});
     }
   }
 
+  std::sort(
+      result.begin(),
+      result.end(),
+      [](const PlannedView& a, const PlannedView& b) {
+        return a.timeToArrival < b.timeToArrival;
+      });
+
   return result;
 }
 
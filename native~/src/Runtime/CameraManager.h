@@ -1,12 +1,16 @@
 #pragma once
 
+#include "CameraMotionPredictor.h"
+
 #include <Cesium3DTilesSelection/ViewState.h>
 
+#include <cstdint>
 #include <vector>
 
 namespace DotNet::UnityEngine {
+class Camera;
 class GameObject;
-}
+} // namespace DotNet::UnityEngine
 
 namespace DotNet::CesiumForUnity {
 class Cesium3DTileset;
@@ -18,9 +22,67 @@ class Cesium3DTilesetImpl;
 
 class CameraManager {
 public:
+  /**
+   * @brief A view that a camera is expected to have in the future.
+   */
+  struct PlannedView {
+    Cesium3DTilesSelection::ViewState viewState;
+
+    /**
+     * @brief The time until the camera is expected to have the view, in
+     * seconds, or zero if that time has passed.
+     */
+    double timeToArrival;
+  };
+
+  /**
+   * @brief Gets the views of all cameras used by a tileset.
+   *
+   * @param tileset The tileset.
+   * @param impl The tileset's native implementation.
+   * @param pPredictor If not nullptr, the camera poses are recorded with this
+   * predictor, and the predicted views are added to `pPredictedViewStates`.
+   * @param lookAheadTime How far ahead to predict the views, in seconds.
+   * @param pPredictedViewStates Receives the predicted views of the cameras
+   * that are moving.
+   */
   static std::vector<Cesium3DTilesSelection::ViewState> getAllCameras(
       const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
-      const CesiumForUnityNative::Cesium3DTilesetImpl& impl);
+      const CesiumForUnityNative::Cesium3DTilesetImpl& impl,
+      CameraMotionPredictor* pPredictor = nullptr,
+      double lookAheadTime = 0.0,
+      std::vector<Cesium3DTilesSelection::ViewState>* pPredictedViewStates =
+          nullptr);
+
+  /**
+   * @brief Sets the path that a camera is expected to follow, such as during a
+   * flight, so that tilesets can load the tiles it will need in advance.
+   *
+   * @param planID Identifies the plan, so that it can be replaced or cleared.
+   * @param camera The camera whose frustum is used for the planned views.
+   * @param poses The poses the camera is expected to have, in ECEF
+   * coordinates.
+   * @param arrivalTimes The value of `Time.timeAsDouble` when the camera is
+   * expected to reach each pose, in increasing order.
+   */
+  static void setCameraPlan(
+      uint64_t planID,
+      const DotNet::UnityEngine::Camera& camera,
+      std::vector<CameraPose>&& poses,
+      std::vector<double>&& arrivalTimes);
+
+  /**
+   * @brief Removes a plan set with {@link setCameraPlan}.
+   */
+  static void clearCameraPlan(uint64_t planID);
+
+  /**
+   * @brief Gets the views of all camera plans that have not yet been reached,
+   * in the tileset's coordinates, ordered by their time to arrival. The final
+   * view of each plan is kept until the plan is cleared.
+   */
+  static std::vector<PlannedView>
+  getPlannedViews(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
 };
 
 } // namespace CesiumForUnityNative
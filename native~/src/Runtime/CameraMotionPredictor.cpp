@@ -0,0 +1,113 @@
+#include "CameraMotionPredictor.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace CesiumUtility;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// Velocities are smoothed exponentially with this time constant, in seconds.
+constexpr double smoothingTime = 0.2;
+
+// Updates further apart than this, in seconds, such as after the application
+// was paused, don't give a meaningful velocity.
+constexpr double maximumUpdateInterval = 0.5;
+
+// Below these, a camera is considered to be at rest and gets no prediction.
+constexpr double minimumPredictedDistance = 1.0;
+const double minimumPredictedAngle = Math::degreesToRadians(1.0);
+
+// Extrapolating a rotation beyond this quickly becomes meaningless.
+const double maximumPredictedAngle = Math::degreesToRadians(90.0);
+
+glm::dvec3 computeAngularVelocity(
+    const glm::dvec3& previousDirection,
+    const glm::dvec3& direction,
+    double deltaTime) {
+  glm::dvec3 axis = glm::cross(previousDirection, direction);
+  double sinAngle = glm::length(axis);
+  if (sinAngle < Math::Epsilon10) {
+    return glm::dvec3(0.0);
+  }
+
+  double angle = std::atan2(sinAngle, glm::dot(previousDirection, direction));
+  return axis * (angle / (sinAngle * deltaTime));
+}
+
+} // namespace
+
+CameraMotionPredictor::CameraMotionPredictor()
+    : _cameras(), _lastUpdateTime() {}
+
+std::vector<std::optional<CameraPose>> CameraMotionPredictor::update(
+    const std::vector<CameraPose>& poses,
+    double lookAheadTime) {
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point now = Clock::now();
+  double deltaTime =
+      std::chrono::duration<double>(now - this->_lastUpdateTime).count();
+  this->_lastUpdateTime = now;
+
+  std::vector<std::optional<CameraPose>> result(poses.size());
+
+  if (this->_cameras.size() != poses.size() || deltaTime <= 0.0 ||
+      deltaTime > maximumUpdateInterval) {
+    this->_cameras.clear();
+    for (const CameraPose& pose : poses) {
+      this->_cameras.emplace_back(
+          CameraMotion{pose, glm::dvec3(0.0), glm::dvec3(0.0)});
+    }
+    return result;
+  }
+
+  const double smoothing = 1.0 - std::exp(-deltaTime / smoothingTime);
+
+  for (size_t i = 0; i < poses.size(); ++i) {
+    CameraMotion& camera = this->_cameras[i];
+    const CameraPose& pose = poses[i];
+
+    glm::dvec3 velocity = (pose.position - camera.pose.position) / deltaTime;
+    glm::dvec3 angularVelocity = computeAngularVelocity(
+        camera.pose.direction,
+        pose.direction,
+        deltaTime);
+
+    camera.velocity += (velocity - camera.velocity) * smoothing;
+    camera.angularVelocity +=
+        (angularVelocity - camera.angularVelocity) * smoothing;
+    camera.pose = pose;
+
+    glm::dvec3 offset = camera.velocity * lookAheadTime;
+    double rate = glm::length(camera.angularVelocity);
+    double angle = std::min(rate * lookAheadTime, maximumPredictedAngle);
+
+    const bool moving = glm::length(offset) >= minimumPredictedDistance;
+    const bool turning = angle >= minimumPredictedAngle;
+    if (!moving && !turning) {
+      continue;
+    }
+
+    CameraPose& predicted = result[i].emplace(pose);
+    predicted.position += offset;
+    if (turning) {
+      glm::dquat rotation =
+          glm::angleAxis(angle, camera.angularVelocity / rate);
+      predicted.direction = glm::normalize(rotation * pose.direction);
+      predicted.up = glm::normalize(rotation * pose.up);
+    }
+  }
+
+  return result;
+}
+
+void CameraMotionPredictor::reset() { this->_cameras.clear(); }
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief The position and orientation of a camera, in the tileset's ECEF
+ * coordinates.
+ */
+struct CameraPose {
+  glm::dvec3 position;
+  glm::dvec3 direction;
+  glm::dvec3 up;
+};
+
+/**
+ * @brief Predicts where each of a tileset's cameras will be a short time from
+ * now, by extrapolating their recent linear and angular velocities.
+ *
+ * The velocities are smoothed over several updates so that a single uneven
+ * frame does not throw the prediction far off. Cameras are identified by their
+ * position in the list of poses, so the history is discarded whenever the
+ * number of cameras changes.
+ */
+class CameraMotionPredictor {
+public:
+  CameraMotionPredictor();
+
+  /**
+   * @brief Records the current camera poses and predicts where each camera
+   * will be after the given time.
+   *
+   * @param poses The poses of the cameras in this update.
+   * @param lookAheadTime How far ahead to predict, in seconds.
+   * @return The predicted pose of each camera, in the same order. Cameras that
+   * are not moving noticeably, and all cameras until a velocity is known, have
+   * no prediction.
+   */
+  std::vector<std::optional<CameraPose>>
+  update(const std::vector<CameraPose>& poses, double lookAheadTime);
+
+  /**
+   * @brief Forgets all camera history.
+   */
+  void reset();
+
+private:
+  struct CameraMotion {
+    CameraPose pose;
+    glm::dvec3 velocity;
+    // The rotation axis scaled by the rotation rate in radians per second.
+    glm::dvec3 angularVelocity;
+  };
+
+  std::vector<CameraMotion> _cameras;
+  std::chrono::steady_clock::time_point _lastUpdateTime;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,216 @@
+#include "CameraPathRecording.h"
+
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumUtility/Math.h>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <iterator>
+#include <optional>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// Rows are written to the file once this many bytes have been buffered.
+constexpr size_t flushThreshold = 64 * 1024;
+
+// The columns that a row needs in order to be replayed.
+constexpr size_t replayColumnCount = 16;
+
+const char* header =
+    "time,positionX,positionY,positionZ,directionX,directionY,directionZ,"
+    "upX,upY,upZ,verticalFieldOfView,viewportWidth,viewportHeight,frame,"
+    "camera,horizontalFieldOfView,tilesRendered,"
+    "workerThreadTileLoadQueueLength,mainThreadTileLoadQueueLength,"
+    "tilesLoaded,bytesResident,updateTime\n";
+
+bool parseRow(const std::string& line, std::vector<double>& values) {
+  values.clear();
+  const char* pCurrent = line.c_str();
+  while (*pCurrent != '\0') {
+    char* pNext = nullptr;
+    double value = std::strtod(pCurrent, &pNext);
+    if (pNext == pCurrent) {
+      return false;
+    }
+    values.emplace_back(value);
+
+    pCurrent = pNext;
+    if (*pCurrent == ',') {
+      ++pCurrent;
+    } else {
+      break;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+/*static*/ std::unique_ptr<CameraPathRecorder>
+CameraPathRecorder::create(const std::string& path) {
+  std::ofstream file(std::filesystem::path(path), std::ios::binary);
+  if (!file) {
+    SPDLOG_LOGGER_ERROR(
+        spdlog::default_logger(),
+        "Could not create the camera path recording {}.",
+        path);
+    return nullptr;
+  }
+
+  file << header;
+  return std::unique_ptr<CameraPathRecorder>(
+      new CameraPathRecorder(std::move(file)));
+}
+
+CameraPathRecorder::CameraPathRecorder(std::ofstream&& file)
+    : _file(std::move(file)), _buffer(), _startTime(0.0), _started(false) {
+  this->_buffer.reserve(flushThreshold * 2);
+}
+
+CameraPathRecorder::~CameraPathRecorder() { this->flush(); }
+
+void CameraPathRecorder::record(
+    int32_t frame,
+    double time,
+    const std::vector<ViewState>& viewStates,
+    const CameraPathFrameStats& stats) {
+  if (!this->_started) {
+    this->_startTime = time;
+    this->_started = true;
+  }
+
+  auto out = std::back_inserter(this->_buffer);
+  for (size_t i = 0; i < viewStates.size(); ++i) {
+    const ViewState& viewState = viewStates[i];
+    const glm::dvec3& position = viewState.getPosition();
+    const glm::dvec3& direction = viewState.getDirection();
+    const glm::dvec3& up = viewState.getUp();
+    const glm::dvec2& viewportSize = viewState.getViewportSize();
+
+    // fmt writes the shortest representation that reads back exactly, so
+    // replays see the same views.
+    fmt::format_to(
+        out,
+        "{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{}\n",
+        time - this->_startTime,
+        position.x,
+        position.y,
+        position.z,
+        direction.x,
+        direction.y,
+        direction.z,
+        up.x,
+        up.y,
+        up.z,
+        Math::radiansToDegrees(viewState.getVerticalFieldOfView()),
+        viewportSize.x,
+        viewportSize.y,
+        frame,
+        i,
+        Math::radiansToDegrees(viewState.getHorizontalFieldOfView()),
+        stats.tilesRendered,
+        stats.workerThreadTileLoadQueueLength,
+        stats.mainThreadTileLoadQueueLength,
+        stats.tilesLoaded,
+        stats.bytesResident,
+        stats.updateTime);
+  }
+
+  if (this->_buffer.size() >= flushThreshold) {
+    this->flush();
+  }
+}
+
+void CameraPathRecorder::flush() {
+  this->_file.write(
+      this->_buffer.data(),
+      std::streamsize(this->_buffer.size()));
+  this->_file.flush();
+  this->_buffer.clear();
+}
+
+/*static*/ std::unique_ptr<CameraPathPlayer>
+CameraPathPlayer::load(const std::string& path, bool loop) {
+  std::ifstream file{std::filesystem::path(path)};
+  if (!file) {
+    SPDLOG_LOGGER_ERROR(
+        spdlog::default_logger(),
+        "Could not open the camera path recording {}.",
+        path);
+    return nullptr;
+  }
+
+  std::vector<std::vector<RecordedView>> frames;
+  std::optional<double> currentFrame;
+  std::vector<double> values;
+  std::string line;
+  while (std::getline(file, line)) {
+    // Skips the header, and any row from an incomplete write.
+    if (!parseRow(line, values) || values.size() < replayColumnCount) {
+      continue;
+    }
+
+    if (!currentFrame || *currentFrame != values[13]) {
+      currentFrame = values[13];
+      frames.emplace_back();
+    }
+
+    frames.back().emplace_back(RecordedView{
+        glm::dvec3(values[1], values[2], values[3]),
+        glm::dvec3(values[4], values[5], values[6]),
+        glm::dvec3(values[7], values[8], values[9]),
+        glm::dvec2(values[11], values[12]),
+        Math::degreesToRadians(values[15]),
+        Math::degreesToRadians(values[10])});
+  }
+
+  if (frames.empty()) {
+    SPDLOG_LOGGER_ERROR(
+        spdlog::default_logger(),
+        "The camera path recording {} has no views to replay.",
+        path);
+    return nullptr;
+  }
+
+  return std::unique_ptr<CameraPathPlayer>(
+      new CameraPathPlayer(std::move(frames), loop));
+}
+
+CameraPathPlayer::CameraPathPlayer(
+    std::vector<std::vector<RecordedView>>&& frames,
+    bool loop)
+    : _frames(std::move(frames)), _nextFrame(0), _loop(loop) {}
+
+std::vector<ViewState> CameraPathPlayer::next(const Ellipsoid& ellipsoid) {
+  const std::vector<RecordedView>& frame = this->_frames[this->_nextFrame];
+  if (this->_nextFrame + 1 < this->_frames.size()) {
+    ++this->_nextFrame;
+  } else if (this->_loop) {
+    this->_nextFrame = 0;
+  }
+
+  std::vector<ViewState> result;
+  result.reserve(frame.size());
+  for (const RecordedView& view : frame) {
+    result.emplace_back(ViewState(
+        view.position,
+        view.direction,
+        view.up,
+        view.viewportSize,
+        view.horizontalFieldOfView,
+        view.verticalFieldOfView,
+        ellipsoid));
+  }
+  return result;
+}
+
+} // namespace CesiumForUnityNative
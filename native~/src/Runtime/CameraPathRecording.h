@@ -0,0 +1,124 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/ViewState.h>
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumGeospatial {
+class Ellipsoid;
+}
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief The state of a tileset after an update, recorded alongside the views
+ * it was updated for.
+ */
+struct CameraPathFrameStats {
+  int32_t tilesRendered;
+  int32_t workerThreadTileLoadQueueLength;
+  int32_t mainThreadTileLoadQueueLength;
+  int32_t tilesLoaded;
+  int64_t bytesResident;
+  // The main thread time of the update, in milliseconds.
+  double updateTime;
+};
+
+/**
+ * @brief Writes the views that a tileset is updated for, along with the
+ * tileset's state after each update, to a CSV file.
+ *
+ * Each row holds one camera of one update. The first thirteen columns are the
+ * camera path format read by the tile streaming benchmark: `time`,
+ * `positionX`, `positionY`, `positionZ`, `directionX`, `directionY`,
+ * `directionZ`, `upX`, `upY`, `upZ`, `verticalFieldOfView`, `viewportWidth`,
+ * and `viewportHeight`. They are followed by `frame`, `camera`,
+ * `horizontalFieldOfView`, and the {@link CameraPathFrameStats}. Positions and
+ * directions are in the tileset's ECEF coordinates, and fields of view are in
+ * degrees.
+ *
+ * Rows are buffered and written in large blocks, so recording costs little
+ * more than formatting the numbers.
+ */
+class CameraPathRecorder {
+public:
+  /**
+   * @brief Creates a recorder that writes to the given file, replacing it.
+   *
+   * @return The recorder, or nullptr if the file could not be created.
+   */
+  static std::unique_ptr<CameraPathRecorder> create(const std::string& path);
+
+  ~CameraPathRecorder();
+
+  /**
+   * @brief Records the views and resulting state of one update.
+   *
+   * @param frame The Unity frame count of the update.
+   * @param time The time of the update, in seconds. The first update recorded
+   * is at time zero.
+   * @param viewStates The views that the tileset was updated for.
+   * @param stats The state of the tileset after the update.
+   */
+  void record(
+      int32_t frame,
+      double time,
+      const std::vector<Cesium3DTilesSelection::ViewState>& viewStates,
+      const CameraPathFrameStats& stats);
+
+private:
+  explicit CameraPathRecorder(std::ofstream&& file);
+  void flush();
+
+  std::ofstream _file;
+  std::string _buffer;
+  double _startTime;
+  bool _started;
+};
+
+/**
+ * @brief Replays the views recorded by a {@link CameraPathRecorder}, one
+ * recorded update per tileset update, regardless of the frame rate.
+ */
+class CameraPathPlayer {
+public:
+  /**
+   * @brief Reads a recorded camera path.
+   *
+   * @param path The file to read.
+   * @param loop Whether to start over after the last recorded update, rather
+   * than holding its views.
+   * @return The player, or nullptr if the file could not be read or has no
+   * views.
+   */
+  static std::unique_ptr<CameraPathPlayer>
+  load(const std::string& path, bool loop);
+
+  /**
+   * @brief Gets the views of the next recorded update.
+   */
+  std::vector<Cesium3DTilesSelection::ViewState>
+  next(const CesiumGeospatial::Ellipsoid& ellipsoid);
+
+private:
+  struct RecordedView {
+    glm::dvec3 position;
+    glm::dvec3 direction;
+    glm::dvec3 up;
+    glm::dvec2 viewportSize;
+    double horizontalFieldOfView;
+    double verticalFieldOfView;
+  };
+
+  CameraPathPlayer(std::vector<std::vector<RecordedView>>&& frames, bool loop);
+
+  std::vector<std::vector<RecordedView>> _frames;
+  size_t _nextFrame;
+  bool _loop;
+};
+
+} // namespace CesiumForUnityNative
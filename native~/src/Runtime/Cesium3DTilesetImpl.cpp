@@ -1,20 +1,33 @@
 #include "Cesium3DTilesetImpl.h"
 
 #include "CameraManager.h"
+#include "CameraPathRecording.h"
 #include "CesiumEllipsoidImpl.h"
 #include "CesiumIonServerHelper.h"
+#include "MainThreadBudget.h"
+#include "NativeArrayUtility.h"
+#include "SoftwareOcclusionCulling.h"
+#include "TerrainHeightCache.h"
+#include "TileLifecycleTracer.h"
+#include "TileLoadScheduler.h"
+#include "TilesetUpdateTick.h"
+#include "TilesetWarmStart.h"
 #include "UnityPrepareRendererResources.h"
 #include "UnityTileExcluderAdaptor.h"
 #include "UnityTilesetExternals.h"
 
 #include <Cesium3DTilesSelection/EllipsoidTilesetLoader.h>
 #include <Cesium3DTilesSelection/Tileset.h>
+#include <Cesium3DTilesSelection/TilesetViewGroup.h>
+#include <CesiumGeospatial/Cartographic.h>
 #include <CesiumGeospatial/GlobeTransforms.h>
+#include <CesiumGltf/Model.h>
 #include <CesiumImage/Ktx2TranscodeTargets.h>
 #include <CesiumIonClient/Connection.h>
 #include <CesiumRasterOverlays/IonRasterOverlay.h>
 
 #include <DotNet/CesiumForUnity/Cesium3DTileset.h>
+#include <DotNet/CesiumForUnity/Cesium3DTilesetFrameStats.h>
 #include <DotNet/CesiumForUnity/Cesium3DTilesetLoadFailureDetails.h>
 #include <DotNet/CesiumForUnity/Cesium3DTilesetLoadType.h>
 #include <DotNet/CesiumForUnity/CesiumCameraManager.h>
@@ -23,13 +36,19 @@
 #include <DotNet/CesiumForUnity/CesiumGeoreference.h>
 #include <DotNet/CesiumForUnity/CesiumIonServer.h>
 #include <DotNet/CesiumForUnity/CesiumRasterOverlay.h>
+#include <DotNet/CesiumForUnity/CesiumRuntimeSettings.h>
+#include <DotNet/CesiumForUnity/CesiumSampleHeightBatch.h>
 #include <DotNet/CesiumForUnity/CesiumSampleHeightResult.h>
 #include <DotNet/CesiumForUnity/CesiumTileExcluder.h>
+#include <DotNet/CesiumForUnity/Helpers.h>
 #include <DotNet/System/Exception.h>
 #include <DotNet/System/Object.h>
 #include <DotNet/System/String.h>
 #include <DotNet/System/Threading/Tasks/Task1.h>
 #include <DotNet/System/Threading/Tasks/TaskCompletionSource1.h>
+#include <DotNet/Unity/Collections/Allocator.h>
+#include <DotNet/Unity/Collections/NativeArray1.h>
+#include <DotNet/Unity/Collections/NativeArrayOptions.h>
 #include <DotNet/Unity/Mathematics/double3.h>
 #include <DotNet/UnityEngine/Application.h>
 #include <DotNet/UnityEngine/Camera.h>
@@ -45,7 +64,12 @@
 #include <DotNet/UnityEngine/Time.h>
 #include <DotNet/UnityEngine/Transform.h>
 #include <DotNet/UnityEngine/Vector3.h>
+#include <fmt/format.h>
 
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <span>
 #include <variant>
 
 #if UNITY_EDITOR
@@ -64,12 +88,28 @@ Cesium3DTilesetImpl::Cesium3DTilesetImpl(
     const DotNet::CesiumForUnity::Cesium3DTileset& tileset)
     : _pTileset(),
       _lastUpdateResult(),
+      _visibilityChangesThisFrame(0),
+      _lastVisibilityChanges(0),
+      _gameObjectsToHide(),
+      _gameObjectsToShow(),
+      _recordFrameStats(false),
+      _frameStats(),
+      _nextFrameStatsIndex(0),
+      _pPredictionViewGroup(),
+      _cameraMotionPredictor(),
+      _plannedViewGroups(),
+      _predictedTilesLoaded(0),
+      _predictedTilesShown(0),
+      _pCameraPathRecorder(),
+      _pCameraPathPlayer(),
+      _pWarmStart(),
 #if UNITY_EDITOR
       _updateInEditorCallback(nullptr),
 #endif
       _creditSystem(nullptr),
       _cameraManager(nullptr),
       _destroyTilesetOnNextUpdate(false),
+      _structuralOptions(),
       _lastOpaqueMaterialHash(0) {
 }
 
@@ -146,53 +186,492 @@ void Cesium3DTilesetImpl::UpdateInternal(
       return;
   }
 
+  const uint64_t tick = TilesetUpdateTick::getInstance().beginTilesetUpdate(
+      this,
+      DotNet::UnityEngine::Time::frameCount());
+
+  MainThreadBudget& budget = MainThreadBudget::getInstance();
+  MainThreadBudget::Limits limits = budget.beginTilesetUpdate(tick);
+  TilesetOptions& options = this->_pTileset->getOptions();
+  options.mainThreadLoadingTimeLimit = limits.loadingTimeLimit;
+  options.tileCacheUnloadTimeLimit = limits.unloadingTimeLimit;
+
+  // cesium-native only counts the glTF data of tiles toward the cache limit,
+  // so the Unity meshes, colliders, and textures made from it are taken out of
+  // the limit first.
+  const UnityPrepareRendererResources* pPrepareRendererResources =
+      static_cast<const UnityPrepareRendererResources*>(
+          this->_pTileset->getExternals().pPrepareRendererResources.get());
+  const int64_t renderResourceBytes =
+      pPrepareRendererResources->getRenderResourceBytes();
+  options.maximumCachedBytes = std::max(
+      tileset.maximumCachedBytes() - renderResourceBytes,
+      int64_t(0));
+
+  TileLoadScheduler& scheduler = TileLoadScheduler::getInstance();
+  options.maximumSimultaneousTileLoads = scheduler.beginTilesetUpdate(
+      this,
+      tick,
+      CesiumForUnity::CesiumRuntimeSettings::maximumSimultaneousTileLoads(),
+      tileset.loadPriorityWeight(),
+      int32_t(tileset.maximumSimultaneousTileLoads()));
+
+  // Main thread tasks include finishing tile loads that were started in
+  // earlier frames, so they are timed along with everything else. The other
+  // stages are only timed separately when frame stats are being recorded.
+  using Clock = std::chrono::steady_clock;
+  const bool recordFrameStats = this->_recordFrameStats;
+  Clock::time_point updateStart = Clock::now();
+
   getAsyncSystem().dispatchMainThreadTasks();
-  std::vector<ViewState> viewStates =
-      CameraManager::getAllCameras(tileset, *this);
+  Clock::time_point dispatchEnd =
+      recordFrameStats ? Clock::now() : updateStart;
+
+  // A camera path that is being replayed takes the place of the live cameras,
+  // and nothing is predicted from it.
+  const double lookAheadTime =
+      this->_pCameraPathPlayer ? 0.0 : tileset.predictiveLoadingTime();
+  std::vector<ViewState> predictedViewStates;
+  std::vector<ViewState> viewStates;
+  if (this->_pCameraPathPlayer) {
+    viewStates = this->_pCameraPathPlayer->next(
+        this->_pTileset->getOptions().ellipsoid);
+  } else if (lookAheadTime > 0.0) {
+    viewStates = CameraManager::getAllCameras(
+        tileset,
+        *this,
+        &this->_cameraMotionPredictor,
+        lookAheadTime,
+        &predictedViewStates);
+  } else {
+    viewStates = CameraManager::getAllCameras(tileset, *this);
+  }
+
+  // The tiles of the previous session are selected first, so that their loads
+  // are queued ahead of those for the live cameras.
+  size_t pendingLoads = 0;
+  if (this->_pWarmStart) {
+    pendingLoads += this->_pWarmStart->restore(
+        DotNet::UnityEngine::Time::realtimeSinceStartupAsDouble());
+  }
+
+  // Tiles are only tested for occlusion while selecting for a single live
+  // camera, because they are tested against what that camera saw.
+  SoftwareOcclusionProxyPool* pOcclusionProxyPool =
+      static_cast<SoftwareOcclusionProxyPool*>(
+          this->_pTileset->getExternals().pTileOcclusionProxyPool.get());
+  const bool occlusionCulling = pOcclusionProxyPool && viewStates.size() == 1;
+  if (occlusionCulling) {
+    SoftwareOcclusionCulling::getInstance().beginTilesetUpdate(
+        tick,
+        viewStates[0]);
+    pOcclusionProxyPool->setEnabled(true);
+  }
 
   const ViewUpdateResult& updateResult = this->_pTileset->updateViewGroup(
       this->_pTileset->getDefaultViewGroup(),
       viewStates,
       DotNet::UnityEngine::Time::deltaTime());
+
+  if (pOcclusionProxyPool) {
+    pOcclusionProxyPool->setEnabled(false);
+  }
+
+  const ViewUpdateResult* pPredictionResult =
+      this->updatePredictionViewGroup(lookAheadTime, predictedViewStates);
+
+  pendingLoads += updateResult.workerThreadTileLoadQueueLength;
+  if (pPredictionResult) {
+    pendingLoads += pPredictionResult->workerThreadTileLoadQueueLength;
+  }
+  pendingLoads += this->updatePlannedViewGroups(tileset);
+  scheduler.endTilesetUpdate(this, int32_t(pendingLoads));
+
+  Clock::time_point loadStart = Clock::now();
   this->_pTileset->loadTiles();
+  Clock::time_point loadEnd = Clock::now();
 
-  this->updateLastViewUpdateResultState(tileset, updateResult);
+  // Raster overlays attached while updating the view and loading tiles are
+  // applied together, once per tile.
+  static_cast<UnityPrepareRendererResources*>(
+      this->_pTileset->getExternals().pPrepareRendererResources.get())
+      ->applyPendingRasterOverlays();
+  Clock::time_point overlaysEnd = recordFrameStats ? Clock::now() : loadEnd;
+
+  // Tiles usually stay visible, or hidden, for many frames in a row, so only
+  // changes in visibility are sent to Unity.
+  this->_visibilityChangesThisFrame = 0;
 
   for (auto pTile : updateResult.tilesFadingOut) {
-    if (pTile->getState() != TileLoadState::Done) {
-      continue;
+    this->setTileVisibility(*pTile, false);
+  }
+
+  for (auto pTile : updateResult.tilesToRenderThisFrame) {
+    this->setTileVisibility(*pTile, true);
+  }
+
+  this->applyTileVisibilityChanges();
+
+  if (occlusionCulling) {
+    SoftwareOcclusionCulling::getInstance().addOccluders(
+        viewStates[0],
+        updateResult);
+  }
+
+  if (pPredictionResult) {
+    this->markPredictedTiles(*pPredictionResult);
+  }
+
+  this->updateLastViewUpdateResultState(tileset, updateResult);
+
+  // A replayed camera path is not where the user left off.
+  if (this->_pWarmStart && !this->_pCameraPathPlayer) {
+    this->_pWarmStart->update(
+        viewStates,
+        updateResult,
+        DotNet::UnityEngine::Time::realtimeSinceStartupAsDouble());
+  }
+
+  Clock::time_point updateEnd = Clock::now();
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  double budgetedTime = Milliseconds(loadEnd - loadStart).count();
+  budget.endTilesetUpdate(
+      Milliseconds(updateEnd - updateStart).count() - budgetedTime,
+      budgetedTime);
+
+  if (this->_pCameraPathRecorder) {
+    this->_pCameraPathRecorder->record(
+        DotNet::UnityEngine::Time::frameCount(),
+        DotNet::UnityEngine::Time::realtimeSinceStartupAsDouble(),
+        viewStates,
+        CameraPathFrameStats{
+            int32_t(updateResult.tilesToRenderThisFrame.size()),
+            int32_t(updateResult.workerThreadTileLoadQueueLength),
+            int32_t(updateResult.mainThreadTileLoadQueueLength),
+            this->_pTileset->getNumberOfTilesLoaded(),
+            this->_pTileset->getTotalDataBytes(),
+            Milliseconds(updateEnd - updateStart).count()});
+  }
+
+  if (recordFrameStats) {
+    CesiumForUnity::Cesium3DTilesetFrameStats& stats = this->addFrameStats();
+    stats.frameCount = DotNet::UnityEngine::Time::frameCount();
+    stats.tilesVisited = int32_t(updateResult.tilesVisited);
+    stats.culledTilesVisited = int32_t(updateResult.culledTilesVisited);
+    stats.tilesCulled = int32_t(updateResult.tilesCulled);
+    stats.tilesRendered = int32_t(updateResult.tilesToRenderThisFrame.size());
+    stats.maxDepthVisited = int32_t(updateResult.maxDepthVisited);
+    stats.workerThreadTileLoadQueueLength =
+        int32_t(updateResult.workerThreadTileLoadQueueLength);
+    stats.mainThreadTileLoadQueueLength =
+        int32_t(updateResult.mainThreadTileLoadQueueLength);
+    stats.tilesLoaded = this->_pTileset->getNumberOfTilesLoaded();
+    stats.bytesResident = this->_pTileset->getTotalDataBytes();
+    stats.visibilityChanges = this->_visibilityChangesThisFrame;
+    stats.dispatchTime = Milliseconds(dispatchEnd - updateStart).count();
+    stats.selectionTime = Milliseconds(loadStart - dispatchEnd).count();
+    stats.prepareTime = budgetedTime;
+    stats.overlayTime = Milliseconds(overlaysEnd - loadEnd).count();
+    stats.visibilityTime = Milliseconds(updateEnd - overlaysEnd).count();
+
+    stats.renderResourceBytes =
+        pPrepareRendererResources->getRenderResourceBytes();
+    stats.predictedTilesLoaded = this->_predictedTilesLoaded;
+    stats.predictedTilesShown = this->_predictedTilesShown;
+    stats.predictedTilesWasted =
+        pPrepareRendererResources->getWastedPredictedTiles();
+    stats.predictedBytesWasted =
+        pPrepareRendererResources->getWastedPredictedBytes();
+  }
+}
+
+CesiumForUnity::Cesium3DTilesetFrameStats&
+Cesium3DTilesetImpl::addFrameStats() {
+  if (this->_frameStats.size() < frameStatsCapacity) {
+    return this->_frameStats.emplace_back();
+  }
+
+  // The buffer is full, so overwrite the oldest entry.
+  CesiumForUnity::Cesium3DTilesetFrameStats& stats =
+      this->_frameStats[this->_nextFrameStatsIndex];
+  this->_nextFrameStatsIndex =
+      (this->_nextFrameStatsIndex + 1) % frameStatsCapacity;
+  return stats;
+}
+
+void Cesium3DTilesetImpl::SetRecordFrameStats(
+    const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+    bool value) {
+  this->_recordFrameStats = value;
+  if (value) {
+    this->_frameStats.reserve(frameStatsCapacity);
+  } else {
+    this->_frameStats = {};
+    this->_nextFrameStatsIndex = 0;
+  }
+}
+
+CesiumForUnity::CesiumTerrainHeightSample
+Cesium3DTilesetImpl::SampleHeightCached(
+    const CesiumForUnity::Cesium3DTileset& tileset,
+    double longitude,
+    double latitude) {
+  CesiumForUnity::CesiumTerrainHeightSample result;
+  result.success = false;
+  result.height = 0.0;
+  result.geometricError = 0.0;
+
+  const Tileset* pTileset = this->getTileset();
+  if (!pTileset) {
+    return result;
+  }
+
+  TerrainHeightCache& heightCache =
+      static_cast<UnityPrepareRendererResources*>(
+          pTileset->getExternals().pPrepareRendererResources.get())
+          ->getTerrainHeightCache();
+  std::optional<TerrainHeightSample> sample = heightCache.sampleHeight(
+      *pTileset,
+      CesiumGeospatial::Cartographic::fromDegrees(longitude, latitude));
+  if (sample) {
+    result.success = true;
+    result.height = sample->height;
+    result.geometricError = sample->geometricError;
+  }
+  return result;
+}
+
+int32_t Cesium3DTilesetImpl::GetFrameStats(
+    const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+    const DotNet::Unity::Collections::NativeArray1<
+        DotNet::CesiumForUnity::Cesium3DTilesetFrameStats>& stats) {
+  std::span<CesiumForUnity::Cesium3DTilesetFrameStats> destination =
+      NativeArrayUtility::asSpan(stats);
+  const size_t size = this->_frameStats.size();
+  const size_t count = std::min(destination.size(), size);
+
+  // Entries from _nextFrameStatsIndex onwards are older than those before it.
+  for (size_t i = 0; i < count; ++i) {
+    size_t age = size - count + i;
+    destination[i] =
+        this->_frameStats[(this->_nextFrameStatsIndex + age) % size];
+  }
+
+  return int32_t(count);
+}
+
+bool Cesium3DTilesetImpl::StartCameraPathRecording(
+    const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+    const DotNet::System::String& path) {
+  this->StopCameraPath(tileset);
+  this->_pCameraPathRecorder = CameraPathRecorder::create(path.ToStlString());
+  return this->_pCameraPathRecorder != nullptr;
+}
+
+bool Cesium3DTilesetImpl::StartCameraPathReplay(
+    const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+    const DotNet::System::String& path,
+    bool loop) {
+  this->StopCameraPath(tileset);
+  this->_pCameraPathPlayer = CameraPathPlayer::load(path.ToStlString(), loop);
+  return this->_pCameraPathPlayer != nullptr;
+}
+
+void Cesium3DTilesetImpl::StopCameraPath(
+    const DotNet::CesiumForUnity::Cesium3DTileset& tileset) {
+  this->_pCameraPathRecorder.reset();
+  this->_pCameraPathPlayer.reset();
+}
+
+namespace {
+
+CesiumGltfGameObject* getCesiumGameObject(const Tile& tile) {
+  if (tile.getState() != TileLoadState::Done) {
+    return nullptr;
+  }
+
+  const Cesium3DTilesSelection::TileContent& content = tile.getContent();
+  const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+      content.getRenderContent();
+  if (!pRenderContent) {
+    return nullptr;
+  }
+
+  return static_cast<CesiumGltfGameObject*>(
+      pRenderContent->getRenderResources());
+}
+
+int64_t computeModelBytes(const CesiumGltf::Model& model) {
+  int64_t bytes = 0;
+  for (const CesiumGltf::Buffer& buffer : model.buffers) {
+    bytes += int64_t(buffer.cesium.data.size());
+  }
+  for (const CesiumGltf::Image& image : model.images) {
+    if (image.pAsset) {
+      bytes += int64_t(image.pAsset->pixelData.size());
     }
+  }
+  return bytes;
+}
 
-    const Cesium3DTilesSelection::TileContent& content = pTile->getContent();
-    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
-        content.getRenderContent();
-    if (pRenderContent) {
-      CesiumGltfGameObject* pCesiumGameObject =
-          static_cast<CesiumGltfGameObject*>(
-              pRenderContent->getRenderResources());
-      if (pCesiumGameObject && pCesiumGameObject->pGameObject) {
-        pCesiumGameObject->pGameObject->SetActive(false);
+// Tiles for predicted views get this share of the tile loads relative to the
+// tiles for the current views.
+constexpr double predictionViewGroupWeight = 0.25;
+
+// Tiles for a planned view that is about to be reached get this share of the
+// tile loads relative to the tiles for the current views. The share falls off
+// with the time until the view is reached.
+constexpr double plannedViewGroupWeight = 0.5;
+
+// The most planned views that tiles are loaded for at a time. Each is a full
+// traversal of the tileset every frame, so only the views that are reached
+// next are loaded, and later ones take their place as they are reached.
+constexpr size_t maximumPlannedViewGroups = 2;
+
+} // namespace
+
+void Cesium3DTilesetImpl::setTileVisibility(
+    const Cesium3DTilesSelection::Tile& tile,
+    bool visible) {
+  CesiumGltfGameObject* pCesiumGameObject = getCesiumGameObject(tile);
+  if (!pCesiumGameObject || !pCesiumGameObject->pGameObject ||
+      pCesiumGameObject->isActive == visible) {
+    return;
+  }
+
+  if (visible) {
+    this->_gameObjectsToShow.emplace_back(pCesiumGameObject->gameObjectID);
+    if (!pCesiumGameObject->hasBeenShown) {
+      pCesiumGameObject->hasBeenShown = true;
+      TileLifecycleTracer::instant(pCesiumGameObject->traceID, "First shown");
+      if (pCesiumGameObject->isPredicted) {
+        pCesiumGameObject->isPredicted = false;
+        ++this->_predictedTilesShown;
       }
     }
+  } else {
+    this->_gameObjectsToHide.emplace_back(pCesiumGameObject->gameObjectID);
   }
 
-  for (auto pTile : updateResult.tilesToRenderThisFrame) {
-    if (pTile->getState() != TileLoadState::Done) {
+  pCesiumGameObject->isActive = visible;
+  ++this->_visibilityChangesThisFrame;
+}
+
+const ViewUpdateResult* Cesium3DTilesetImpl::updatePredictionViewGroup(
+    double lookAheadTime,
+    const std::vector<ViewState>& viewStates) {
+  if (lookAheadTime <= 0.0) {
+    // Releases the tiles that were kept loaded for the predicted views.
+    this->_pPredictionViewGroup.reset();
+    this->_cameraMotionPredictor.reset();
+    return nullptr;
+  }
+
+  if (!this->_pPredictionViewGroup) {
+    this->_pPredictionViewGroup = std::make_unique<TilesetViewGroup>();
+    this->_pPredictionViewGroup->setWeight(predictionViewGroupWeight);
+    this->_pTileset->registerLoadRequester(*this->_pPredictionViewGroup);
+  }
+
+  // This is updated even when no camera is moving, so that the group stops
+  // requesting the tiles of earlier predictions.
+  return &this->_pTileset->updateViewGroup(
+      *this->_pPredictionViewGroup,
+      viewStates,
+      DotNet::UnityEngine::Time::deltaTime());
+}
+
+size_t Cesium3DTilesetImpl::updatePlannedViewGroups(
+    const DotNet::CesiumForUnity::Cesium3DTileset& tileset) {
+  std::vector<CameraManager::PlannedView> plannedViews =
+      CameraManager::getPlannedViews(tileset);
+  if (plannedViews.size() > maximumPlannedViewGroups) {
+    plannedViews.erase(
+        plannedViews.begin() + maximumPlannedViewGroups,
+        plannedViews.end());
+  }
+
+  // Views are dropped from the front of the plans as they are reached, so
+  // drop groups from the front too, so that the remaining groups keep the
+  // same views. While more views remain than there are groups, each group
+  // moves on to the view after its own, whose tiles the next group has
+  // already loaded.
+  if (this->_plannedViewGroups.size() > plannedViews.size()) {
+    this->_plannedViewGroups.erase(
+        this->_plannedViewGroups.begin(),
+        this->_plannedViewGroups.begin() +
+            (this->_plannedViewGroups.size() - plannedViews.size()));
+  }
+
+  while (this->_plannedViewGroups.size() < plannedViews.size()) {
+    this->_plannedViewGroups.emplace_back(
+        std::make_unique<TilesetViewGroup>());
+    this->_pTileset->registerLoadRequester(*this->_plannedViewGroups.back());
+  }
+
+  size_t pendingLoads = 0;
+  for (size_t i = 0; i < plannedViews.size(); ++i) {
+    const CameraManager::PlannedView& plannedView = plannedViews[i];
+    TilesetViewGroup& viewGroup = *this->_plannedViewGroups[i];
+    viewGroup.setWeight(
+        plannedViewGroupWeight / (1.0 + plannedView.timeToArrival));
+
+    const ViewUpdateResult& result = this->_pTileset->updateViewGroup(
+        viewGroup,
+        {plannedView.viewState},
+        DotNet::UnityEngine::Time::deltaTime());
+    pendingLoads += result.workerThreadTileLoadQueueLength;
+  }
+
+  return pendingLoads;
+}
+
+void Cesium3DTilesetImpl::markPredictedTiles(
+    const ViewUpdateResult& predictionResult) {
+  // A loaded tile selected for a predicted view that has never been shown was,
+  // as far as can be told, loaded because of the prediction.
+  for (const Tile* pTile : predictionResult.tilesToRenderThisFrame) {
+    CesiumGltfGameObject* pCesiumGameObject = getCesiumGameObject(*pTile);
+    if (!pCesiumGameObject || pCesiumGameObject->hasBeenShown ||
+        pCesiumGameObject->isPredicted) {
       continue;
     }
 
-    const Cesium3DTilesSelection::TileContent& content = pTile->getContent();
-    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
-        content.getRenderContent();
-    if (pRenderContent) {
-      CesiumGltfGameObject* pCesiumGameObject =
-          static_cast<CesiumGltfGameObject*>(
-              pRenderContent->getRenderResources());
-      if (pCesiumGameObject && pCesiumGameObject->pGameObject) {
-        pCesiumGameObject->pGameObject->SetActive(true);
-      }
-    }
+    pCesiumGameObject->isPredicted = true;
+    pCesiumGameObject->predictedBytes =
+        computeModelBytes(pTile->getContent().getRenderContent()->getModel());
+    ++this->_predictedTilesLoaded;
+  }
+}
+
+void Cesium3DTilesetImpl::applyTileVisibilityChanges() {
+  size_t hideCount = this->_gameObjectsToHide.size();
+  size_t count = hideCount + this->_gameObjectsToShow.size();
+  if (count == 0) {
+    return;
   }
+
+  // Hidden game objects come first, so that a tile that was hidden and then
+  // shown again in the same update ends up visible.
+  Unity::Collections::NativeArray1<uint64_t> objectIDs(
+      int32_t(count),
+      Unity::Collections::Allocator::Temp,
+      Unity::Collections::NativeArrayOptions::UninitializedMemory);
+  std::span<uint64_t> ids = NativeArrayUtility::asSpan(objectIDs);
+  std::copy(
+      this->_gameObjectsToHide.begin(),
+      this->_gameObjectsToHide.end(),
+      ids.begin());
+  std::copy(
+      this->_gameObjectsToShow.begin(),
+      this->_gameObjectsToShow.end(),
+      ids.begin() + hideCount);
+
+  CesiumForUnity::Helpers::SetGameObjectsActive(objectIDs, int32_t(hideCount));
+  objectIDs.Dispose();
+
+  this->_gameObjectsToHide.clear();
+  this->_gameObjectsToShow.clear();
 }
 
 void Cesium3DTilesetImpl::OnValidate(
@@ -201,6 +680,12 @@ void Cesium3DTilesetImpl::OnValidate(
   if (tileset.suspendUpdate() != tileset.previousSuspendUpdate()) {
     // If so, don't destroy the tileset.
     tileset.previousSuspendUpdate(tileset.suspendUpdate());
+  } else if (
+      this->_pTileset &&
+      getStructuralOptions(tileset) == this->_structuralOptions) {
+    // Only options that the existing tileset can take in place have changed,
+    // so its loaded tiles are kept.
+    this->UpdateTilesetOptions(tileset);
   } else {
     // Otherwise, destroy the tileset so it can be recreated with new settings.
     // Unity does not allow us to destroy GameObjects and MonoBehaviours in this
@@ -244,6 +729,41 @@ void Cesium3DTilesetImpl::OnDisable(
   this->DestroyTileset(tileset);
 }
 
+namespace {
+
+// Sets the options that an existing tileset can take in place, without
+// reloading its tiles.
+void setLiveOptions(
+    const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+    TilesetOptions& options) {
+  options.maximumScreenSpaceError = tileset.maximumScreenSpaceError();
+  options.preloadAncestors = tileset.preloadAncestors();
+  options.preloadSiblings = tileset.preloadSiblings();
+  options.forbidHoles = tileset.forbidHoles();
+  options.maximumSimultaneousTileLoads = tileset.maximumSimultaneousTileLoads();
+  options.maximumCachedBytes = tileset.maximumCachedBytes();
+  options.loadingDescendantLimit = tileset.loadingDescendantLimit();
+  options.enableFrustumCulling = tileset.enableFrustumCulling();
+  options.enableFogCulling = tileset.enableFogCulling();
+  options.enforceCulledScreenSpaceError =
+      tileset.enforceCulledScreenSpaceError();
+  options.culledScreenSpaceError = tileset.culledScreenSpaceError();
+}
+
+} // namespace
+
+void Cesium3DTilesetImpl::UpdateTilesetOptions(
+    const DotNet::CesiumForUnity::Cesium3DTileset& tileset) {
+  // A tileset that hasn't been created yet reads the options when it is.
+  if (!this->_pTileset) {
+    return;
+  }
+
+  // The selection of the next update uses the new options. Tiles that are no
+  // longer needed are unloaded as usual once the cache is over its limit.
+  setLiveOptions(tileset, this->_pTileset->getOptions());
+}
+
 void Cesium3DTilesetImpl::RecreateTileset(
     const DotNet::CesiumForUnity::Cesium3DTileset& tileset) {
   this->DestroyTileset(tileset);
@@ -327,6 +847,7 @@ void Cesium3DTilesetImpl::updateOverlayMaterialKeys(
           this->_pTileset->getExternals().pPrepareRendererResources.get());
   pRendererResources->getMaterialProperties().updateOverlayParameterIDs(
       overlayMaterialKeys);
+  pRendererResources->updateOverlayAtlasSupport(overlayMaterialKeys);
 }
 
 void Cesium3DTilesetImpl::UpdateOverlayMaterialKeys(
@@ -403,6 +924,16 @@ void Cesium3DTilesetImpl::FocusTileset(
 #endif
 }
 
+int64_t Cesium3DTilesetImpl::GetRenderResourceBytes(
+    const DotNet::CesiumForUnity::Cesium3DTileset& tileset) {
+  if (getTileset() == nullptr) {
+    return 0;
+  }
+  return static_cast<const UnityPrepareRendererResources*>(
+             getTileset()->getExternals().pPrepareRendererResources.get())
+      ->getRenderResourceBytes();
+}
+
 float Cesium3DTilesetImpl::ComputeLoadProgress(
     const DotNet::CesiumForUnity::Cesium3DTileset& tileset) {
   if (getTileset() == nullptr) {
@@ -504,6 +1035,107 @@ Cesium3DTilesetImpl::SampleHeightMostDetailed(
   return promise.Task();
 }
 
+void Cesium3DTilesetImpl::SampleHeightsNative(
+    const CesiumForUnity::Cesium3DTileset& tileset,
+    const Unity::Collections::NativeArray1<Unity::Mathematics::double3>&
+        longitudeLatitudeHeightPositions,
+    const Unity::Collections::NativeArray1<bool>& sampleSuccess,
+    bool loadedTilesOnly,
+    const CesiumForUnity::CesiumSampleHeightBatch& batch) {
+  if (this->getTileset() == nullptr) {
+    // Calling DestroyTileset ensures _destroyTilesetOnNextUpdate is reset.
+    this->DestroyTileset(tileset);
+    this->LoadTileset(tileset);
+  }
+
+  std::span<Unity::Mathematics::double3> positions =
+      NativeArrayUtility::asSpan(longitudeLatitudeHeightPositions);
+  std::span<bool> success = NativeArrayUtility::asSpan(sampleSuccess);
+
+  const Tileset* pTileset = this->getTileset();
+  if (!pTileset) {
+    if (batch.TryStartCompleting()) {
+      std::fill_n(success.begin(), positions.size(), false);
+      System::Array1<System::String> warnings(1);
+      warnings.Item(
+          0,
+          System::String("Could not sample heights from tileset because it "
+                         "has not been created."));
+      batch.Complete(warnings);
+    }
+    return;
+  }
+
+  if (loadedTilesOnly) {
+    if (!batch.TryStartCompleting()) {
+      return;
+    }
+
+    TerrainHeightCache& heightCache =
+        static_cast<UnityPrepareRendererResources*>(
+            pTileset->getExternals().pPrepareRendererResources.get())
+            ->getTerrainHeightCache();
+    for (size_t i = 0; i < positions.size(); ++i) {
+      Unity::Mathematics::double3& position = positions[i];
+      std::optional<TerrainHeightSample> sample = heightCache.sampleHeight(
+          *pTileset,
+          CesiumGeospatial::Cartographic::fromDegrees(position.x, position.y));
+      success[i] = sample.has_value();
+      if (sample) {
+        position.z = sample->height;
+      }
+    }
+    batch.Complete(System::Array1<System::String>(0));
+    return;
+  }
+
+  std::vector<CesiumGeospatial::Cartographic> cartographicPositions;
+  cartographicPositions.reserve(positions.size());
+  for (const Unity::Mathematics::double3& position : positions) {
+    cartographicPositions.emplace_back(
+        CesiumGeospatial::Cartographic::fromDegrees(
+            position.x,
+            position.y,
+            position.z));
+  }
+
+  // The arrays are only written on the main thread, after checking that the
+  // batch has not been cancelled, because they may be disposed once it is.
+  this->_pTileset->sampleHeightMostDetailed(cartographicPositions)
+      .thenInMainThread(
+          [longitudeLatitudeHeightPositions, sampleSuccess, batch](
+              Cesium3DTilesSelection::SampleHeightResult&& result) {
+            if (!batch.TryStartCompleting()) {
+              return;
+            }
+
+            std::span<Unity::Mathematics::double3> positions =
+                NativeArrayUtility::asSpan(longitudeLatitudeHeightPositions);
+            std::span<bool> success = NativeArrayUtility::asSpan(sampleSuccess);
+            const size_t count = std::min(
+                {positions.size(),
+                 result.positions.size(),
+                 result.sampleSuccess.size()});
+            for (size_t i = 0; i < count; ++i) {
+              success[i] = result.sampleSuccess[i];
+              if (result.sampleSuccess[i]) {
+                positions[i].z = result.positions[i].height;
+              }
+            }
+
+            System::Array1<System::String> warnings(result.warnings.size());
+            for (size_t i = 0; i < result.warnings.size(); ++i) {
+              warnings.Item(i, System::String(result.warnings[i]));
+            }
+            batch.Complete(warnings);
+          })
+      .catchInMainThread([batch](std::exception&& exception) {
+        if (batch.TryStartCompleting()) {
+          batch.Fail(System::String(exception.what()));
+        }
+      });
+}
+
 Tileset* Cesium3DTilesetImpl::getTileset() { return this->_pTileset.get(); }
 
 const Tileset* Cesium3DTilesetImpl::getTileset() const {
@@ -545,12 +1177,13 @@ void Cesium3DTilesetImpl::updateLastViewUpdateResultState(
       currentResult.tilesVisited != previousResult.tilesVisited ||
       currentResult.culledTilesVisited != previousResult.culledTilesVisited ||
       currentResult.tilesCulled != previousResult.tilesCulled ||
-      currentResult.maxDepthVisited != previousResult.maxDepthVisited) {
+      currentResult.maxDepthVisited != previousResult.maxDepthVisited ||
+      this->_visibilityChangesThisFrame != this->_lastVisibilityChanges) {
     SPDLOG_LOGGER_INFO(
         this->_pTileset->getExternals().pLogger,
         "{0}: Visited {1}, Culled Visited {2}, Rendered {3}, Culled {4}, Max "
         "Depth Visited {5}, Loading-Worker {6}, Loading-Main {7} "
-        "Total Tiles Resident {8}, Frame {9}",
+        "Total Tiles Resident {8}, Visibility Changes {9}, Frame {10}",
         tileset.gameObject().name().ToStlString(),
         currentResult.tilesVisited,
         currentResult.culledTilesVisited,
@@ -560,10 +1193,12 @@ void Cesium3DTilesetImpl::updateLastViewUpdateResultState(
         currentResult.workerThreadTileLoadQueueLength,
         currentResult.mainThreadTileLoadQueueLength,
         this->_pTileset->getNumberOfTilesLoaded(),
+        this->_visibilityChangesThisFrame,
         currentResult.frameNumber);
   }
 
   this->_lastUpdateResult = currentResult;
+  this->_lastVisibilityChanges = this->_visibilityChangesThisFrame;
 }
 
 void Cesium3DTilesetImpl::DestroyTileset(
@@ -576,7 +1211,18 @@ void Cesium3DTilesetImpl::DestroyTileset(
     overlay.RemoveFromTileset();
   }
 
+  // The prediction, planned, and warm start view groups must be unregistered
+  // before their tileset is destroyed.
+  this->_pPredictionViewGroup.reset();
+  this->_plannedViewGroups.clear();
+  this->_cameraMotionPredictor.reset();
+  if (this->_pWarmStart) {
+    this->_pWarmStart->save();
+    this->_pWarmStart.reset();
+  }
+
   this->_pTileset.reset();
+  TileLoadScheduler::getInstance().removeTileset(this);
 
   this->_destroyTilesetOnNextUpdate = false;
 }
@@ -642,22 +1288,35 @@ getSupportedGpuCompressedPixelFormats() {
 }
 } // namespace
 
+/*static*/ Cesium3DTilesetImpl::StructuralOptions
+Cesium3DTilesetImpl::getStructuralOptions(
+    const DotNet::CesiumForUnity::Cesium3DTileset& tileset) {
+  StructuralOptions result{};
+  result.tilesetSource = int32_t(tileset.tilesetSource());
+  result.url = tileset.url().ToStlString();
+  result.ionAssetID = tileset.ionAssetID();
+  result.ionAccessToken = tileset.ionAccessToken().ToStlString();
+  result.ionServerUrl = tileset.ionServer().apiUrl().ToStlString();
+  if (tileset.opaqueMaterial() != nullptr) {
+    result.opaqueMaterialHash = tileset.opaqueMaterial().ComputeCRC();
+  }
+  result.generateSmoothNormals = tileset.generateSmoothNormals();
+  result.ignoreKhrMaterialsUnlit = tileset.ignoreKhrMaterialsUnlit();
+  result.shareMaterials = tileset.shareMaterials();
+  result.useRasterOverlayAtlas = tileset.useRasterOverlayAtlas();
+  result.compositeRasterOverlays = tileset.compositeRasterOverlays();
+  result.showTilesInHierarchy = tileset.showTilesInHierarchy();
+  result.createPhysicsMeshes = tileset.createPhysicsMeshes();
+  result.warmStart = tileset.warmStart();
+  result.enableOcclusionCulling = tileset.enableOcclusionCulling();
+  return result;
+}
+
 void Cesium3DTilesetImpl::LoadTileset(
     const DotNet::CesiumForUnity::Cesium3DTileset& tileset) {
   TilesetOptions options{};
   options.rendererOptions = std::make_any<CreateModelOptions>(tileset);
-  options.maximumScreenSpaceError = tileset.maximumScreenSpaceError();
-  options.preloadAncestors = tileset.preloadAncestors();
-  options.preloadSiblings = tileset.preloadSiblings();
-  options.forbidHoles = tileset.forbidHoles();
-  options.maximumSimultaneousTileLoads = tileset.maximumSimultaneousTileLoads();
-  options.maximumCachedBytes = tileset.maximumCachedBytes();
-  options.loadingDescendantLimit = tileset.loadingDescendantLimit();
-  options.enableFrustumCulling = tileset.enableFrustumCulling();
-  options.enableFogCulling = tileset.enableFogCulling();
-  options.enforceCulledScreenSpaceError =
-      tileset.enforceCulledScreenSpaceError();
-  options.culledScreenSpaceError = tileset.culledScreenSpaceError();
+  setLiveOptions(tileset, options);
   // options.enableLodTransitionPeriod = tileset.useLodTransitions();
   // options.lodTransitionLength = tileset.lodTransitionLength();
   options.showCreditsOnScreen = tileset.showCreditsOnScreen();
@@ -674,7 +1333,8 @@ void Cesium3DTilesetImpl::LoadTileset(
             unityDetails);
       };
 
-  // Generous per-frame time limits for loading / unloading on main thread.
+  // Initial per-frame time limits for loading / unloading on main thread.
+  // MainThreadBudget replaces them before every update.
   options.mainThreadLoadingTimeLimit = 5.0;
   options.tileCacheUnloadTimeLimit = 5.0;
 
@@ -708,6 +1368,29 @@ void Cesium3DTilesetImpl::LoadTileset(
   this->setCameraManager(cameraManager);
 
   this->_lastUpdateResult = ViewUpdateResult();
+  this->_visibilityChangesThisFrame = 0;
+  this->_lastVisibilityChanges = 0;
+  this->_predictedTilesLoaded = 0;
+  this->_predictedTilesShown = 0;
+  this->SetRecordFrameStats(tileset, tileset.recordFrameStats());
+  this->_structuralOptions = getStructuralOptions(tileset);
+
+  // Occlusion culling is done on the CPU, against the tiles rendered in the
+  // previous frame. Waiting for occlusion results would only delay loads.
+  options.enableOcclusionCulling = tileset.enableOcclusionCulling();
+  options.delayRefinementForOcclusion = false;
+  auto createExternals = [&tileset, &options]() {
+    TilesetExternals externals = createTilesetExternals(tileset);
+    if (options.enableOcclusionCulling) {
+      externals.pTileOcclusionProxyPool =
+          std::make_shared<SoftwareOcclusionProxyPool>(options.ellipsoid);
+    }
+    return externals;
+  };
+
+  // Identifies the tileset's snapshot for warm start. Tilesets generated from
+  // an ellipsoid have nothing to load, so they have no snapshot.
+  std::string snapshotKey;
 
   if (tileset.tilesetSource() ==
       CesiumForUnity::CesiumDataSource::FromCesiumIon) {
@@ -725,11 +1408,15 @@ void Cesium3DTilesetImpl::LoadTileset(
         ionAssetEndpointUrl += '/';
 
       this->_pTileset = std::make_unique<Tileset>(
-          createTilesetExternals(tileset),
+          createExternals(),
           tileset.ionAssetID(),
           ionAccessToken.ToStlString(),
           options,
           ionAssetEndpointUrl);
+      snapshotKey = fmt::format(
+          "{}v1/assets/{}",
+          ionAssetEndpointUrl,
+          tileset.ionAssetID());
     } else {
       // Resolve the API URL if it's not already in progress.
       resolveCesiumIonApiUrl(tileset.ionServer());
@@ -738,15 +1425,25 @@ void Cesium3DTilesetImpl::LoadTileset(
       tileset.tilesetSource() ==
       CesiumForUnity::CesiumDataSource::FromEllipsoid) {
     this->_pTileset = EllipsoidTilesetLoader::createTileset(
-        createTilesetExternals(tileset),
+        createExternals(),
         options);
   } else {
+    snapshotKey = tileset.url().ToStlString();
     this->_pTileset = std::make_unique<Tileset>(
-        createTilesetExternals(tileset),
-        tileset.url().ToStlString(),
+        createExternals(),
+        snapshotKey,
         options);
   }
 
+  if (this->_pTileset && tileset.warmStart() && !snapshotKey.empty()) {
+    this->_pWarmStart = std::make_unique<TilesetWarmStart>(
+        *this->_pTileset,
+        TilesetWarmStart::getSnapshotPath(
+            UnityEngine::Application::temporaryCachePath().ToStlString(),
+            snapshotKey),
+        DotNet::UnityEngine::Time::realtimeSinceStartupAsDouble());
+  }
+
   // Add any overlay components.
   System::Array1<CesiumForUnity::CesiumRasterOverlay> overlays =
       tileset.gameObject().GetComponents<CesiumForUnity::CesiumRasterOverlay>();
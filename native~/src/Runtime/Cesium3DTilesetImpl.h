@@ -1,17 +1,24 @@
 #pragma once
 
+#include "CameraMotionPredictor.h"
 #include "CesiumImpl.h"
 
 #include <Cesium3DTilesSelection/ViewUpdateResult.h>
 
+#include <DotNet/CesiumForUnity/Cesium3DTilesetFrameStats.h>
 #include <DotNet/CesiumForUnity/CesiumCameraManager.h>
 #include <DotNet/CesiumForUnity/CesiumCreditSystem.h>
 #include <DotNet/CesiumForUnity/CesiumGeoreference.h>
+#include <DotNet/CesiumForUnity/CesiumTerrainHeightSample.h>
 #include <DotNet/System/Action.h>
 #include <DotNet/System/Array1.h>
 #include <DotNet/System/Threading/Tasks/Task1.h>
+#include <DotNet/Unity/Collections/NativeArray1.h>
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 #if UNITY_EDITOR
 #include <DotNet/UnityEditor/CallbackFunction.h>
@@ -20,19 +27,31 @@
 namespace DotNet::CesiumForUnity {
 class Cesium3DTileset;
 class CesiumRasterOverlay;
+class CesiumSampleHeightBatch;
 class CesiumSampleHeightResult;
 } // namespace DotNet::CesiumForUnity
 
+namespace DotNet::System {
+class String;
+}
+
 namespace DotNet::Unity::Mathematics {
 struct double3;
 }
 
 namespace Cesium3DTilesSelection {
+class Tile;
 class Tileset;
-}
+class TilesetViewGroup;
+class ViewState;
+} // namespace Cesium3DTilesSelection
 
 namespace CesiumForUnityNative {
 
+class CameraPathPlayer;
+class CameraPathRecorder;
+class TilesetWarmStart;
+
 class Cesium3DTilesetImpl : public CesiumImpl<Cesium3DTilesetImpl> {
 public:
   Cesium3DTilesetImpl(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
@@ -41,6 +60,9 @@ public:
   void SetShowCreditsOnScreen(
       const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
       bool value);
+  void SetRecordFrameStats(
+      const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+      bool value);
   void Start(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
   void Update(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
   void UpdateInternal(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
@@ -52,10 +74,15 @@ public:
   void FocusTileset(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
   void UpdateOverlayMaterialKeys(
       const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
+  void
+  UpdateTilesetOptions(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
 
   float
   ComputeLoadProgress(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
 
+  int64_t GetRenderResourceBytes(
+      const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
+
   DotNet::System::Threading::Tasks::Task1<
       DotNet::CesiumForUnity::CesiumSampleHeightResult>
   SampleHeightMostDetailed(
@@ -63,6 +90,34 @@ public:
       const DotNet::System::Array1<DotNet::Unity::Mathematics::double3>&
           longitudeLatitudeHeightPositions);
 
+  void SampleHeightsNative(
+      const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+      const DotNet::Unity::Collections::NativeArray1<
+          DotNet::Unity::Mathematics::double3>&
+          longitudeLatitudeHeightPositions,
+      const DotNet::Unity::Collections::NativeArray1<bool>& sampleSuccess,
+      bool loadedTilesOnly,
+      const DotNet::CesiumForUnity::CesiumSampleHeightBatch& batch);
+
+  DotNet::CesiumForUnity::CesiumTerrainHeightSample SampleHeightCached(
+      const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+      double longitude,
+      double latitude);
+
+  int32_t GetFrameStats(
+      const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+      const DotNet::Unity::Collections::NativeArray1<
+          DotNet::CesiumForUnity::Cesium3DTilesetFrameStats>& stats);
+
+  bool StartCameraPathRecording(
+      const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+      const DotNet::System::String& path);
+  bool StartCameraPathReplay(
+      const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+      const DotNet::System::String& path,
+      bool loop);
+  void StopCameraPath(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
+
   Cesium3DTilesSelection::Tileset* getTileset();
   const Cesium3DTilesSelection::Tileset* getTileset() const;
 
@@ -81,11 +136,46 @@ public:
   void setCreditSystem(
       const DotNet::CesiumForUnity::CesiumCreditSystem& creditSystem);
 
+  /**
+   * Gets the number of tile game objects that were shown or hidden in the most
+   * recent update.
+   */
+  int32_t getVisibilityChangesThisFrame() const {
+    return this->_visibilityChangesThisFrame;
+  }
+
   const DotNet::CesiumForUnity::CesiumCameraManager& getCameraManager() const;
   void setCameraManager(
       const DotNet::CesiumForUnity::CesiumCameraManager& cameraManager);
 
 private:
+  /**
+   * @brief The options of a tileset that are baked into its loaded tiles, so
+   * that changing any of them requires the tileset to be recreated.
+   */
+  struct StructuralOptions {
+    int32_t tilesetSource;
+    std::string url;
+    int64_t ionAssetID;
+    std::string ionAccessToken;
+    std::string ionServerUrl;
+    int32_t opaqueMaterialHash;
+    bool generateSmoothNormals;
+    bool ignoreKhrMaterialsUnlit;
+    bool shareMaterials;
+    bool useRasterOverlayAtlas;
+    bool compositeRasterOverlays;
+    bool showTilesInHierarchy;
+    bool createPhysicsMeshes;
+    bool warmStart;
+    bool enableOcclusionCulling;
+
+    bool operator==(const StructuralOptions& rhs) const = default;
+  };
+
+  static StructuralOptions
+  getStructuralOptions(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
+
   void updateOverlayMaterialKeys(
       const DotNet::System::Array1<DotNet::CesiumForUnity::CesiumRasterOverlay>&
           overlays);
@@ -94,15 +184,56 @@ private:
   void updateLastViewUpdateResultState(
       const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
       const Cesium3DTilesSelection::ViewUpdateResult& currentResult);
+  void
+  setTileVisibility(const Cesium3DTilesSelection::Tile& tile, bool visible);
+  void applyTileVisibilityChanges();
+  const Cesium3DTilesSelection::ViewUpdateResult* updatePredictionViewGroup(
+      double lookAheadTime,
+      const std::vector<Cesium3DTilesSelection::ViewState>& viewStates);
+  void markPredictedTiles(
+      const Cesium3DTilesSelection::ViewUpdateResult& predictionResult);
+  size_t updatePlannedViewGroups(
+      const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
+  DotNet::CesiumForUnity::Cesium3DTilesetFrameStats& addFrameStats();
+
+  // The number of updates kept by the frame stats ring buffer.
+  static constexpr size_t frameStatsCapacity = 256;
 
   std::unique_ptr<Cesium3DTilesSelection::Tileset> _pTileset;
   Cesium3DTilesSelection::ViewUpdateResult _lastUpdateResult;
+  int32_t _visibilityChangesThisFrame;
+  int32_t _lastVisibilityChanges;
+  std::vector<uint64_t> _gameObjectsToHide;
+  std::vector<uint64_t> _gameObjectsToShow;
+  bool _recordFrameStats;
+  std::vector<DotNet::CesiumForUnity::Cesium3DTilesetFrameStats> _frameStats;
+  size_t _nextFrameStatsIndex;
+  // Selects the tiles for the cameras' predicted views, which are loaded but
+  // never rendered. Only exists while predictive loading is enabled.
+  std::unique_ptr<Cesium3DTilesSelection::TilesetViewGroup>
+      _pPredictionViewGroup;
+  CameraMotionPredictor _cameraMotionPredictor;
+  // One view group for each of the next few views of the camera plans, such
+  // as flights, in order of arrival.
+  std::vector<std::unique_ptr<Cesium3DTilesSelection::TilesetViewGroup>>
+      _plannedViewGroups;
+  int64_t _predictedTilesLoaded;
+  int64_t _predictedTilesShown;
+  // At most one of these exists at a time. They are kept when the tileset is
+  // recreated, so that a recording or replay spans the whole session.
+  std::unique_ptr<CameraPathRecorder> _pCameraPathRecorder;
+  std::unique_ptr<CameraPathPlayer> _pCameraPathPlayer;
+  // Saves the tileset's views, and restores the tiles for those of the
+  // previous session. Only exists while warm start is enabled.
+  std::unique_ptr<TilesetWarmStart> _pWarmStart;
 #if UNITY_EDITOR
   DotNet::UnityEditor::CallbackFunction _updateInEditorCallback;
 #endif
   DotNet::CesiumForUnity::CesiumCreditSystem _creditSystem;
   DotNet::CesiumForUnity::CesiumCameraManager _cameraManager;
   bool _destroyTilesetOnNextUpdate;
+  // The structural options that the current tileset was created with.
+  StructuralOptions _structuralOptions;
   int32_t _lastOpaqueMaterialHash;
 };
 
@@ -0,0 +1,86 @@
+#include "CesiumFlightPathPrefetchImpl.h"
+
+#include "CameraManager.h"
+#include "CesiumEllipsoidImpl.h"
+
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGeospatial/GlobeTransforms.h>
+
+#include <DotNet/CesiumForUnity/CesiumEllipsoid.h>
+#include <DotNet/CesiumForUnity/CesiumGeoreference.h>
+#include <DotNet/System/Array1.h>
+#include <DotNet/Unity/Mathematics/double3.h>
+#include <DotNet/UnityEngine/Camera.h>
+#include <glm/geometric.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <vector>
+
+using namespace CesiumGeospatial;
+using namespace DotNet;
+using namespace DotNet::Unity::Mathematics;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+glm::dvec3 toGlm(const double3& value) {
+  return glm::dvec3(value.x, value.y, value.z);
+}
+
+// Converts a direction in the East-Up-North frame, which Unity's axes follow,
+// into ECEF.
+glm::dvec3 eastUpNorthToEcef(const glm::dmat4& enuToEcef, const double3& v) {
+  return glm::normalize(
+      glm::dvec3(enuToEcef[0]) * v.x + glm::dvec3(enuToEcef[2]) * v.y +
+      glm::dvec3(enuToEcef[1]) * v.z);
+}
+
+} // namespace
+
+/*static*/ void CesiumFlightPathPrefetchImpl::SetPath(
+    int32_t pathID,
+    const CesiumForUnity::CesiumGeoreference& georeference,
+    const UnityEngine::Camera& camera,
+    const System::Array1<double3>& positions,
+    const System::Array1<double3>& directions,
+    const System::Array1<double3>& ups,
+    const System::Array1<double>& arrivalTimes) {
+  const int32_t length = positions.Length();
+  if (georeference == nullptr || directions.Length() != length ||
+      ups.Length() != length || arrivalTimes.Length() != length) {
+    CameraManager::clearCameraPlan(uint64_t(pathID));
+    return;
+  }
+
+  const Ellipsoid& ellipsoid =
+      georeference.ellipsoid().NativeImplementation().GetEllipsoid();
+
+  std::vector<CameraPose> poses;
+  std::vector<double> times;
+  poses.reserve(size_t(length));
+  times.reserve(size_t(length));
+
+  for (int32_t i = 0; i < length; ++i) {
+    glm::dvec3 position = toGlm(positions[i]);
+    glm::dmat4 enuToEcef =
+        GlobeTransforms::eastNorthUpToFixedFrame(position, ellipsoid);
+    poses.emplace_back(CameraPose{
+        position,
+        eastUpNorthToEcef(enuToEcef, directions[i]),
+        eastUpNorthToEcef(enuToEcef, ups[i])});
+    times.emplace_back(arrivalTimes[i]);
+  }
+
+  CameraManager::setCameraPlan(
+      uint64_t(pathID),
+      camera,
+      std::move(poses),
+      std::move(times));
+}
+
+/*static*/ void CesiumFlightPathPrefetchImpl::ClearPath(int32_t pathID) {
+  CameraManager::clearCameraPlan(uint64_t(pathID));
+}
+
+} // namespace CesiumForUnityNative
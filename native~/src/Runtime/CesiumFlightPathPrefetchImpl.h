@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace DotNet::CesiumForUnity {
+class CesiumGeoreference;
+}
+
+namespace DotNet::System {
+template <typename T> class Array1;
+}
+
+namespace DotNet::Unity::Mathematics {
+struct double3;
+}
+
+namespace DotNet::UnityEngine {
+class Camera;
+}
+
+namespace CesiumForUnityNative {
+
+class CesiumFlightPathPrefetchImpl {
+public:
+  static void SetPath(
+      int32_t pathID,
+      const DotNet::CesiumForUnity::CesiumGeoreference& georeference,
+      const DotNet::UnityEngine::Camera& camera,
+      const DotNet::System::Array1<DotNet::Unity::Mathematics::double3>&
+          positions,
+      const DotNet::System::Array1<DotNet::Unity::Mathematics::double3>&
+          directions,
+      const DotNet::System::Array1<DotNet::Unity::Mathematics::double3>& ups,
+      const DotNet::System::Array1<double>& arrivalTimes);
+  static void ClearPath(int32_t pathID);
+};
+
+} // namespace CesiumForUnityNative
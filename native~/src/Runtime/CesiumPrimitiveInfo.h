@@ -0,0 +1,58 @@
+#pragma once
+
+#include <CesiumGltf/MeshPrimitive.h>
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Information about how a given glTF primitive was converted into
+ * Unity MeshData.
+ */
+struct CesiumPrimitiveInfo {
+  /**
+   * @brief The mode of the glTF primitive.
+   */
+  int32_t mode = CesiumGltf::MeshPrimitive::Mode::TRIANGLES;
+
+  /**
+   * @brief Whether or not the primitive contains translucent vertex
+   * colors. This can affect material tags used to render the model.
+   */
+  bool isTranslucent = false;
+
+  /**
+   * @brief Whether or not the primitive material has the KHR_materials_unlit
+   * extension.
+   * @remarks This may be overridden if
+   * DotNet::CesiumForUnity::Cesium3DTileset::ignoreignoreKHRMaterialsUnlit() is
+   * set.
+   */
+  bool isUnlit = false;
+
+  /**
+   * @brief Maps a texture coordinate index i (TEXCOORD_<i>) to the
+   * corresponding Unity texture coordinate index.
+   */
+  std::unordered_map<uint32_t, uint32_t> uvIndexMap{};
+
+  /**
+   * @brief Maps an overlay texture coordinate index i (_CESIUMOVERLAY_<i>) to
+   * the corresponding Unity texture coordinate index.
+   */
+  std::unordered_map<uint32_t, uint32_t> rasterOverlayUvIndexMap{};
+
+  /**
+   * @brief The size of the Unity mesh's vertex and index buffers, in bytes.
+   */
+  int64_t meshBytes = 0;
+
+  /**
+   * @brief The number of indices in the Unity mesh.
+   */
+  int32_t indexCount = 0;
+};
+
+} // namespace CesiumForUnityNative
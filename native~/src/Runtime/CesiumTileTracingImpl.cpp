@@ -0,0 +1,24 @@
+#include "CesiumTileTracingImpl.h"
+
+#include "TileLifecycleTracer.h"
+
+#include <DotNet/System/String.h>
+
+namespace CesiumForUnityNative {
+
+/*static*/ bool
+CesiumTileTracingImpl::WriteTrace(const DotNet::System::String& path) {
+  return TileLifecycleTracer::write(path.ToStlString());
+}
+
+/*static*/ void CesiumTileTracingImpl::Clear() { TileLifecycleTracer::clear(); }
+
+/*static*/ bool CesiumTileTracingImpl::GetEnabled() {
+  return TileLifecycleTracer::isEnabled();
+}
+
+/*static*/ void CesiumTileTracingImpl::SetEnabled(bool value) {
+  TileLifecycleTracer::setEnabled(value);
+}
+
+} // namespace CesiumForUnityNative
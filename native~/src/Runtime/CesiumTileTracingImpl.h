@@ -0,0 +1,17 @@
+#pragma once
+
+namespace DotNet::System {
+class String;
+}
+
+namespace CesiumForUnityNative {
+
+class CesiumTileTracingImpl {
+public:
+  static bool WriteTrace(const DotNet::System::String& path);
+  static void Clear();
+  static bool GetEnabled();
+  static void SetEnabled(bool value);
+};
+
+} // namespace CesiumForUnityNative
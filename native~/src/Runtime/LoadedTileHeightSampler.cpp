@@ -0,0 +1,147 @@
+#include "LoadedTileHeightSampler.h"
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/Tileset.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeometry/Ray.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGltfContent/GltfUtilities.h>
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltfContent;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// The height above the ellipsoid that rays are cast down from. It must be
+// above the highest geometry of any tileset.
+constexpr double rayOriginHeight = 100000.0;
+
+struct Hit {
+  double distanceSquared;
+  glm::dvec3 position;
+  const Tile* pTile;
+};
+
+// Determines whether a ray passes through a box, including when it starts
+// inside it.
+bool rayIntersectsBox(const Ray& ray, const OrientedBoundingBox& box) {
+  // In the box's own coordinates it spans -1 to 1 on each axis.
+  const glm::dmat3& inverseHalfAxes = box.getInverseHalfAxes();
+  const glm::dvec3 origin =
+      inverseHalfAxes * (ray.getOrigin() - box.getCenter());
+  const glm::dvec3 direction = inverseHalfAxes * ray.getDirection();
+
+  double tMinimum = 0.0;
+  double tMaximum = std::numeric_limits<double>::max();
+  for (glm::length_t i = 0; i < 3; ++i) {
+    if (direction[i] == 0.0) {
+      if (glm::abs(origin[i]) > 1.0) {
+        return false;
+      }
+      continue;
+    }
+
+    double t0 = (-1.0 - origin[i]) / direction[i];
+    double t1 = (1.0 - origin[i]) / direction[i];
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+    tMinimum = std::max(tMinimum, t0);
+    tMaximum = std::min(tMaximum, t1);
+    if (tMinimum > tMaximum) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::optional<Hit>
+sampleTile(const Tile& tile, const Ray& ray, const Ellipsoid& ellipsoid) {
+  const OrientedBoundingBox box = getOrientedBoundingBoxFromBoundingVolume(
+      tile.getBoundingVolume(),
+      ellipsoid);
+  if (!rayIntersectsBox(ray, box)) {
+    return std::nullopt;
+  }
+
+  std::optional<Hit> closest;
+  for (const Tile& child : tile.getChildren()) {
+    std::optional<Hit> hit = sampleTile(child, ray, ellipsoid);
+    if (hit && (!closest || hit->distanceSquared < closest->distanceSquared)) {
+      closest = hit;
+    }
+  }
+
+  // Children that replace this tile are more detailed than it. Children that
+  // add to it are tested along with it, and the highest surface wins.
+  if (closest && tile.getRefine() == TileRefine::Replace) {
+    return closest;
+  }
+
+  const TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+  if (tile.getState() != TileLoadState::Done || !pRenderContent) {
+    return closest;
+  }
+
+  GltfUtilities::IntersectResult result = GltfUtilities::intersectRayGltfModel(
+      ray,
+      pRenderContent->getModel(),
+      true,
+      tile.getTransform());
+  if (result.hit && (!closest || result.hit->rayToWorldPointDistanceSq <
+                                     closest->distanceSquared)) {
+    closest = Hit{
+        result.hit->rayToWorldPointDistanceSq,
+        result.hit->worldPoint,
+        &tile};
+  }
+
+  return closest;
+}
+
+} // namespace
+
+/*static*/ std::optional<LoadedTileHeightSample>
+LoadedTileHeightSampler::sampleHeight(
+    const Tileset& tileset,
+    const Cartographic& position) {
+  const Tile* pRootTile = tileset.getRootTile();
+  if (!pRootTile) {
+    return std::nullopt;
+  }
+
+  const Ellipsoid& ellipsoid = tileset.getOptions().ellipsoid;
+  const Ray ray(
+      ellipsoid.cartographicToCartesian(
+          Cartographic(position.longitude, position.latitude, rayOriginHeight)),
+      -ellipsoid.geodeticSurfaceNormal(position));
+
+  std::optional<Hit> hit = sampleTile(*pRootTile, ray, ellipsoid);
+  if (!hit) {
+    return std::nullopt;
+  }
+
+  std::optional<Cartographic> hitPosition =
+      ellipsoid.cartesianToCartographic(hit->position);
+  if (!hitPosition) {
+    return std::nullopt;
+  }
+
+  return LoadedTileHeightSample{hitPosition->height, hit->pTile};
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <optional>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+class Tileset;
+} // namespace Cesium3DTilesSelection
+
+namespace CesiumGeospatial {
+class Cartographic;
+}
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief A height sampled from the tiles of a tileset.
+ */
+struct LoadedTileHeightSample {
+  /**
+   * @brief The height above the ellipsoid, in meters.
+   */
+  double height;
+
+  /**
+   * @brief The tile whose content was sampled.
+   */
+  const Cesium3DTilesSelection::Tile* pTile;
+};
+
+/**
+ * @brief Samples the heights of a tileset from the tiles that are already
+ * loaded, without loading any more.
+ *
+ * Unlike `Tileset::sampleHeightMostDetailed`, this completes immediately, so
+ * it can be used every frame. The height at a position comes from the most
+ * detailed loaded tile there, so it may be coarser than the most detailed
+ * height available, and is missing where no tile has been loaded at all.
+ *
+ * This must only be used from the main thread.
+ */
+class LoadedTileHeightSampler {
+public:
+  /**
+   * @brief Samples the height of a tileset at a position.
+   *
+   * @param tileset The tileset.
+   * @param position The position. Its height is ignored.
+   * @return The sampled height, or nothing if no loaded tile has geometry
+   * at the position.
+   */
+  static std::optional<LoadedTileHeightSample> sampleHeight(
+      const Cesium3DTilesSelection::Tileset& tileset,
+      const CesiumGeospatial::Cartographic& position);
+};
+
+} // namespace CesiumForUnityNative
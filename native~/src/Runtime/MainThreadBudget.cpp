@@ -0,0 +1,127 @@
+#include "MainThreadBudget.h"
+
+#include <DotNet/CesiumForUnity/CesiumMainThreadBudget.h>
+#include <DotNet/CesiumForUnity/CesiumMainThreadBudgetDecision.h>
+#include <DotNet/CesiumForUnity/CesiumRuntimeSettings.h>
+#include <DotNet/UnityEngine/Time.h>
+
+#include <algorithm>
+
+using namespace DotNet;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// The fixed limits used when the adaptive budget is disabled, and the initial
+// budget when it is enabled.
+constexpr double defaultTimeLimit = 5.0;
+
+// The budget never drops below this, so that tiles continue to load even when
+// the application is far slower than its target.
+constexpr double minimumTotalBudget = 1.0;
+
+// The fraction of the target frame time that tilesets may spend on the main
+// thread in total.
+constexpr double maximumFrameFraction = 0.5;
+
+// A frame is late if it takes longer than the target by more than this
+// fraction, which leaves room for timer jitter and vsync.
+constexpr double lateFrameTolerance = 0.1;
+
+// The budget grows by this fraction of the target frame time per frame that is
+// on time, and is multiplied by the decay factor for each frame that is late.
+constexpr double growthFraction = 0.02;
+constexpr double lateFrameDecay = 0.75;
+
+// The share of the budget given to loading. The remainder is for unloading,
+// which is usually much cheaper.
+constexpr double loadingShare = 0.75;
+
+} // namespace
+
+/*static*/ MainThreadBudget& MainThreadBudget::getInstance() {
+  static MainThreadBudget instance;
+  return instance;
+}
+
+MainThreadBudget::MainThreadBudget()
+    : _tick(0),
+      _frameStart(),
+      _totalBudget(2.0 * defaultTimeLimit),
+      _limits{defaultTimeLimit, defaultTimeLimit},
+      _fixedTime(0.0),
+      _budgetedTime(0.0),
+      _tilesetCount(0) {}
+
+MainThreadBudget::Limits MainThreadBudget::beginTilesetUpdate(uint64_t tick) {
+  if (!CesiumForUnity::CesiumRuntimeSettings::adaptiveMainThreadBudget()) {
+    return Limits{defaultTimeLimit, defaultTimeLimit};
+  }
+
+  if (tick != this->_tick) {
+    this->beginFrame(tick);
+  }
+
+  return this->_limits;
+}
+
+void MainThreadBudget::endTilesetUpdate(double fixedTime, double budgetedTime) {
+  this->_fixedTime += fixedTime;
+  this->_budgetedTime += budgetedTime;
+  ++this->_tilesetCount;
+}
+
+void MainThreadBudget::beginFrame(uint64_t tick) {
+  const double targetFrameTime =
+      1000.0 / CesiumForUnity::CesiumMainThreadBudget::GetTargetFrameRate();
+
+  // Time.unscaledDeltaTime does not advance between Editor updates outside
+  // Play mode, so the frame time is measured here instead.
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point frameStart = Clock::now();
+  const double previousFrameTime =
+      this->_frameStart
+          ? std::chrono::duration<double, std::milli>(
+                frameStart - *this->_frameStart)
+                .count()
+          : targetFrameTime;
+
+  if (previousFrameTime > targetFrameTime * (1.0 + lateFrameTolerance)) {
+    this->_totalBudget *= lateFrameDecay;
+  } else {
+    this->_totalBudget += targetFrameTime * growthFraction;
+  }
+
+  // Work outside the budget still counts against the time tilesets may take.
+  const double maximumTotalBudget = std::max(
+      minimumTotalBudget,
+      targetFrameTime * maximumFrameFraction - this->_fixedTime);
+  this->_totalBudget =
+      std::clamp(this->_totalBudget, minimumTotalBudget, maximumTotalBudget);
+
+  const int32_t tilesetCount = std::max(this->_tilesetCount, 1);
+  const double tilesetBudget = this->_totalBudget / double(tilesetCount);
+  this->_limits.loadingTimeLimit = tilesetBudget * loadingShare;
+  this->_limits.unloadingTimeLimit = tilesetBudget * (1.0 - loadingShare);
+
+  CesiumForUnity::CesiumMainThreadBudget::RecordDecision(
+      CesiumForUnity::CesiumMainThreadBudgetDecision::Construct(
+          UnityEngine::Time::frameCount(),
+          targetFrameTime,
+          previousFrameTime,
+          this->_fixedTime,
+          this->_budgetedTime,
+          this->_totalBudget,
+          this->_limits.loadingTimeLimit,
+          this->_limits.unloadingTimeLimit,
+          tilesetCount));
+
+  this->_tick = tick;
+  this->_frameStart = frameStart;
+  this->_fixedTime = 0.0;
+  this->_budgetedTime = 0.0;
+  this->_tilesetCount = 0;
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Adapts the main thread time that tilesets may spend loading and
+ * unloading tiles to the application's frame rate.
+ *
+ * Every tileset reports the main thread time it spends in each update, split
+ * into the time spent in `Tileset::loadTiles`, which is limited by the budget,
+ * and everything else, which is not. On the first update of each frame, the
+ * controller compares the time since the previous frame began to the target
+ * frame time:
+ * the budget grows slowly while frames are on time and shrinks quickly when
+ * they are late. The time tilesets spent on work outside the budget is
+ * subtracted from the maximum, and the rest is divided evenly between the
+ * tilesets that updated in the previous frame.
+ *
+ * This must only be used from the main thread.
+ */
+class MainThreadBudget {
+public:
+  /**
+   * @brief The time limits for a single tileset update, in milliseconds.
+   */
+  struct Limits {
+    double loadingTimeLimit;
+    double unloadingTimeLimit;
+  };
+
+  /**
+   * @brief Gets the controller shared by all tilesets.
+   */
+  static MainThreadBudget& getInstance();
+
+  /**
+   * @brief Gets the limits for a tileset that is about to update, starting a
+   * new frame if this is the first update of a new tick.
+   *
+   * @param tick The {@link TilesetUpdateTick} of the update. In the Editor
+   * outside Play mode, this changes even when the frame count does not.
+   */
+  Limits beginTilesetUpdate(uint64_t tick);
+
+  /**
+   * @brief Records the main thread time a tileset spent in an update.
+   *
+   * @param fixedTime The time spent outside of `Tileset::loadTiles`, in
+   * milliseconds.
+   * @param budgetedTime The time spent in `Tileset::loadTiles`, in
+   * milliseconds.
+   */
+  void endTilesetUpdate(double fixedTime, double budgetedTime);
+
+private:
+  MainThreadBudget();
+
+  void beginFrame(uint64_t tick);
+
+  uint64_t _tick;
+  std::optional<std::chrono::steady_clock::time_point> _frameStart;
+  double _totalBudget;
+  Limits _limits;
+
+  // Accumulated over the updates of the current frame.
+  double _fixedTime;
+  double _budgetedTime;
+  int32_t _tilesetCount;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <DotNet/Unity/Collections/LowLevel/Unsafe/NativeArrayUnsafeUtility.h>
+#include <DotNet/Unity/Collections/NativeArray1.h>
+
+#include <cstddef>
+#include <span>
+
+namespace CesiumForUnityNative {
+
+class NativeArrayUtility {
+public:
+  /**
+   * @brief Gets a view of the memory owned by a `NativeArray`, so that it can
+   * be read or written directly rather than one element per interop call.
+   *
+   * The span is only valid while the array is alive. The `NativeArray<T>` and
+   * `NativeArrayUnsafeUtility.GetUnsafeBufferPointerWithoutChecks<T>` used
+   * here must be referenced in `ConfigureReinterop`.
+   */
+  template <typename T>
+  static std::span<T>
+  asSpan(const DotNet::Unity::Collections::NativeArray1<T>& array) {
+    T* pData = static_cast<T*>(
+        DotNet::Unity::Collections::LowLevel::Unsafe::NativeArrayUnsafeUtility::
+            GetUnsafeBufferPointerWithoutChecks(array));
+    return std::span<T>(pData, static_cast<size_t>(array.Length()));
+  }
+};
+
+} // namespace CesiumForUnityNative
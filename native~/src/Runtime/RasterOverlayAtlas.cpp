@@ -0,0 +1,107 @@
+#include "RasterOverlayAtlas.h"
+
+#include "UnityLifetime.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <DotNet/UnityEngine/CopyTextureSupport.h>
+#include <DotNet/UnityEngine/Experimental/Rendering/TextureCreationFlags.h>
+#include <DotNet/UnityEngine/FilterMode.h>
+#include <DotNet/UnityEngine/Graphics.h>
+#include <DotNet/UnityEngine/HideFlags.h>
+#include <DotNet/UnityEngine/SystemInfo.h>
+#include <DotNet/UnityEngine/Texture.h>
+#include <DotNet/UnityEngine/TextureWrapMode.h>
+
+using namespace DotNet;
+
+namespace CesiumForUnityNative {
+
+/*static*/ bool RasterOverlayAtlas::isSupported() {
+  const uint32_t required =
+      uint32_t(UnityEngine::CopyTextureSupport::Basic) |
+      uint32_t(UnityEngine::CopyTextureSupport::DifferentTypes);
+  return (uint32_t(UnityEngine::SystemInfo::copyTextureSupport()) &
+          required) == required;
+}
+
+std::optional<RasterOverlayAtlas::Slice>
+RasterOverlayAtlas::add(const UnityEngine::Texture& texture) {
+  CESIUM_TRACE("RasterOverlayAtlas::add");
+  if (texture == nullptr) {
+    return std::nullopt;
+  }
+
+  const Format format{
+      texture.width(),
+      texture.height(),
+      texture.graphicsFormat(),
+      texture.mipmapCount()};
+
+  uint64_t arrayID = 0;
+  Array* pArray = nullptr;
+  for (auto& [id, array] : this->_arrays) {
+    if (array.format == format && !array.freeSlices.empty()) {
+      arrayID = id;
+      pArray = &array;
+      break;
+    }
+  }
+
+  if (!pArray) {
+    UnityEngine::Texture2DArray arrayTexture(
+        format.width,
+        format.height,
+        slicesPerArray,
+        format.graphicsFormat,
+        format.mipCount > 1 ? UnityEngine::Experimental::Rendering::
+                                  TextureCreationFlags::MipChain
+                            : UnityEngine::Experimental::Rendering::
+                                  TextureCreationFlags::None,
+        format.mipCount);
+    arrayTexture.hideFlags(UnityEngine::HideFlags::HideAndDontSave);
+    arrayTexture.wrapMode(UnityEngine::TextureWrapMode::Clamp);
+    arrayTexture.filterMode(UnityEngine::FilterMode::Trilinear);
+    arrayTexture.anisoLevel(16);
+
+    // Hand out the lowest slices first.
+    std::vector<int32_t> freeSlices(slicesPerArray);
+    for (int32_t i = 0; i < slicesPerArray; ++i) {
+      freeSlices[i] = slicesPerArray - i - 1;
+    }
+
+    arrayID = this->_nextArrayID++;
+    pArray = &this->_arrays
+                  .emplace(
+                      arrayID,
+                      Array{format, arrayTexture, std::move(freeSlices)})
+                  .first->second;
+  }
+
+  int32_t index = pArray->freeSlices.back();
+  pArray->freeSlices.pop_back();
+
+  // Copies every mip on the GPU, without a round trip through CPU memory.
+  UnityEngine::Graphics::CopyTexture(texture, 0, pArray->texture, index);
+
+  return Slice{pArray->texture, index, arrayID};
+}
+
+void RasterOverlayAtlas::remove(const Slice& slice) {
+  auto it = this->_arrays.find(slice.arrayID);
+  if (it == this->_arrays.end()) {
+    return;
+  }
+
+  Array& array = it->second;
+  array.freeSlices.push_back(slice.index);
+
+  if (array.freeSlices.size() == size_t(slicesPerArray)) {
+    if (array.texture != nullptr) {
+      UnityLifetime::Destroy(array.texture);
+    }
+    this->_arrays.erase(it);
+  }
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <DotNet/UnityEngine/Experimental/Rendering/GraphicsFormat.h>
+#include <DotNet/UnityEngine/Texture2DArray.h>
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace DotNet::UnityEngine {
+class Texture;
+}
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Packs raster overlay textures of the same size and format into the
+ * slices of shared `Texture2DArray`s, so that tiles with different overlays
+ * can use the same material.
+ *
+ * Each array holds a fixed number of slices. A new array is created when all
+ * arrays of a given size and format are full, and an array is destroyed when
+ * its last slice is removed.
+ *
+ * This must only be used from the main thread.
+ */
+class RasterOverlayAtlas {
+public:
+  /**
+   * @brief The number of slices in each texture array.
+   */
+  static constexpr int32_t slicesPerArray = 32;
+
+  /**
+   * @brief A slice of a texture array holding one overlay texture.
+   */
+  struct Slice {
+    ::DotNet::UnityEngine::Texture2DArray texture;
+    int32_t index;
+    uint64_t arrayID;
+  };
+
+  /**
+   * @brief Determines whether the current platform can copy 2D textures into
+   * texture arrays on the GPU, which the atlas requires.
+   */
+  static bool isSupported();
+
+  /**
+   * @brief Copies a texture into a free slice of an array with the same size,
+   * format, and mip count.
+   *
+   * @return The slice, or `std::nullopt` if the texture could not be added.
+   */
+  std::optional<Slice> add(const ::DotNet::UnityEngine::Texture& texture);
+
+  /**
+   * @brief Frees a slice returned by {@link add}, so that it can be reused by
+   * another overlay texture.
+   */
+  void remove(const Slice& slice);
+
+private:
+  struct Format {
+    int32_t width;
+    int32_t height;
+    ::DotNet::UnityEngine::Experimental::Rendering::GraphicsFormat
+        graphicsFormat;
+    int32_t mipCount;
+
+    bool operator==(const Format& rhs) const = default;
+  };
+
+  struct Array {
+    Format format;
+    ::DotNet::UnityEngine::Texture2DArray texture;
+    std::vector<int32_t> freeSlices;
+  };
+
+  std::unordered_map<uint64_t, Array> _arrays;
+  uint64_t _nextArrayID = 0;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,130 @@
+#include "RasterOverlayCompositor.h"
+
+#include <CesiumImage/ImageDecoder.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <glm/common.hpp>
+#include <glm/vec4.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace CesiumImage;
+using namespace CesiumUtility;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+bool canComposite(const ImageAsset& image) {
+  return image.compressedPixelFormat == GpuCompressedPixelFormat::NONE &&
+         image.bytesPerChannel == 1 &&
+         (image.channels == 3 || image.channels == 4) && image.width > 0 &&
+         image.height > 0 &&
+         image.pixelData.size() >= size_t(image.width) * image.height *
+                                       image.channels;
+}
+
+glm::vec4 fetch(const ImageAsset& image, int32_t x, int32_t y) {
+  x = std::clamp(x, 0, image.width - 1);
+  y = std::clamp(y, 0, image.height - 1);
+
+  // The first mip is always at the start of the pixel data.
+  const std::byte* pPixel =
+      image.pixelData.data() +
+      (size_t(y) * image.width + size_t(x)) * image.channels;
+  return glm::vec4(
+      float(pPixel[0]),
+      float(pPixel[1]),
+      float(pPixel[2]),
+      image.channels == 4 ? float(pPixel[3]) : 255.0f);
+}
+
+glm::vec4 sampleBilinear(const ImageAsset& image, const glm::dvec2& uv) {
+  // Rows are in the same order as when the image is uploaded to Unity, so
+  // row 0 is at v = 0.
+  const double x = uv.x * image.width - 0.5;
+  const double y = uv.y * image.height - 0.5;
+  const double x0 = std::floor(x);
+  const double y0 = std::floor(y);
+  const float fx = float(x - x0);
+  const float fy = float(y - y0);
+  const int32_t ix = int32_t(x0);
+  const int32_t iy = int32_t(y0);
+
+  glm::vec4 bottom =
+      glm::mix(fetch(image, ix, iy), fetch(image, ix + 1, iy), fx);
+  glm::vec4 top =
+      glm::mix(fetch(image, ix, iy + 1), fetch(image, ix + 1, iy + 1), fx);
+  return glm::mix(bottom, top, fy) / 255.0f;
+}
+
+} // namespace
+
+/*static*/ IntrusivePointer<ImageAsset> RasterOverlayCompositor::composite(
+    const std::vector<RasterOverlayCompositeLayer>& layers) {
+  CESIUM_TRACE("RasterOverlayCompositor::composite");
+
+  std::vector<const RasterOverlayCompositeLayer*> validLayers;
+  validLayers.reserve(layers.size());
+
+  double width = 1.0;
+  double height = 1.0;
+  for (const RasterOverlayCompositeLayer& layer : layers) {
+    if (!layer.pImage || !canComposite(*layer.pImage)) {
+      continue;
+    }
+
+    validLayers.emplace_back(&layer);
+    width = std::max(width, layer.pImage->width * std::abs(layer.scale.x));
+    height = std::max(height, layer.pImage->height * std::abs(layer.scale.y));
+  }
+
+  if (validLayers.empty()) {
+    return nullptr;
+  }
+
+  IntrusivePointer<ImageAsset> pResult;
+  pResult.emplace();
+  ImageAsset& result = *pResult;
+  result.width = std::clamp(int32_t(std::ceil(width)), 1, maximumSize);
+  result.height = std::clamp(int32_t(std::ceil(height)), 1, maximumSize);
+  result.channels = 4;
+  result.bytesPerChannel = 1;
+  result.pixelData.resize(size_t(result.width) * result.height * 4);
+
+  std::byte* pWrite = result.pixelData.data();
+  for (int32_t y = 0; y < result.height; ++y) {
+    const double v = (y + 0.5) / result.height;
+    for (int32_t x = 0; x < result.width; ++x) {
+      const double u = (x + 0.5) / result.width;
+
+      // Straight-alpha "over", so that lerp(base, color, alpha) with the
+      // result matches lerping each layer in turn.
+      glm::vec3 premultiplied(0.0f);
+      float alpha = 0.0f;
+      for (const RasterOverlayCompositeLayer* pLayer : validLayers) {
+        glm::vec4 sample = sampleBilinear(
+            *pLayer->pImage,
+            glm::dvec2(u, v) * pLayer->scale + pLayer->translation);
+        premultiplied =
+            premultiplied * (1.0f - sample.a) + glm::vec3(sample) * sample.a;
+        alpha = alpha * (1.0f - sample.a) + sample.a;
+      }
+
+      glm::vec3 color =
+          alpha > 0.0f ? premultiplied / alpha : glm::vec3(0.0f);
+      pWrite[0] = std::byte(uint8_t(std::lround(color.r * 255.0f)));
+      pWrite[1] = std::byte(uint8_t(std::lround(color.g * 255.0f)));
+      pWrite[2] = std::byte(uint8_t(std::lround(color.b * 255.0f)));
+      pWrite[3] = std::byte(uint8_t(std::lround(alpha * 255.0f)));
+      pWrite += 4;
+    }
+  }
+
+  ImageDecoder::generateMipMaps(result);
+
+  return pResult;
+}
+
+} // namespace CesiumForUnityNative
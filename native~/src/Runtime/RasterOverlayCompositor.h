@@ -0,0 +1,62 @@
+#pragma once
+
+#include <CesiumImage/ImageAsset.h>
+#include <CesiumUtility/IntrusivePointer.h>
+
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief One raster overlay tile to be blended into a composite texture.
+ */
+struct RasterOverlayCompositeLayer {
+  /**
+   * @brief The overlay tile's image. Only uncompressed images with three or
+   * four 8-bit channels can be composited; other layers are skipped.
+   */
+  CesiumUtility::IntrusivePointer<CesiumImage::ImageAsset> pImage;
+
+  /**
+   * @brief The translation and scale that map the geometry tile's overlay
+   * texture coordinates into this image, as passed to
+   * `attachRasterInMainThread`.
+   */
+  glm::dvec2 translation;
+  glm::dvec2 scale;
+};
+
+/**
+ * @brief Flattens the raster overlay tiles covering a geometry tile into a
+ * single image, so that the tile's material only needs to sample one overlay
+ * texture.
+ *
+ * Compositing is pure CPU work on immutable images, so it may be done on any
+ * thread.
+ */
+class RasterOverlayCompositor {
+public:
+  /**
+   * @brief The largest width or height of a composite image.
+   */
+  static constexpr int32_t maximumSize = 2048;
+
+  /**
+   * @brief Blends the layers, in order, into a new RGBA image covering the
+   * geometry tile's overlay texture coordinates from 0 to 1, with mipmaps.
+   *
+   * The image is sized to preserve the resolution of the most detailed layer.
+   * Each layer is blended over the previous ones such that applying the
+   * composite with a single lerp by its alpha gives the same result as
+   * applying each layer in turn.
+   *
+   * @return The composite image, or nullptr if no layer could be composited.
+   */
+  static CesiumUtility::IntrusivePointer<CesiumImage::ImageAsset>
+  composite(const std::vector<RasterOverlayCompositeLayer>& layers);
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,463 @@
+#include "RenderResourceCache.h"
+
+#include <CesiumAsync/CacheItem.h>
+#include <CesiumAsync/HttpHeaders.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/SqliteCache.h>
+#include <CesiumImage/ImageAsset.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+
+using namespace CesiumAsync;
+using namespace CesiumImage;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// Processed resources are keyed by the validators of the response they were
+// derived from, so they can be kept much longer than the response itself.
+const std::chrono::hours processedResourceLifetime(24 * 30);
+
+// Bumped whenever the layout of a serialized resource changes.
+constexpr uint32_t imageFormatVersion = 1;
+constexpr uint32_t imageMagic = 0x4d494343; // "CCIM"
+constexpr uint32_t meshFormatVersion = 1;
+constexpr uint32_t meshMagic = 0x534d4343; // "CCMS"
+
+// More mip levels than a texture of the largest size Unity allows can have.
+constexpr uint32_t maximumMipCount = 32;
+
+// The smallest serialized primitive: its mode, two flags, two empty maps, and
+// no mesh.
+constexpr size_t minimumPrimitiveBytes = sizeof(int32_t) + 2 * sizeof(uint8_t) +
+                                         2 * sizeof(uint32_t) + sizeof(uint8_t);
+
+// Unity has 14 kinds of VertexAttribute, and each may appear in a mesh once.
+constexpr uint32_t maximumAttributeCount = 14;
+
+// The size of a component of each UnityEngine.Rendering.VertexAttributeFormat,
+// from Float32 to SInt32.
+constexpr std::array<int32_t, 12> vertexAttributeFormatSizes =
+    {4, 2, 1, 1, 2, 2, 1, 1, 2, 2, 4, 4};
+
+// UnityEngine.Rendering.IndexFormat.UInt32. The other value, zero, is UInt16.
+constexpr int32_t indexFormatUInt32 = 1;
+
+// The UnityEngine.MeshTopology values that converted primitives use.
+constexpr std::array<int32_t, 3> validTopologies = {
+    0, // Triangles
+    3, // Lines
+    5, // Points
+};
+
+class BlobWriter {
+public:
+  template <typename T> void write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const std::byte* pBytes = reinterpret_cast<const std::byte*>(&value);
+    this->_data.insert(this->_data.end(), pBytes, pBytes + sizeof(T));
+  }
+
+  void write(std::span<const std::byte> bytes) {
+    this->write(uint64_t(bytes.size()));
+    this->_data.insert(this->_data.end(), bytes.begin(), bytes.end());
+  }
+
+  void write(const std::unordered_map<uint32_t, uint32_t>& map) {
+    this->write(uint32_t(map.size()));
+    for (const auto& [key, value] : map) {
+      this->write(key);
+      this->write(value);
+    }
+  }
+
+  std::vector<std::byte>& data() noexcept { return this->_data; }
+
+private:
+  std::vector<std::byte> _data;
+};
+
+class BlobReader {
+public:
+  explicit BlobReader(std::span<const std::byte> data) : _data(data) {}
+
+  template <typename T> bool read(T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (this->_data.size() < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, this->_data.data(), sizeof(T));
+    this->_data = this->_data.subspan(sizeof(T));
+    return true;
+  }
+
+  bool read(std::vector<std::byte>& bytes) {
+    uint64_t size;
+    if (!this->read(size) || this->_data.size() < size) {
+      return false;
+    }
+    bytes.assign(this->_data.begin(), this->_data.begin() + size);
+    this->_data = this->_data.subspan(size);
+    return true;
+  }
+
+  bool read(std::unordered_map<uint32_t, uint32_t>& map) {
+    uint32_t size;
+    if (!this->read(size) ||
+        size > this->remaining() / (2 * sizeof(uint32_t))) {
+      return false;
+    }
+    for (uint32_t i = 0; i < size; ++i) {
+      uint32_t key, value;
+      if (!this->read(key) || !this->read(value)) {
+        return false;
+      }
+      map[key] = value;
+    }
+    return true;
+  }
+
+  bool read(bool& value) {
+    uint8_t byte;
+    if (!this->read(byte)) {
+      return false;
+    }
+    value = byte != 0;
+    return true;
+  }
+
+  size_t remaining() const noexcept { return this->_data.size(); }
+
+private:
+  std::span<const std::byte> _data;
+};
+
+void writePrimitive(BlobWriter& writer, const ProcessedPrimitive& primitive) {
+  const CesiumPrimitiveInfo& info = primitive.primitiveInfo;
+  writer.write(info.mode);
+  writer.write(uint8_t(info.isTranslucent));
+  writer.write(uint8_t(info.isUnlit));
+  writer.write(info.uvIndexMap);
+  writer.write(info.rasterOverlayUvIndexMap);
+
+  writer.write(uint8_t(primitive.hasMesh));
+  if (!primitive.hasMesh) {
+    return;
+  }
+
+  writer.write(uint32_t(primitive.attributes.size()));
+  for (const auto& attribute : primitive.attributes) {
+    writer.write(attribute);
+  }
+  writer.write(primitive.vertexCount);
+  writer.write(primitive.indexFormat);
+  writer.write(primitive.indexCount);
+  writer.write(primitive.topology);
+  writer.write(primitive.minimumPosition);
+  writer.write(primitive.maximumPosition);
+  writer.write(std::span<const std::byte>(primitive.vertexData));
+  writer.write(std::span<const std::byte>(primitive.indexData));
+}
+
+bool readPrimitive(BlobReader& reader, ProcessedPrimitive& primitive) {
+  CesiumPrimitiveInfo& info = primitive.primitiveInfo;
+  if (!reader.read(info.mode) || !reader.read(info.isTranslucent) ||
+      !reader.read(info.isUnlit) || !reader.read(info.uvIndexMap) ||
+      !reader.read(info.rasterOverlayUvIndexMap) ||
+      !reader.read(primitive.hasMesh)) {
+    return false;
+  }
+
+  if (!primitive.hasMesh) {
+    return true;
+  }
+
+  uint32_t attributeCount;
+  if (!reader.read(attributeCount) || attributeCount == 0 ||
+      attributeCount > maximumAttributeCount ||
+      attributeCount > reader.remaining() / sizeof(ProcessedVertexAttribute)) {
+    return false;
+  }
+
+  // Only the first vertex stream is stored, so every attribute must be in it.
+  std::array<bool, maximumAttributeCount> hasAttribute{};
+  size_t vertexStride = 0;
+  primitive.attributes.resize(attributeCount);
+  for (ProcessedVertexAttribute& attribute : primitive.attributes) {
+    if (!reader.read(attribute) || attribute.attribute < 0 ||
+        attribute.attribute >= int32_t(maximumAttributeCount) ||
+        hasAttribute[size_t(attribute.attribute)] || attribute.format < 0 ||
+        attribute.format >= int32_t(vertexAttributeFormatSizes.size()) ||
+        attribute.dimension < 1 || attribute.dimension > 4 ||
+        attribute.stream != 0) {
+      return false;
+    }
+    hasAttribute[size_t(attribute.attribute)] = true;
+    vertexStride += size_t(
+        vertexAttributeFormatSizes[size_t(attribute.format)] *
+        attribute.dimension);
+  }
+
+  if (!reader.read(primitive.vertexCount) ||
+      !reader.read(primitive.indexFormat) ||
+      !reader.read(primitive.indexCount) || !reader.read(primitive.topology) ||
+      !reader.read(primitive.minimumPosition) ||
+      !reader.read(primitive.maximumPosition) ||
+      !reader.read(primitive.vertexData) || !reader.read(primitive.indexData)) {
+    return false;
+  }
+
+  const size_t indexSize = primitive.indexFormat == indexFormatUInt32
+                               ? sizeof(uint32_t)
+                               : sizeof(uint16_t);
+  return primitive.vertexCount >= 0 && primitive.indexCount >= 0 &&
+         (primitive.indexFormat == 0 ||
+          primitive.indexFormat == indexFormatUInt32) &&
+         std::find(
+             validTopologies.begin(),
+             validTopologies.end(),
+             primitive.topology) != validTopologies.end() &&
+         primitive.vertexData.size() ==
+             size_t(primitive.vertexCount) * vertexStride &&
+         primitive.indexData.size() == size_t(primitive.indexCount) * indexSize;
+}
+
+} // namespace
+
+RenderResourceCache::RenderResourceCache(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& databasePath,
+    uint64_t maxItems,
+    int32_t storesPerPrune,
+    bool cacheTextures,
+    bool cacheMeshes)
+    : _pDatabase(std::make_unique<SqliteCache>(pLogger, databasePath, maxItems)),
+      _storesPerPrune(storesPerPrune),
+      _storesSinceLastPrune(0),
+      _cacheTextures(cacheTextures),
+      _cacheMeshes(cacheMeshes) {}
+
+RenderResourceCache::~RenderResourceCache() = default;
+
+/*static*/ std::optional<std::string>
+RenderResourceCache::getContentKey(const IAssetRequest& request) {
+  const IAssetResponse* pResponse = request.response();
+  if (!pResponse) {
+    return std::nullopt;
+  }
+
+  const HttpHeaders& headers = pResponse->headers();
+  auto it = headers.find("ETag");
+  if (it == headers.end()) {
+    it = headers.find("Last-Modified");
+  }
+
+  if (it == headers.end()) {
+    return std::nullopt;
+  }
+
+  return fmt::format("{}|{}", request.url(), it->second);
+}
+
+bool RenderResourceCache::readImage(
+    const std::string& contentKey,
+    int32_t imageIndex,
+    ImageAsset& image) const {
+  CESIUM_TRACE("RenderResourceCache::readImage");
+  std::optional<CacheItem> maybeItem = this->_pDatabase->getEntry(
+      RenderResourceCache::getImageKey(contentKey, imageIndex, image));
+  if (!maybeItem) {
+    return false;
+  }
+
+  BlobReader reader(maybeItem->cacheResponse.data);
+
+  uint32_t magic, version, mipCount;
+  if (!reader.read(magic) || magic != imageMagic || !reader.read(version) ||
+      version != imageFormatVersion || !reader.read(mipCount) ||
+      mipCount > maximumMipCount) {
+    return false;
+  }
+
+  std::vector<uint64_t> mipRanges(size_t(mipCount) * 2);
+  for (uint64_t& value : mipRanges) {
+    if (!reader.read(value)) {
+      return false;
+    }
+  }
+
+  std::vector<std::byte> pixelData;
+  if (!reader.read(pixelData)) {
+    return false;
+  }
+
+  // A truncated or corrupt entry must not describe mips outside the pixel
+  // data, or they would be read out of bounds when the texture is created.
+  // Rejecting it decodes the image again.
+  const uint64_t pixelDataSize = uint64_t(pixelData.size());
+  std::vector<ImageAssetMipPosition> mipPositions(mipCount);
+  for (size_t i = 0; i < mipPositions.size(); ++i) {
+    const uint64_t byteOffset = mipRanges[i * 2];
+    const uint64_t byteSize = mipRanges[i * 2 + 1];
+    if (byteOffset > pixelDataSize || byteSize > pixelDataSize - byteOffset) {
+      return false;
+    }
+    mipPositions[i].byteOffset = size_t(byteOffset);
+    mipPositions[i].byteSize = size_t(byteSize);
+  }
+
+  image.mipPositions = std::move(mipPositions);
+  image.pixelData = std::move(pixelData);
+  return true;
+}
+
+void RenderResourceCache::writeImage(
+    const std::string& contentKey,
+    int32_t imageIndex,
+    const ImageAsset& image) {
+  CESIUM_TRACE("RenderResourceCache::writeImage");
+  BlobWriter writer;
+  writer.write(imageMagic);
+  writer.write(imageFormatVersion);
+  writer.write(uint32_t(image.mipPositions.size()));
+  for (const ImageAssetMipPosition& mip : image.mipPositions) {
+    writer.write(uint64_t(mip.byteOffset));
+    writer.write(uint64_t(mip.byteSize));
+  }
+  writer.write(std::span<const std::byte>(image.pixelData));
+
+  this->store(
+      RenderResourceCache::getImageKey(contentKey, imageIndex, image),
+      contentKey,
+      writer.data());
+}
+
+/*static*/ std::string RenderResourceCache::getMeshKey(
+    const std::string& contentKey,
+    uint64_t settingsHash) {
+  return fmt::format("mesh:{}:{:016x}", contentKey, settingsHash);
+}
+
+bool RenderResourceCache::readPrimitives(
+    const std::string& meshKey,
+    std::vector<ProcessedPrimitive>& primitives) const {
+  CESIUM_TRACE("RenderResourceCache::readPrimitives");
+  std::optional<CacheItem> maybeItem = this->_pDatabase->getEntry(meshKey);
+  if (!maybeItem) {
+    return false;
+  }
+
+  return RenderResourceCache::deserializePrimitives(
+      maybeItem->cacheResponse.data,
+      primitives);
+}
+
+void RenderResourceCache::writePrimitives(
+    const std::string& meshKey,
+    const std::string& contentKey,
+    const std::vector<ProcessedPrimitive>& primitives) {
+  CESIUM_TRACE("RenderResourceCache::writePrimitives");
+  this->store(
+      meshKey,
+      contentKey,
+      RenderResourceCache::serializePrimitives(primitives));
+}
+
+/*static*/ std::vector<std::byte> RenderResourceCache::serializePrimitives(
+    const std::vector<ProcessedPrimitive>& primitives) {
+  BlobWriter writer;
+  writer.write(meshMagic);
+  writer.write(meshFormatVersion);
+  writer.write(uint32_t(primitives.size()));
+  for (const ProcessedPrimitive& primitive : primitives) {
+    writePrimitive(writer, primitive);
+  }
+  return std::move(writer.data());
+}
+
+/*static*/ bool RenderResourceCache::deserializePrimitives(
+    std::span<const std::byte> data,
+    std::vector<ProcessedPrimitive>& primitives) {
+  BlobReader reader(data);
+
+  // The count is checked against the size of the data before anything is
+  // allocated for it, so that a corrupt count can't ask for gigabytes.
+  uint32_t magic, version, primitiveCount;
+  if (!reader.read(magic) || magic != meshMagic || !reader.read(version) ||
+      version != meshFormatVersion || !reader.read(primitiveCount) ||
+      primitiveCount > reader.remaining() / minimumPrimitiveBytes) {
+    return false;
+  }
+
+  std::vector<ProcessedPrimitive> result(primitiveCount);
+  for (ProcessedPrimitive& primitive : result) {
+    if (!readPrimitive(reader, primitive)) {
+      return false;
+    }
+  }
+
+  if (reader.remaining() != 0) {
+    return false;
+  }
+
+  primitives = std::move(result);
+  return true;
+}
+
+/*static*/ std::string RenderResourceCache::getImageKey(
+    const std::string& contentKey,
+    int32_t imageIndex,
+    const ImageAsset& image) {
+  // The key must capture everything that determines the processed result, so
+  // that a change to the requested GPU format (e.g. on a different device)
+  // misses the cache rather than returning incompatible data.
+  return fmt::format(
+      "image:{}:{}:{}x{}:{}:{}:{}",
+      contentKey,
+      imageIndex,
+      image.width,
+      image.height,
+      image.channels,
+      image.bytesPerChannel,
+      int32_t(image.compressedPixelFormat));
+}
+
+void RenderResourceCache::store(
+    const std::string& key,
+    const std::string& url,
+    const std::vector<std::byte>& data) {
+  std::time_t expiryTime = std::chrono::system_clock::to_time_t(
+      std::chrono::system_clock::now() + processedResourceLifetime);
+
+  this->_pDatabase->storeEntry(
+      key,
+      expiryTime,
+      url,
+      "GET",
+      HttpHeaders(),
+      200,
+      HttpHeaders(),
+      std::span<const std::byte>(data));
+
+  // Prune on the same schedule as the request cache.
+  if (this->_storesPerPrune > 0 &&
+      ++this->_storesSinceLastPrune >= this->_storesPerPrune) {
+    this->_storesSinceLastPrune = 0;
+    this->_pDatabase->prune();
+  }
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "CesiumPrimitiveInfo.h"
+
+#include <glm/vec3.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace spdlog {
+class logger;
+}
+
+namespace CesiumAsync {
+class ICacheDatabase;
+class IAssetRequest;
+} // namespace CesiumAsync
+
+namespace CesiumImage {
+struct ImageAsset;
+} // namespace CesiumImage
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief The layout of a vertex attribute, with the same fields and values as
+ * Unity's `VertexAttributeDescriptor`.
+ */
+struct ProcessedVertexAttribute {
+  /**
+   * @brief The `UnityEngine.Rendering.VertexAttribute`.
+   */
+  int32_t attribute = 0;
+
+  /**
+   * @brief The `UnityEngine.Rendering.VertexAttributeFormat`.
+   */
+  int32_t format = 0;
+
+  int32_t dimension = 0;
+  int32_t stream = 0;
+};
+
+/**
+ * @brief A glTF primitive after it has been converted to Unity mesh data, in a
+ * form that can be copied directly back into a MeshData.
+ */
+struct ProcessedPrimitive {
+  /**
+   * @brief Information about how the primitive was converted.
+   */
+  CesiumPrimitiveInfo primitiveInfo{};
+
+  /**
+   * @brief Whether the conversion produced a mesh. Primitives that were
+   * skipped are still recorded so that primitive indices line up.
+   */
+  bool hasMesh = false;
+
+  /**
+   * @brief The layout of the single interleaved vertex stream.
+   */
+  std::vector<ProcessedVertexAttribute> attributes{};
+
+  int32_t vertexCount = 0;
+
+  /**
+   * @brief The `UnityEngine.Rendering.IndexFormat`.
+   */
+  int32_t indexFormat = 0;
+
+  int32_t indexCount = 0;
+
+  /**
+   * @brief The `UnityEngine.MeshTopology`.
+   */
+  int32_t topology = 0;
+
+  /**
+   * @brief The bounds of the vertex positions, so that they need not be
+   * recalculated by Unity.
+   */
+  glm::vec3 minimumPosition{0.0f};
+  glm::vec3 maximumPosition{0.0f};
+
+  std::vector<std::byte> vertexData{};
+  std::vector<std::byte> indexData{};
+};
+
+/**
+ * @brief A persistent cache of tile resources that have already been
+ * processed into the form that Unity consumes.
+ *
+ * The cache lives in its own SQLite database next to the request cache and is
+ * pruned on the same schedule, and to the same maximum number of items, as the
+ * request cache. All methods may be called from any thread.
+ */
+class RenderResourceCache {
+public:
+  RenderResourceCache(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const std::string& databasePath,
+      uint64_t maxItems,
+      int32_t storesPerPrune,
+      bool cacheTextures,
+      bool cacheMeshes);
+
+  ~RenderResourceCache();
+
+  /**
+   * @brief Whether processed textures should be read from and written to this
+   * cache.
+   */
+  bool cacheTextures() const noexcept { return this->_cacheTextures; }
+
+  /**
+   * @brief Whether processed meshes should be read from and written to this
+   * cache.
+   */
+  bool cacheMeshes() const noexcept { return this->_cacheMeshes; }
+
+  /**
+   * @brief Computes the key identifying the content of a completed tile
+   * request.
+   *
+   * The key combines the URL with the `ETag` or `Last-Modified` response
+   * header, so that modified content on the server is not masked by stale
+   * processed resources.
+   *
+   * @return The key, or `std::nullopt` if the request has no response or the
+   * response has neither header. Processed resources are not cached then,
+   * because there is no way to tell when the content changes.
+   */
+  static std::optional<std::string>
+  getContentKey(const CesiumAsync::IAssetRequest& request);
+
+  /**
+   * @brief Attempts to read a processed image from the cache.
+   *
+   * @param contentKey The key of the tile content, from
+   * {@link getContentKey}.
+   * @param imageIndex The index of the image within the glTF.
+   * @param image The image whose format is used to complete the key. On a
+   * cache hit, its pixel data and mip positions are replaced by the cached
+   * data.
+   * @return True if the image was found in the cache.
+   */
+  bool readImage(
+      const std::string& contentKey,
+      int32_t imageIndex,
+      CesiumImage::ImageAsset& image) const;
+
+  /**
+   * @brief Stores a processed image in the cache.
+   *
+   * @param contentKey The key of the tile content, from
+   * {@link getContentKey}.
+   * @param imageIndex The index of the image within the glTF.
+   * @param image The processed image.
+   */
+  void writeImage(
+      const std::string& contentKey,
+      int32_t imageIndex,
+      const CesiumImage::ImageAsset& image);
+
+  /**
+   * @brief Computes the key for the processed meshes of tile content.
+   *
+   * @param contentKey The key of the tile content, from
+   * {@link getContentKey}.
+   * @param settingsHash A hash of every setting that affects how the content
+   * is converted to meshes. It must be computed the same way on every
+   * platform and in every run.
+   */
+  static std::string
+  getMeshKey(const std::string& contentKey, uint64_t settingsHash);
+
+  /**
+   * @brief Attempts to read the processed primitives of tile content from the
+   * cache.
+   *
+   * @param meshKey The key from {@link getMeshKey}.
+   * @param primitives Receives the primitives, in the order they are visited
+   * by `Model::forEachPrimitiveInScene`.
+   * @return True if the primitives were found in the cache.
+   */
+  bool readPrimitives(
+      const std::string& meshKey,
+      std::vector<ProcessedPrimitive>& primitives) const;
+
+  /**
+   * @brief Stores the processed primitives of tile content in the cache.
+   *
+   * @param meshKey The key from {@link getMeshKey}.
+   * @param contentKey The key of the tile content, from
+   * {@link getContentKey}.
+   * @param primitives The primitives, in the order they are visited by
+   * `Model::forEachPrimitiveInScene`.
+   */
+  void writePrimitives(
+      const std::string& meshKey,
+      const std::string& contentKey,
+      const std::vector<ProcessedPrimitive>& primitives);
+
+  /**
+   * @brief Serializes processed primitives into the form stored in the cache.
+   */
+  static std::vector<std::byte>
+  serializePrimitives(const std::vector<ProcessedPrimitive>& primitives);
+
+  /**
+   * @brief Deserializes processed primitives stored in the cache.
+   *
+   * The data is validated, so that a truncated or corrupt entry is rejected
+   * rather than creating an invalid mesh or a huge allocation.
+   *
+   * @param data The data from {@link serializePrimitives}.
+   * @param primitives Receives the primitives. It is unchanged if the data is
+   * not valid.
+   * @return True if the data holds valid primitives.
+   */
+  static bool deserializePrimitives(
+      std::span<const std::byte> data,
+      std::vector<ProcessedPrimitive>& primitives);
+
+private:
+  static std::string getImageKey(
+      const std::string& contentKey,
+      int32_t imageIndex,
+      const CesiumImage::ImageAsset& image);
+
+  void store(
+      const std::string& key,
+      const std::string& url,
+      const std::vector<std::byte>& data);
+
+  std::unique_ptr<CesiumAsync::ICacheDatabase> _pDatabase;
+  int32_t _storesPerPrune;
+  std::atomic<int32_t> _storesSinceLastPrune;
+  bool _cacheTextures;
+  bool _cacheMeshes;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,61 @@
+#include "SharedMaterialCache.h"
+
+#include <DotNet/CesiumForUnity/Helpers.h>
+
+using namespace DotNet;
+
+namespace CesiumForUnityNative {
+
+UnityEngine::Material SharedMaterialCache::acquire(
+    const std::string& key,
+    const std::function<UnityEngine::Material(int64_t&)>& create) {
+  auto keyIt = this->_objectIDsByKey.find(key);
+  if (keyIt != this->_objectIDsByKey.end()) {
+    Entry& entry = this->_entriesByObjectID.at(keyIt->second);
+    // The material may have been destroyed out from under us, for example if
+    // a user destroyed it from a tile's renderer. Replace it in that case.
+    if (entry.material != nullptr) {
+      ++entry.references;
+      return entry.material;
+    }
+
+    this->_totalTextureBytes -= entry.textureBytes;
+    this->_entriesByObjectID.erase(keyIt->second);
+    this->_objectIDsByKey.erase(keyIt);
+  }
+
+  int64_t textureBytes = 0;
+  UnityEngine::Material material = create(textureBytes);
+  uint64_t objectID = CesiumForUnity::Helpers::GetObjectId(material);
+  this->_entriesByObjectID.emplace(
+      objectID,
+      Entry{material, key, 1, textureBytes});
+  this->_totalTextureBytes += textureBytes;
+  this->_objectIDsByKey.emplace(key, objectID);
+  return material;
+}
+
+bool SharedMaterialCache::isShared(
+    const UnityEngine::Material& material) const {
+  return this->_entriesByObjectID.contains(
+      CesiumForUnity::Helpers::GetObjectId(material));
+}
+
+bool SharedMaterialCache::release(const UnityEngine::Material& material) {
+  auto it = this->_entriesByObjectID.find(
+      CesiumForUnity::Helpers::GetObjectId(material));
+  if (it == this->_entriesByObjectID.end()) {
+    return true;
+  }
+
+  if (--it->second.references > 0) {
+    return false;
+  }
+
+  this->_totalTextureBytes -= it->second.textureBytes;
+  this->_objectIDsByKey.erase(it->second.key);
+  this->_entriesByObjectID.erase(it);
+  return true;
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <DotNet/UnityEngine/Material.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Reference-counted Material instances shared between tile primitives
+ * whose material parameters are identical.
+ *
+ * This must only be used from the main thread.
+ */
+class SharedMaterialCache {
+public:
+  /**
+   * @brief Gets the material with the given key, creating it if necessary,
+   * and adds a reference to it.
+   *
+   * @param key A description of all parameters that determine the material.
+   * Materials are only shared between primitives with equal keys.
+   * @param create Creates the material if it does not exist yet, and adds the
+   * size of the textures it creates, in bytes, to its parameter.
+   */
+  ::DotNet::UnityEngine::Material acquire(
+      const std::string& key,
+      const std::function<::DotNet::UnityEngine::Material(int64_t&)>& create);
+
+  /**
+   * @brief Determines whether the given material is owned by this cache.
+   */
+  bool isShared(const ::DotNet::UnityEngine::Material& material) const;
+
+  /**
+   * @brief Releases a reference to the given material.
+   *
+   * @return True if the material is no longer referenced and should be
+   * destroyed, along with its textures. This is also true for materials that
+   * were not acquired from this cache.
+   */
+  bool release(const ::DotNet::UnityEngine::Material& material);
+
+  /**
+   * @brief Gets the total size of the textures of the materials in this
+   * cache, in bytes.
+   */
+  int64_t getTotalTextureBytes() const noexcept {
+    return this->_totalTextureBytes;
+  }
+
+private:
+  struct Entry {
+    ::DotNet::UnityEngine::Material material;
+    std::string key;
+    int32_t references;
+    int64_t textureBytes;
+  };
+
+  std::unordered_map<uint64_t, Entry> _entriesByObjectID;
+  std::unordered_map<std::string, uint64_t> _objectIDsByKey;
+  int64_t _totalTextureBytes = 0;
+};
+
+} // namespace CesiumForUnityNative
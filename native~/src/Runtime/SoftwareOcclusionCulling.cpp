@@ -0,0 +1,592 @@
+#include "SoftwareOcclusionCulling.h"
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <Cesium3DTilesSelection/ViewUpdateResult.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/GltfUtilities.h>
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <utility>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// The width of the depth buffer, in pixels. Its height follows from the
+// camera's aspect ratio.
+constexpr int32_t depthBufferWidth = 256;
+
+// The most triangles rasterized each frame, across all tilesets.
+constexpr size_t maximumOccluderTriangles = 200000;
+
+// Geometry nearer to the camera than this, in meters, is never an occluder
+// and never occluded.
+constexpr double nearPlane = 1.0;
+
+// The most tiles that a tileset tests for occlusion at once.
+constexpr int32_t maximumProxyCount = 2000;
+
+// How far a camera may move from the one that saw the occluders before tiles
+// are no longer tested against them, as a fraction of its height above the
+// ellipsoid, and at least the minimum, in meters.
+constexpr double maximumViewMovementFraction = 0.01;
+constexpr double minimumViewMovement = 1.0;
+
+template <typename TIndex, typename Callback>
+void forEachIndexedTriangle(
+    const Model& model,
+    int32_t accessorID,
+    size_t vertexCount,
+    Callback&& callback) {
+  AccessorView<TIndex> indices(model, accessorID);
+  if (indices.status() != AccessorViewStatus::Valid) {
+    return;
+  }
+
+  for (int64_t i = 0; i + 2 < indices.size(); i += 3) {
+    size_t i0 = size_t(indices[i]);
+    size_t i1 = size_t(indices[i + 1]);
+    size_t i2 = size_t(indices[i + 2]);
+    if (i0 < vertexCount && i1 < vertexCount && i2 < vertexCount) {
+      callback(i0, i1, i2);
+    }
+  }
+}
+
+} // namespace
+
+OcclusionDepthBuffer::OcclusionDepthBuffer()
+    : _position(0.0),
+      _direction(0.0),
+      _pixelAngle(0.0),
+      _ecefToView(1.0),
+      _xScale(0.0),
+      _yScale(0.0),
+      _width(0),
+      _height(0),
+      _trianglesRasterized(0),
+      _levels(),
+      _vertices() {}
+
+void OcclusionDepthBuffer::reset(const ViewState& viewState, int32_t width) {
+  this->_position = viewState.getPosition();
+  this->_direction = glm::normalize(viewState.getDirection());
+  glm::dvec3 right =
+      glm::normalize(glm::cross(this->_direction, viewState.getUp()));
+  glm::dvec3 up = glm::cross(right, this->_direction);
+
+  // Rows of the rotation into view space, where +Z is the view direction.
+  this->_ecefToView = glm::dmat4(
+      glm::dvec4(right.x, up.x, this->_direction.x, 0.0),
+      glm::dvec4(right.y, up.y, this->_direction.y, 0.0),
+      glm::dvec4(right.z, up.z, this->_direction.z, 0.0),
+      glm::dvec4(
+          -glm::dot(right, this->_position),
+          -glm::dot(up, this->_position),
+          -glm::dot(this->_direction, this->_position),
+          1.0));
+
+  const double tanHalfHorizontal =
+      std::tan(viewState.getHorizontalFieldOfView() * 0.5);
+  const double tanHalfVertical =
+      std::tan(viewState.getVerticalFieldOfView() * 0.5);
+
+  this->_width = width;
+  this->_height = std::clamp(
+      int32_t(std::lround(width * tanHalfVertical / tanHalfHorizontal)),
+      16,
+      width * 2);
+  this->_pixelAngle = viewState.getHorizontalFieldOfView() / this->_width;
+  this->_xScale = 0.5 * this->_width / tanHalfHorizontal;
+  this->_yScale = 0.5 * this->_height / tanHalfVertical;
+  this->_trianglesRasterized = 0;
+
+  this->_levels.resize(1);
+  Level& level = this->_levels[0];
+  level.width = this->_width;
+  level.height = this->_height;
+  level.inverseDepths.assign(size_t(this->_width) * this->_height, 0.0f);
+}
+
+void OcclusionDepthBuffer::clear() {
+  this->_width = 0;
+  this->_height = 0;
+  this->_trianglesRasterized = 0;
+  this->_levels.clear();
+}
+
+bool OcclusionDepthBuffer::matchesView(const ViewState& viewState) const {
+  return glm::distance(viewState.getPosition(), this->_position) < 1e-3 &&
+         glm::dot(glm::normalize(viewState.getDirection()), this->_direction) >
+             1.0 - 1e-9;
+}
+
+bool OcclusionDepthBuffer::isNearView(const ViewState& viewState) const {
+  if (!this->hasView()) {
+    return false;
+  }
+
+  const std::optional<Cartographic> maybePosition =
+      viewState.getPositionCartographic();
+  const double maximumMovement = std::max(
+      minimumViewMovement,
+      maybePosition ? maybePosition->height * maximumViewMovementFraction
+                    : 0.0);
+  if (glm::distance(viewState.getPosition(), this->_position) >
+      maximumMovement) {
+    return false;
+  }
+
+  const double cosine = std::clamp(
+      glm::dot(glm::normalize(viewState.getDirection()), this->_direction),
+      -1.0,
+      1.0);
+  return std::acos(cosine) <= this->_pixelAngle;
+}
+
+size_t OcclusionDepthBuffer::rasterizeModel(
+    const Model& model,
+    const glm::dmat4& modelToEcef,
+    size_t maximumTriangles) {
+  if (!this->hasView()) {
+    return 0;
+  }
+
+  size_t triangles = 0;
+  model.forEachPrimitiveInScene(
+      -1,
+      [this, &modelToEcef, maximumTriangles, &triangles](
+          const Model& gltf,
+          const Node& /*node*/,
+          const Mesh& /*mesh*/,
+          const MeshPrimitive& primitive,
+          const glm::dmat4& transform) {
+        if (primitive.mode != MeshPrimitive::Mode::TRIANGLES) {
+          return;
+        }
+
+        auto positionAccessorIt = primitive.attributes.find("POSITION");
+        if (positionAccessorIt == primitive.attributes.end()) {
+          return;
+        }
+
+        // Quantized positions are skipped, which only means fewer occluders.
+        AccessorView<glm::vec3> positions(gltf, positionAccessorIt->second);
+        if (positions.status() != AccessorViewStatus::Valid) {
+          return;
+        }
+
+        const Accessor* pIndexAccessor =
+            Model::getSafe(&gltf.accessors, primitive.indices);
+        const size_t primitiveTriangles =
+            size_t(pIndexAccessor ? pIndexAccessor->count : positions.size()) /
+            3;
+        if (triangles + primitiveTriangles > maximumTriangles) {
+          return;
+        }
+        triangles += primitiveTriangles;
+
+        // Relative to the camera, single precision is plenty for a buffer
+        // this coarse.
+        const glm::mat4 modelToView(
+            this->_ecefToView * modelToEcef * transform);
+        const float width = float(this->_width);
+        const float height = float(this->_height);
+        const float xScale = float(this->_xScale);
+        const float yScale = float(this->_yScale);
+
+        this->_vertices.resize(size_t(positions.size()));
+        for (int64_t i = 0; i < positions.size(); ++i) {
+          glm::vec4 view = modelToView * glm::vec4(positions[i], 1.0f);
+          ScreenVertex& vertex = this->_vertices[size_t(i)];
+          if (view.z < float(nearPlane)) {
+            vertex.inverseDepth = 0.0f;
+            continue;
+          }
+
+          const float inverseDepth = 1.0f / view.z;
+          vertex.x = 0.5f * width + xScale * view.x * inverseDepth;
+          vertex.y = 0.5f * height - yScale * view.y * inverseDepth;
+          vertex.inverseDepth = inverseDepth;
+        }
+
+        const size_t vertexCount = this->_vertices.size();
+        auto rasterize = [this](size_t i0, size_t i1, size_t i2) {
+          this->rasterizeTriangle(
+              this->_vertices[i0],
+              this->_vertices[i1],
+              this->_vertices[i2]);
+        };
+
+        if (!pIndexAccessor) {
+          for (size_t i = 0; i + 2 < vertexCount; i += 3) {
+            rasterize(i, i + 1, i + 2);
+          }
+        } else if (
+            pIndexAccessor->componentType ==
+            Accessor::ComponentType::UNSIGNED_BYTE) {
+          forEachIndexedTriangle<uint8_t>(
+              gltf,
+              primitive.indices,
+              vertexCount,
+              rasterize);
+        } else if (
+            pIndexAccessor->componentType ==
+            Accessor::ComponentType::UNSIGNED_SHORT) {
+          forEachIndexedTriangle<uint16_t>(
+              gltf,
+              primitive.indices,
+              vertexCount,
+              rasterize);
+        } else if (
+            pIndexAccessor->componentType ==
+            Accessor::ComponentType::UNSIGNED_INT) {
+          forEachIndexedTriangle<uint32_t>(
+              gltf,
+              primitive.indices,
+              vertexCount,
+              rasterize);
+        }
+      });
+
+  this->_trianglesRasterized += triangles;
+  return triangles;
+}
+
+void OcclusionDepthBuffer::rasterizeTriangle(
+    const ScreenVertex& v0,
+    const ScreenVertex& v1,
+    const ScreenVertex& v2) {
+  // A vertex in front of the near plane has no inverse depth.
+  if (v0.inverseDepth <= 0.0f || v1.inverseDepth <= 0.0f ||
+      v2.inverseDepth <= 0.0f) {
+    return;
+  }
+
+  const float area =
+      (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+  if (std::abs(area) < 1e-6f) {
+    return;
+  }
+
+  const int32_t minX = std::max(
+      int32_t(std::floor(std::min({v0.x, v1.x, v2.x}))),
+      int32_t(0));
+  const int32_t maxX = std::min(
+      int32_t(std::ceil(std::max({v0.x, v1.x, v2.x}))),
+      this->_width - 1);
+  const int32_t minY = std::max(
+      int32_t(std::floor(std::min({v0.y, v1.y, v2.y}))),
+      int32_t(0));
+  const int32_t maxY = std::min(
+      int32_t(std::ceil(std::max({v0.y, v1.y, v2.y}))),
+      this->_height - 1);
+  if (minX > maxX || minY > maxY) {
+    return;
+  }
+
+  // Each barycentric coordinate is a plane over the screen, as is the inverse
+  // depth interpolated with them. Dividing by the signed area makes every
+  // coordinate non-negative inside the triangle, whatever its winding.
+  const float inverseArea = 1.0f / area;
+  const float a0 = (v1.y - v2.y) * inverseArea;
+  const float b0 = (v2.x - v1.x) * inverseArea;
+  const float c0 = -(a0 * v1.x + b0 * v1.y);
+  const float a1 = (v2.y - v0.y) * inverseArea;
+  const float b1 = (v0.x - v2.x) * inverseArea;
+  const float c1 = -(a1 * v2.x + b1 * v2.y);
+  const float a2 = (v0.y - v1.y) * inverseArea;
+  const float b2 = (v1.x - v0.x) * inverseArea;
+  const float c2 = -(a2 * v0.x + b2 * v0.y);
+  const float aDepth =
+      a0 * v0.inverseDepth + a1 * v1.inverseDepth + a2 * v2.inverseDepth;
+  const float bDepth =
+      b0 * v0.inverseDepth + b1 * v1.inverseDepth + b2 * v2.inverseDepth;
+  // The inverse depth written to a pixel is the smallest of the triangle's
+  // plane anywhere in the pixel, not the one at its center, so that the pixel
+  // never holds an occluder nearer than the triangle is.
+  const float cDepth =
+      c0 * v0.inverseDepth + c1 * v1.inverseDepth + c2 * v2.inverseDepth -
+      0.5f * (std::abs(aDepth) + std::abs(bDepth));
+
+  std::vector<float>& inverseDepths = this->_levels[0].inverseDepths;
+  for (int32_t y = minY; y <= maxY; ++y) {
+    const float py = float(y) + 0.5f;
+    const float row0 = b0 * py + c0;
+    const float row1 = b1 * py + c1;
+    const float row2 = b2 * py + c2;
+    const float rowDepth = bDepth * py + cDepth;
+    float* pRow = inverseDepths.data() + size_t(y) * size_t(this->_width);
+
+    // Every pixel of the span is computed independently and written with a
+    // select, so that compilers vectorize this loop.
+    for (int32_t x = minX; x <= maxX; ++x) {
+      const float px = float(x) + 0.5f;
+      const float l0 = a0 * px + row0;
+      const float l1 = a1 * px + row1;
+      const float l2 = a2 * px + row2;
+      const float inverseDepth = aDepth * px + rowDepth;
+      const bool inside = std::min(l0, std::min(l1, l2)) >= 0.0f &&
+                          inverseDepth > 0.0f;
+      pRow[x] = inside ? std::max(pRow[x], inverseDepth) : pRow[x];
+    }
+  }
+}
+
+void OcclusionDepthBuffer::buildHierarchy() {
+  if (this->_levels.empty()) {
+    return;
+  }
+
+  this->_levels.resize(1);
+  while (this->_levels.back().width > 1 || this->_levels.back().height > 1) {
+    const Level& finer = this->_levels.back();
+    Level coarser{
+        (finer.width + 1) / 2,
+        (finer.height + 1) / 2,
+        std::vector<float>()};
+    coarser.inverseDepths.resize(size_t(coarser.width) * coarser.height);
+
+    for (int32_t y = 0; y < coarser.height; ++y) {
+      const int32_t y0 = y * 2;
+      const int32_t y1 = std::min(y0 + 1, finer.height - 1);
+      for (int32_t x = 0; x < coarser.width; ++x) {
+        const int32_t x0 = x * 2;
+        const int32_t x1 = std::min(x0 + 1, finer.width - 1);
+        const float* pFiner = finer.inverseDepths.data();
+        coarser.inverseDepths[size_t(y) * coarser.width + x] = std::min(
+            {pFiner[size_t(y0) * finer.width + x0],
+             pFiner[size_t(y0) * finer.width + x1],
+             pFiner[size_t(y1) * finer.width + x0],
+             pFiner[size_t(y1) * finer.width + x1]});
+      }
+    }
+
+    this->_levels.emplace_back(std::move(coarser));
+  }
+}
+
+bool OcclusionDepthBuffer::isOccluded(
+    const OrientedBoundingBox& box,
+    double depthBias) const {
+  if (!this->hasOccluders()) {
+    return false;
+  }
+
+  const glm::dvec3& center = box.getCenter();
+  const glm::dmat3& halfAxes = box.getHalfAxes();
+
+  double nearestDepth = std::numeric_limits<double>::max();
+  double minX = std::numeric_limits<double>::max();
+  double maxX = std::numeric_limits<double>::lowest();
+  double minY = std::numeric_limits<double>::max();
+  double maxY = std::numeric_limits<double>::lowest();
+  for (int32_t i = 0; i < 8; ++i) {
+    const glm::dvec3 corner = center +
+                              ((i & 1) ? halfAxes[0] : -halfAxes[0]) +
+                              ((i & 2) ? halfAxes[1] : -halfAxes[1]) +
+                              ((i & 4) ? halfAxes[2] : -halfAxes[2]);
+    const glm::dvec4 view = this->_ecefToView * glm::dvec4(corner, 1.0);
+    if (view.z < nearPlane) {
+      return false;
+    }
+
+    nearestDepth = std::min(nearestDepth, view.z);
+    const double x = 0.5 * this->_width + this->_xScale * view.x / view.z;
+    const double y = 0.5 * this->_height - this->_yScale * view.y / view.z;
+    minX = std::min(minX, x);
+    maxX = std::max(maxX, x);
+    minY = std::min(minY, y);
+    maxY = std::max(maxY, y);
+  }
+
+  const double biasedDepth = nearestDepth - depthBias;
+  if (biasedDepth < nearPlane) {
+    return false;
+  }
+
+  // Only the part of the box on the screen can be seen. A box entirely off
+  // the screen is left to frustum culling.
+  if (maxX < 0.0 || minX > double(this->_width) || maxY < 0.0 ||
+      minY > double(this->_height)) {
+    return false;
+  }
+
+  // A pixel is written where a triangle covers its center, so the part of the
+  // box in a pixel at the edge of an occluder may be uncovered. The box is
+  // also tested against the pixels around it, one of which is uncovered if
+  // that part can be seen.
+  const double lastX = double(this->_width - 1);
+  const double lastY = double(this->_height - 1);
+  const int32_t x0 = int32_t(std::clamp(std::floor(minX) - 1.0, 0.0, lastX));
+  const int32_t x1 = int32_t(std::clamp(std::floor(maxX) + 1.0, 0.0, lastX));
+  const int32_t y0 = int32_t(std::clamp(std::floor(minY) - 1.0, 0.0, lastY));
+  const int32_t y1 = int32_t(std::clamp(std::floor(maxY) + 1.0, 0.0, lastY));
+
+  // Tests the level at which the box covers at most four by four texels.
+  size_t levelIndex = 0;
+  while (levelIndex + 1 < this->_levels.size() &&
+         ((x1 >> levelIndex) - (x0 >> levelIndex) > 3 ||
+          (y1 >> levelIndex) - (y0 >> levelIndex) > 3)) {
+    ++levelIndex;
+  }
+
+  const Level& level = this->_levels[levelIndex];
+  const float boxInverseDepth = float(1.0 / biasedDepth);
+  for (int32_t y = y0 >> levelIndex; y <= (y1 >> levelIndex); ++y) {
+    for (int32_t x = x0 >> levelIndex; x <= (x1 >> levelIndex); ++x) {
+      if (level.inverseDepths[size_t(y) * level.width + x] <=
+          boxInverseDepth) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/*static*/ SoftwareOcclusionCulling& SoftwareOcclusionCulling::getInstance() {
+  static SoftwareOcclusionCulling instance;
+  return instance;
+}
+
+SoftwareOcclusionCulling::SoftwareOcclusionCulling()
+    : _tick(0),
+      _trianglesRemaining(maximumOccluderTriangles),
+      _building(),
+      _testing(),
+      _testingNearView(false) {}
+
+void SoftwareOcclusionCulling::beginTilesetUpdate(
+    uint64_t tick,
+    const ViewState& viewState) {
+  if (tick != this->_tick) {
+    this->_tick = tick;
+    std::swap(this->_building, this->_testing);
+    this->_testing.buildHierarchy();
+    this->_building.clear();
+    this->_trianglesRemaining = maximumOccluderTriangles;
+  }
+
+  // Tiles that can be seen from where the camera is now may have been hidden
+  // from where it was.
+  this->_testingNearView = this->_testing.hasOccluders() &&
+                           this->_testing.isNearView(viewState);
+}
+
+void SoftwareOcclusionCulling::addOccluders(
+    const ViewState& viewState,
+    const ViewUpdateResult& result) {
+  if (!this->_building.hasView()) {
+    this->_building.reset(viewState, depthBufferWidth);
+  } else if (!this->_building.matchesView(viewState)) {
+    // Tilesets seen by other cameras can't occlude the tiles of this one.
+    return;
+  }
+
+  for (auto pTile : result.tilesToRenderThisFrame) {
+    if (this->_trianglesRemaining == 0) {
+      break;
+    }
+
+    const TileRenderContent* pRenderContent =
+        pTile->getContent().getRenderContent();
+    if (!pRenderContent) {
+      continue;
+    }
+
+    const Model& model = pRenderContent->getModel();
+    glm::dmat4 tileTransform = pTile->getTransform();
+    tileTransform = GltfUtilities::applyRtcCenter(model, tileTransform);
+    tileTransform =
+        GltfUtilities::applyGltfUpAxisTransform(model, tileTransform);
+
+    this->_trianglesRemaining -= this->_building.rasterizeModel(
+        model,
+        tileTransform,
+        this->_trianglesRemaining);
+  }
+}
+
+TileOcclusionState SoftwareOcclusionCulling::getOcclusionState(
+    const Tile& tile,
+    const Ellipsoid& ellipsoid) const {
+  if (!this->_testingNearView) {
+    return TileOcclusionState::OcclusionUnavailable;
+  }
+
+  // The occluders may be coarser tiles than the ones they hide, standing in
+  // front of the true surface by up to their geometric error. The parent's
+  // error is used because a tile's own parent is often what covers it.
+  const Tile* pParent = tile.getParent();
+  const double depthBias =
+      pParent ? pParent->getGeometricError() : tile.getGeometricError();
+
+  const OrientedBoundingBox box = getOrientedBoundingBoxFromBoundingVolume(
+      tile.getBoundingVolume(),
+      ellipsoid);
+  return this->_testing.isOccluded(box, depthBias)
+             ? TileOcclusionState::Occluded
+             : TileOcclusionState::NotOccluded;
+}
+
+class SoftwareOcclusionProxyPool::Proxy : public TileOcclusionRendererProxy {
+public:
+  explicit Proxy(const SoftwareOcclusionProxyPool& pool)
+      : _pool(pool), _pTile(nullptr) {}
+
+  virtual TileOcclusionState getOcclusionState() const override {
+    if (!this->_pTile || !this->_pool._enabled) {
+      return TileOcclusionState::OcclusionUnavailable;
+    }
+
+    return SoftwareOcclusionCulling::getInstance().getOcclusionState(
+        *this->_pTile,
+        this->_pool._ellipsoid);
+  }
+
+protected:
+  virtual void reset(const Tile* pTile) override { this->_pTile = pTile; }
+
+private:
+  const SoftwareOcclusionProxyPool& _pool;
+  const Tile* _pTile;
+};
+
+SoftwareOcclusionProxyPool::SoftwareOcclusionProxyPool(
+    const Ellipsoid& ellipsoid)
+    : TileOcclusionRendererProxyPool(maximumProxyCount),
+      _ellipsoid(ellipsoid),
+      _enabled(false) {}
+
+SoftwareOcclusionProxyPool::~SoftwareOcclusionProxyPool() {
+  // The proxies must be destroyed while this is still a
+  // SoftwareOcclusionProxyPool.
+  this->destroyPool();
+}
+
+TileOcclusionRendererProxy* SoftwareOcclusionProxyPool::createProxy() {
+  return new Proxy(*this);
+}
+
+void SoftwareOcclusionProxyPool::destroyProxy(
+    TileOcclusionRendererProxy* pProxy) {
+  delete pProxy;
+}
+
+} // namespace CesiumForUnityNative
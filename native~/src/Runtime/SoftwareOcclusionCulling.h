@@ -0,0 +1,247 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/TileOcclusionRendererProxy.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+class ViewState;
+class ViewUpdateResult;
+} // namespace Cesium3DTilesSelection
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief A coarse depth buffer of occluding geometry, as seen by one camera,
+ * that bounding boxes are tested against.
+ *
+ * Occluders are rasterized on the CPU at a low resolution. Each pixel holds
+ * the inverse of the view-space depth of the nearest occluder, or zero where
+ * there is none, so that it can be interpolated linearly across triangles in
+ * screen space. A hierarchy of successively halved levels holds the farthest
+ * depth of each block of pixels, so that a box covering much of the screen is
+ * tested with a handful of reads.
+ *
+ * Occluders are sampled at pixel centers, so a pixel may be written where a
+ * triangle only partly covers it. Each pixel is written with the farthest depth
+ * of the triangle's plane within the pixel, and boxes are tested against every
+ * pixel within one of their projection, so that a box that peeks past the edge
+ * of an occluder by less than a pixel is still seen through the uncovered
+ * neighbor. Triangles that cross the near plane are skipped rather than
+ * clipped, and boxes that cross it are never occluded.
+ */
+class OcclusionDepthBuffer {
+public:
+  OcclusionDepthBuffer();
+
+  /**
+   * @brief Clears the buffer for occluders seen by the given camera.
+   *
+   * @param viewState The camera.
+   * @param width The width of the buffer, in pixels. The height follows from
+   * the camera's aspect ratio.
+   */
+  void reset(const Cesium3DTilesSelection::ViewState& viewState, int32_t width);
+
+  /**
+   * @brief Discards the buffer's contents and camera.
+   */
+  void clear();
+
+  /**
+   * @brief Whether the buffer has a camera and at least one occluder.
+   */
+  bool hasOccluders() const noexcept { return this->_trianglesRasterized > 0; }
+
+  /**
+   * @brief Whether the buffer has been reset for a camera.
+   */
+  bool hasView() const noexcept { return this->_width > 0; }
+
+  /**
+   * @brief Whether the buffer's camera is at the same place, looking the same
+   * way, as the given one.
+   */
+  bool matchesView(const Cesium3DTilesSelection::ViewState& viewState) const;
+
+  /**
+   * @brief Whether the given camera is close enough to the buffer's camera for
+   * boxes seen by it to be tested against the buffer. The camera may have
+   * turned by less than a pixel, and moved by less than 1% of its height above
+   * the ellipsoid or one meter, whichever is larger.
+   */
+  bool isNearView(const Cesium3DTilesSelection::ViewState& viewState) const;
+
+  /**
+   * @brief Rasterizes the triangles of a glTF model.
+   *
+   * @param model The model.
+   * @param modelToEcef The transformation from the model's coordinates to ECEF
+   * coordinates.
+   * @param maximumTriangles The most triangles to rasterize. Primitives that
+   * would go over this are skipped.
+   * @return The number of triangles rasterized.
+   */
+  size_t rasterizeModel(
+      const CesiumGltf::Model& model,
+      const glm::dmat4& modelToEcef,
+      size_t maximumTriangles);
+
+  /**
+   * @brief Builds the hierarchy of farthest depths. Call this after the last
+   * occluder has been rasterized and before testing boxes.
+   */
+  void buildHierarchy();
+
+  /**
+   * @brief Determines whether an oriented bounding box is entirely behind the
+   * occluders.
+   *
+   * @param box The box, in ECEF coordinates.
+   * @param depthBias A distance, in meters, that the box is moved toward the
+   * camera before it is tested, to allow for occluders that are coarser than
+   * the geometry they stand in for.
+   */
+  bool isOccluded(
+      const CesiumGeometry::OrientedBoundingBox& box,
+      double depthBias) const;
+
+private:
+  struct ScreenVertex {
+    float x;
+    float y;
+    float inverseDepth;
+  };
+
+  void rasterizeTriangle(
+      const ScreenVertex& v0,
+      const ScreenVertex& v1,
+      const ScreenVertex& v2);
+
+  struct Level {
+    int32_t width;
+    int32_t height;
+    std::vector<float> inverseDepths;
+  };
+
+  glm::dvec3 _position;
+  glm::dvec3 _direction;
+  double _pixelAngle;
+  glm::dmat4 _ecefToView;
+  double _xScale;
+  double _yScale;
+  int32_t _width;
+  int32_t _height;
+  size_t _trianglesRasterized;
+  // Level zero is the full-resolution buffer.
+  std::vector<Level> _levels;
+  std::vector<ScreenVertex> _vertices;
+};
+
+/**
+ * @brief Culls the tiles of all tilesets that enable occlusion culling
+ * against the tiles that those tilesets rendered in the previous frame.
+ *
+ * Each frame, the tiles rendered by each such tileset are rasterized into a
+ * depth buffer for the camera, up to a scene-wide triangle budget. Tile
+ * selection in the next frame tests tile bounding volumes against that
+ * buffer, through cesium-native's tile occlusion proxies, so that hidden tiles
+ * are neither refined nor loaded. Only tilesets updated for a single camera
+ * take part, and tiles are only tested while the camera is still near the one
+ * the occluders were rasterized for, so a camera that moves or turns quickly
+ * gets no occlusion culling.
+ *
+ * This must only be used from the main thread.
+ */
+class SoftwareOcclusionCulling {
+public:
+  /**
+   * @brief Gets the occlusion culling shared by all tilesets.
+   */
+  static SoftwareOcclusionCulling& getInstance();
+
+  /**
+   * @brief Prepares to test the tiles of a tileset seen by a camera.
+   *
+   * If this is the first tileset update of a new tick, the occluders of the
+   * previous tick become the ones that tiles are tested against. Tiles are only
+   * tested if the camera is near the one those occluders were seen by.
+   *
+   * @param tick The {@link TilesetUpdateTick} of the update.
+   * @param viewState The camera that the tileset is updated for.
+   */
+  void beginTilesetUpdate(
+      uint64_t tick,
+      const Cesium3DTilesSelection::ViewState& viewState);
+
+  /**
+   * @brief Rasterizes the tiles that a tileset rendered for a camera.
+   */
+  void addOccluders(
+      const Cesium3DTilesSelection::ViewState& viewState,
+      const Cesium3DTilesSelection::ViewUpdateResult& result);
+
+  /**
+   * @brief Determines whether a tile is hidden behind the occluders of the
+   * previous tick.
+   */
+  Cesium3DTilesSelection::TileOcclusionState getOcclusionState(
+      const Cesium3DTilesSelection::Tile& tile,
+      const CesiumGeospatial::Ellipsoid& ellipsoid) const;
+
+private:
+  SoftwareOcclusionCulling();
+
+  uint64_t _tick;
+  size_t _trianglesRemaining;
+  // Occluders are rasterized into one buffer while tiles are tested against
+  // the other, which holds the previous tick's occluders.
+  OcclusionDepthBuffer _building;
+  OcclusionDepthBuffer _testing;
+  // Whether the camera of the current tileset update is near the one that the
+  // occluders being tested against were seen by.
+  bool _testingNearView;
+};
+
+/**
+ * @brief Provides cesium-native with tile occlusion proxies whose state comes
+ * from {@link SoftwareOcclusionCulling}.
+ */
+class SoftwareOcclusionProxyPool
+    : public Cesium3DTilesSelection::TileOcclusionRendererProxyPool {
+public:
+  SoftwareOcclusionProxyPool(const CesiumGeospatial::Ellipsoid& ellipsoid);
+  virtual ~SoftwareOcclusionProxyPool();
+
+  /**
+   * @brief Sets whether tiles are tested for occlusion. Tiles are never
+   * occluded while this is false.
+   */
+  void setEnabled(bool enabled) noexcept { this->_enabled = enabled; }
+
+protected:
+  virtual Cesium3DTilesSelection::TileOcclusionRendererProxy*
+  createProxy() override;
+  virtual void
+  destroyProxy(Cesium3DTilesSelection::TileOcclusionRendererProxy* pProxy)
+      override;
+
+private:
+  class Proxy;
+
+  CesiumGeospatial::Ellipsoid _ellipsoid;
+  bool _enabled;
+};
+
+} // namespace CesiumForUnityNative
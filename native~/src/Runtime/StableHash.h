@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief A 64-bit FNV-1a hash.
+ *
+ * Unlike `std::hash`, its result is the same on every platform, with every
+ * standard library, and in every run, as it must be for anything that is
+ * saved to disk and read back by a later session.
+ */
+class StableHash {
+public:
+  template <typename T> void add(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    this->addBytes(&value, sizeof(T));
+  }
+
+  void add(bool value) { this->add(uint8_t(value)); }
+
+  void add(const std::string& value) {
+    this->add(uint64_t(value.size()));
+    this->addBytes(value.data(), value.size());
+  }
+
+  uint64_t value() const noexcept { return this->_hash; }
+
+private:
+  void addBytes(const void* pData, size_t size) {
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+    for (size_t i = 0; i < size; ++i) {
+      this->_hash = (this->_hash ^ pBytes[i]) * 0x100000001b3;
+    }
+  }
+
+  uint64_t _hash = 0xcbf29ce484222325;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,797 @@
+#include "TerrainHeightCache.h"
+
+#include "LoadedTileHeightSampler.h"
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/Tileset.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/GltfUtilities.h>
+#include <CesiumUtility/Math.h>
+
+#include <glm/geometric.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
+using namespace CesiumUtility;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// The number of heights along each side of a grid is chosen from the number
+// of vertices in the tile, within these limits.
+constexpr int32_t minimumGridSize = 17;
+constexpr int32_t maximumGridSize = 257;
+
+// The deepest level of the quadtree. At this level a node spans about 20
+// meters.
+constexpr int32_t maximumQuadtreeLevel = 20;
+
+constexpr float missingHeight = std::numeric_limits<float>::quiet_NaN();
+
+// Triangles that are closer than this to vertical, such as skirts and walls,
+// hide no heights from above, so their vertices are not used to measure how
+// far a grid is from the triangles. This is the cosine of a slope of about
+// 84 degrees.
+constexpr double steepTriangleThreshold = 0.1;
+
+// The quadtree follows the geographic tiling scheme, with two nodes side by
+// side at level zero.
+int64_t getNodeX(double longitude, int32_t level) {
+  const int64_t columns = int64_t(2) << level;
+  const int64_t x =
+      int64_t(std::floor((longitude + Math::OnePi) / Math::TwoPi * columns));
+  return std::clamp(x, int64_t(0), columns - 1);
+}
+
+int64_t getNodeY(double latitude, int32_t level) {
+  const int64_t rows = int64_t(1) << level;
+  const int64_t y =
+      int64_t(std::floor((latitude + Math::PiOverTwo) / Math::OnePi * rows));
+  return std::clamp(y, int64_t(0), rows - 1);
+}
+
+uint64_t getNodeKey(int32_t level, int64_t x, int64_t y) {
+  return (uint64_t(level) << 48) | (uint64_t(y) << 24) | uint64_t(x);
+}
+
+// Whether a node at the given level or deeper overlaps a rectangle that does
+// not cross the antimeridian.
+bool nodeOverlaps(
+    uint64_t nodeKey,
+    int32_t minimumLevel,
+    const GlobeRectangle& rectangle) {
+  const int32_t level = int32_t(nodeKey >> 48);
+  const int64_t x = int64_t(nodeKey & 0xffffff);
+  const int64_t y = int64_t((nodeKey >> 24) & 0xffffff);
+  return level >= minimumLevel && x >= getNodeX(rectangle.getWest(), level) &&
+         x <= getNodeX(rectangle.getEast(), level) &&
+         y >= getNodeY(rectangle.getSouth(), level) &&
+         y <= getNodeY(rectangle.getNorth(), level);
+}
+
+// A tile whose vertices are spread evenly has about the square root of their
+// number along each side. Twice as many grid points puts one between each
+// pair of them.
+int32_t computeGridSize(size_t vertexCount) {
+  const double verticesPerSide = std::ceil(std::sqrt(double(vertexCount)));
+  return int32_t(std::clamp(
+      2.0 * verticesPerSide + 1.0,
+      double(minimumGridSize),
+      double(maximumGridSize)));
+}
+
+// Clears the heights of a grid within a rectangle.
+void clearHeights(
+    std::vector<float>& heights,
+    int32_t size,
+    const GlobeRectangle& gridRectangle,
+    const GlobeRectangle& rectangle) {
+  const double columnsPerRadian =
+      double(size - 1) / gridRectangle.computeWidth();
+  const double rowsPerRadian = double(size - 1) / gridRectangle.computeHeight();
+  const int32_t firstColumn = std::max(
+      int32_t(std::ceil(
+          (rectangle.getWest() - gridRectangle.getWest()) * columnsPerRadian)),
+      0);
+  const int32_t lastColumn = std::min(
+      int32_t(std::floor(
+          (rectangle.getEast() - gridRectangle.getWest()) * columnsPerRadian)),
+      size - 1);
+  const int32_t firstRow = std::max(
+      int32_t(std::ceil(
+          (rectangle.getSouth() - gridRectangle.getSouth()) * rowsPerRadian)),
+      0);
+  const int32_t lastRow = std::min(
+      int32_t(std::floor(
+          (rectangle.getNorth() - gridRectangle.getSouth()) * rowsPerRadian)),
+      size - 1);
+
+  for (int32_t row = firstRow; row <= lastRow; ++row) {
+    for (int32_t column = firstColumn; column <= lastColumn; ++column) {
+      heights[size_t(row * size + column)] = missingHeight;
+    }
+  }
+}
+
+bool hasHeights(const std::vector<float>& heights) {
+  return std::any_of(heights.begin(), heights.end(), [](float height) {
+    return !std::isnan(height);
+  });
+}
+
+// Bilinearly interpolates between the four heights around a position within
+// a grid's rectangle, or returns nothing if any of them is missing.
+std::optional<double> interpolateHeight(
+    const std::vector<float>& heights,
+    int32_t size,
+    const GlobeRectangle& rectangle,
+    double longitude,
+    double latitude) {
+  const double column = (longitude - rectangle.getWest()) * double(size - 1) /
+                        rectangle.computeWidth();
+  const double row = (latitude - rectangle.getSouth()) * double(size - 1) /
+                     rectangle.computeHeight();
+  const int32_t column0 = std::clamp(int32_t(std::floor(column)), 0, size - 2);
+  const int32_t row0 = std::clamp(int32_t(std::floor(row)), 0, size - 2);
+  const double s = std::clamp(column - double(column0), 0.0, 1.0);
+  const double t = std::clamp(row - double(row0), 0.0, 1.0);
+
+  const float* pRow0 = &heights[size_t(row0 * size + column0)];
+  const float* pRow1 = pRow0 + size;
+  const double southWest = pRow0[0];
+  const double southEast = pRow0[1];
+  const double northWest = pRow1[0];
+  const double northEast = pRow1[1];
+  if (std::isnan(southWest) || std::isnan(southEast) ||
+      std::isnan(northWest) || std::isnan(northEast)) {
+    return std::nullopt;
+  }
+
+  const double south = southWest + (southEast - southWest) * s;
+  const double north = northWest + (northEast - northWest) * s;
+  return south + (north - south) * t;
+}
+
+// Writes the heights of a triangle, given as longitude, latitude, and height,
+// at the grid points that it covers. Where triangles overlap, the highest
+// wins, as it would for a ray cast down from above.
+void rasterizeTriangle(
+    std::vector<float>& heights,
+    int32_t size,
+    const GlobeRectangle& rectangle,
+    const glm::dvec3& a,
+    const glm::dvec3& b,
+    const glm::dvec3& c) {
+  const double columnsPerRadian = double(size - 1) / rectangle.computeWidth();
+  const double rowsPerRadian = double(size - 1) / rectangle.computeHeight();
+
+  // Grid coordinates of the corners.
+  const glm::dvec2 p0(
+      (a.x - rectangle.getWest()) * columnsPerRadian,
+      (a.y - rectangle.getSouth()) * rowsPerRadian);
+  const glm::dvec2 p1(
+      (b.x - rectangle.getWest()) * columnsPerRadian,
+      (b.y - rectangle.getSouth()) * rowsPerRadian);
+  const glm::dvec2 p2(
+      (c.x - rectangle.getWest()) * columnsPerRadian,
+      (c.y - rectangle.getSouth()) * rowsPerRadian);
+
+  const double area =
+      (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+  if (std::abs(area) < 1e-12) {
+    // Walls and slivers cover no grid points.
+    return;
+  }
+
+  const int32_t firstColumn =
+      std::max(int32_t(std::ceil(std::min({p0.x, p1.x, p2.x}))), 0);
+  const int32_t lastColumn =
+      std::min(int32_t(std::floor(std::max({p0.x, p1.x, p2.x}))), size - 1);
+  const int32_t firstRow =
+      std::max(int32_t(std::ceil(std::min({p0.y, p1.y, p2.y}))), 0);
+  const int32_t lastRow =
+      std::min(int32_t(std::floor(std::max({p0.y, p1.y, p2.y}))), size - 1);
+
+  // Points on a shared edge belong to both triangles, so that there are no
+  // cracks between them.
+  constexpr double edgeTolerance = -1e-9;
+  const double inverseArea = 1.0 / area;
+  for (int32_t row = firstRow; row <= lastRow; ++row) {
+    for (int32_t column = firstColumn; column <= lastColumn; ++column) {
+      const double x = double(column);
+      const double y = double(row);
+      const double w0 =
+          ((p1.x - x) * (p2.y - y) - (p1.y - y) * (p2.x - x)) * inverseArea;
+      const double w1 =
+          ((p2.x - x) * (p0.y - y) - (p2.y - y) * (p0.x - x)) * inverseArea;
+      const double w2 = 1.0 - w0 - w1;
+      if (w0 < edgeTolerance || w1 < edgeTolerance || w2 < edgeTolerance) {
+        continue;
+      }
+
+      const float height = float(w0 * a.z + w1 * b.z + w2 * c.z);
+      float& cell = heights[size_t(row * size + column)];
+      if (std::isnan(cell) || height > cell) {
+        cell = height;
+      }
+    }
+  }
+}
+
+template <typename TIndex, typename Callback>
+void forEachIndexedTriangle(
+    const Model& model,
+    int32_t accessorID,
+    size_t vertexCount,
+    Callback&& callback) {
+  AccessorView<TIndex> indices(model, accessorID);
+  if (indices.status() != AccessorViewStatus::Valid) {
+    return;
+  }
+
+  for (int64_t i = 0; i + 2 < indices.size(); i += 3) {
+    size_t i0 = size_t(indices[i]);
+    size_t i1 = size_t(indices[i + 1]);
+    size_t i2 = size_t(indices[i + 2]);
+    if (i0 < vertexCount && i1 < vertexCount && i2 < vertexCount) {
+      callback(i0, i1, i2);
+    }
+  }
+}
+
+bool hasLoadedContent(const Tile& tile) {
+  return tile.getState() == TileLoadState::Done &&
+         tile.getContent().getRenderContent() != nullptr;
+}
+
+// A tile refined by addition, or below one, shares its surface with other
+// tiles, so a grid of its own triangles would be incomplete.
+bool isRefinedByReplacement(const Tile& tile) {
+  for (const Tile* pTile = &tile; pTile; pTile = pTile->getParent()) {
+    if (pTile->getRefine() == TileRefine::Add) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+TerrainHeightCache::TerrainHeightCache()
+    : _ellipsoid(Ellipsoid::WGS84), _grids(), _nodes() {}
+
+TerrainHeightCache::~TerrainHeightCache() = default;
+
+std::optional<TerrainHeightSample> TerrainHeightCache::sampleHeight(
+    const Tileset& tileset,
+    const Cartographic& position) {
+  this->_ellipsoid = tileset.getOptions().ellipsoid;
+
+  std::optional<TerrainHeightSample> cached = this->findHeight(position);
+  if (cached) {
+    return cached;
+  }
+
+  std::optional<LoadedTileHeightSample> sample =
+      LoadedTileHeightSampler::sampleHeight(tileset, position);
+  if (!sample) {
+    return std::nullopt;
+  }
+
+  const Tile& tile = *sample->pTile;
+  auto gridIt = this->_grids.find(&tile);
+  const bool extract = gridIt == this->_grids.end() || gridIt->second->stale;
+  if (extract && isRefinedByReplacement(tile) && this->extractGrid(tile)) {
+    cached = this->findHeight(position);
+    if (cached) {
+      return cached;
+    }
+  }
+
+  // The position falls between the grid's points, such as at the edge of a
+  // hole, so the height from the ray is used without caching it.
+  return TerrainHeightSample{sample->height, tile.getGeometricError()};
+}
+
+void TerrainHeightCache::tileLoaded(const Tile& tile) {
+  if (this->_grids.empty()) {
+    return;
+  }
+
+  std::optional<GlobeRectangle> maybeRectangle = this->getRectangle(tile);
+  if (maybeRectangle) {
+    this->tileLoaded(&tile, *maybeRectangle, tile.getGeometricError());
+  }
+}
+
+void TerrainHeightCache::tileLoaded(
+    const void* pTile,
+    const GlobeRectangle& rectangle,
+    double geometricError) {
+  std::vector<const void*> emptyGrids;
+  for (HeightGrid* pGrid : this->findGrids(rectangle)) {
+    if (pGrid->pTile == pTile || pGrid->geometricError <= geometricError) {
+      continue;
+    }
+
+    std::optional<GlobeRectangle> intersection =
+        pGrid->rectangle.computeIntersection(rectangle);
+    if (!intersection) {
+      continue;
+    }
+
+    clearHeights(pGrid->heights, pGrid->size, pGrid->rectangle, *intersection);
+    if (!hasHeights(pGrid->heights)) {
+      emptyGrids.emplace_back(pGrid->pTile);
+    }
+  }
+
+  for (const void* pGridTile : emptyGrids) {
+    this->eraseGrid(pGridTile);
+  }
+}
+
+void TerrainHeightCache::tileUnloaded(const Tile& tile) {
+  if (this->_grids.empty()) {
+    return;
+  }
+
+  std::optional<GlobeRectangle> maybeRectangle = this->getRectangle(tile);
+  if (maybeRectangle) {
+    this->tileUnloaded(&tile, *maybeRectangle, tile.getGeometricError());
+  } else {
+    this->eraseGrid(&tile);
+  }
+}
+
+void TerrainHeightCache::tileUnloaded(
+    const void* pTile,
+    const GlobeRectangle& rectangle,
+    double geometricError) {
+  this->eraseGrid(pTile);
+
+  // Coarser grids may have been cleared where this tile was, and are
+  // extracted again the next time a query lands there.
+  for (HeightGrid* pGrid : this->findGrids(rectangle)) {
+    if (pGrid->geometricError > geometricError &&
+        pGrid->rectangle.computeIntersection(rectangle)) {
+      pGrid->stale = true;
+    }
+  }
+}
+
+bool TerrainHeightCache::addGrid(
+    const void* pTile,
+    const GlobeRectangle& rectangle,
+    double geometricError,
+    const Model& model,
+    const glm::dmat4& modelToEcef,
+    const std::vector<GlobeRectangle>& finerRectangles) {
+  // Grids that cross the antimeridian are not cached.
+  if (rectangle.getWest() >= rectangle.getEast() ||
+      rectangle.getSouth() >= rectangle.getNorth()) {
+    return false;
+  }
+
+  size_t vertexCount = 0;
+  model.forEachPrimitiveInScene(
+      -1,
+      [&vertexCount](
+          const Model& gltf,
+          const Node& /*node*/,
+          const Mesh& /*mesh*/,
+          const MeshPrimitive& primitive,
+          const glm::dmat4& /*transform*/) {
+        if (primitive.mode != MeshPrimitive::Mode::TRIANGLES) {
+          return;
+        }
+
+        auto positionAccessorIt = primitive.attributes.find("POSITION");
+        if (positionAccessorIt == primitive.attributes.end()) {
+          return;
+        }
+
+        const Accessor* pPositionAccessor =
+            Model::getSafe(&gltf.accessors, positionAccessorIt->second);
+        if (pPositionAccessor) {
+          vertexCount += size_t(pPositionAccessor->count);
+        }
+      });
+
+  const int32_t size = computeGridSize(vertexCount);
+  std::vector<float> heights(size_t(size * size), missingHeight);
+
+  // The vertices of triangles that are not too steep, as longitude, latitude,
+  // and height.
+  std::vector<glm::dvec3> surfaceVertices;
+
+  const Ellipsoid& ellipsoid = this->_ellipsoid;
+  std::vector<glm::dvec3> positions;
+  std::vector<glm::dvec3> vertices;
+  std::vector<bool> onSurface;
+  model.forEachPrimitiveInScene(
+      -1,
+      [&heights,
+       size,
+       &rectangle,
+       &modelToEcef,
+       &ellipsoid,
+       &surfaceVertices,
+       &positions,
+       &vertices,
+       &onSurface](
+          const Model& gltf,
+          const Node& /*node*/,
+          const Mesh& /*mesh*/,
+          const MeshPrimitive& primitive,
+          const glm::dmat4& transform) {
+        if (primitive.mode != MeshPrimitive::Mode::TRIANGLES) {
+          return;
+        }
+
+        auto positionAccessorIt = primitive.attributes.find("POSITION");
+        if (positionAccessorIt == primitive.attributes.end()) {
+          return;
+        }
+
+        AccessorView<glm::vec3> positionView(gltf, positionAccessorIt->second);
+        if (positionView.status() != AccessorViewStatus::Valid) {
+          return;
+        }
+
+        // Each vertex in ECEF, and as longitude, latitude, and height.
+        const glm::dmat4 primitiveToEcef = modelToEcef * transform;
+        positions.resize(size_t(positionView.size()));
+        vertices.resize(size_t(positionView.size()));
+        onSurface.assign(size_t(positionView.size()), false);
+        for (int64_t i = 0; i < positionView.size(); ++i) {
+          const glm::dvec3 ecef(
+              primitiveToEcef * glm::dvec4(glm::dvec3(positionView[i]), 1.0));
+          std::optional<Cartographic> cartographic =
+              ellipsoid.cartesianToCartographic(ecef);
+          positions[size_t(i)] = ecef;
+          vertices[size_t(i)] =
+              cartographic ? glm::dvec3(
+                                 cartographic->longitude,
+                                 cartographic->latitude,
+                                 cartographic->height)
+                           : glm::dvec3(missingHeight);
+        }
+
+        auto rasterize = [&heights,
+                          size,
+                          &rectangle,
+                          &ellipsoid,
+                          &positions,
+                          &vertices,
+                          &onSurface](size_t i0, size_t i1, size_t i2) {
+          const glm::dvec3& a = vertices[i0];
+          const glm::dvec3& b = vertices[i1];
+          const glm::dvec3& c = vertices[i2];
+          if (std::isnan(a.z) || std::isnan(b.z) || std::isnan(c.z)) {
+            return;
+          }
+          rasterizeTriangle(heights, size, rectangle, a, b, c);
+
+          const glm::dvec3 normal = glm::cross(
+              positions[i1] - positions[i0],
+              positions[i2] - positions[i0]);
+          const glm::dvec3 up = ellipsoid.geodeticSurfaceNormal(positions[i0]);
+          if (std::abs(glm::dot(normal, up)) >
+              steepTriangleThreshold * glm::length(normal)) {
+            onSurface[i0] = true;
+            onSurface[i1] = true;
+            onSurface[i2] = true;
+          }
+        };
+
+        const size_t vertexCount = vertices.size();
+        const Accessor* pIndexAccessor =
+            Model::getSafe(&gltf.accessors, primitive.indices);
+        if (!pIndexAccessor) {
+          for (size_t i = 0; i + 2 < vertexCount; i += 3) {
+            rasterize(i, i + 1, i + 2);
+          }
+        } else if (
+            pIndexAccessor->componentType ==
+            Accessor::ComponentType::UNSIGNED_BYTE) {
+          forEachIndexedTriangle<uint8_t>(
+              gltf,
+              primitive.indices,
+              vertexCount,
+              rasterize);
+        } else if (
+            pIndexAccessor->componentType ==
+            Accessor::ComponentType::UNSIGNED_SHORT) {
+          forEachIndexedTriangle<uint16_t>(
+              gltf,
+              primitive.indices,
+              vertexCount,
+              rasterize);
+        } else if (
+            pIndexAccessor->componentType ==
+            Accessor::ComponentType::UNSIGNED_INT) {
+          forEachIndexedTriangle<uint32_t>(
+              gltf,
+              primitive.indices,
+              vertexCount,
+              rasterize);
+        }
+
+        for (size_t i = 0; i < vertexCount; ++i) {
+          if (onSurface[i]) {
+            surfaceVertices.emplace_back(vertices[i]);
+          }
+        }
+      });
+
+  // Between its points, the grid cuts across the peaks and valleys of the
+  // triangles, by the most at their vertices.
+  double resamplingError = 0.0;
+  for (const glm::dvec3& vertex : surfaceVertices) {
+    if (!rectangle.contains(Cartographic(vertex.x, vertex.y))) {
+      continue;
+    }
+
+    std::optional<double> height =
+        interpolateHeight(heights, size, rectangle, vertex.x, vertex.y);
+    if (height) {
+      resamplingError = std::max(resamplingError, std::abs(*height - vertex.z));
+    }
+  }
+
+  for (const GlobeRectangle& finerRectangle : finerRectangles) {
+    std::optional<GlobeRectangle> intersection =
+        rectangle.computeIntersection(finerRectangle);
+    if (intersection) {
+      clearHeights(heights, size, rectangle, *intersection);
+    }
+  }
+
+  if (!hasHeights(heights)) {
+    return false;
+  }
+
+  this->insertGrid(std::make_unique<HeightGrid>(HeightGrid{
+      pTile,
+      rectangle,
+      geometricError,
+      resamplingError,
+      {},
+      false,
+      size,
+      std::move(heights)}));
+  return true;
+}
+
+std::optional<TerrainHeightSample>
+TerrainHeightCache::findHeight(const Cartographic& position) const {
+  std::optional<TerrainHeightSample> result;
+  const HeightGrid* pResultGrid = nullptr;
+  for (int32_t level = 0; level <= maximumQuadtreeLevel; ++level) {
+    auto nodeIt = this->_nodes.find(getNodeKey(
+        level,
+        getNodeX(position.longitude, level),
+        getNodeY(position.latitude, level)));
+    if (nodeIt == this->_nodes.end()) {
+      continue;
+    }
+
+    for (const HeightGrid* pGrid : nodeIt->second) {
+      if ((pResultGrid &&
+           pGrid->geometricError >= pResultGrid->geometricError) ||
+          !pGrid->rectangle.contains(position)) {
+        continue;
+      }
+
+      std::optional<double> height = interpolateHeight(
+          pGrid->heights,
+          pGrid->size,
+          pGrid->rectangle,
+          position.longitude,
+          position.latitude);
+      if (!height) {
+        continue;
+      }
+
+      result = TerrainHeightSample{
+          *height,
+          pGrid->geometricError + pGrid->resamplingError};
+      pResultGrid = pGrid;
+    }
+  }
+
+  return result;
+}
+
+bool TerrainHeightCache::extractGrid(const Tile& tile) {
+  const TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+  if (!pRenderContent) {
+    return false;
+  }
+
+  std::optional<GlobeRectangle> maybeRectangle = this->getRectangle(tile);
+  if (!maybeRectangle) {
+    return false;
+  }
+
+  const Model& model = pRenderContent->getModel();
+  glm::dmat4 modelToEcef = tile.getTransform();
+  modelToEcef = GltfUtilities::applyRtcCenter(model, modelToEcef);
+  modelToEcef = GltfUtilities::applyGltfUpAxisTransform(model, modelToEcef);
+
+  // More detailed tiles that are already loaded take precedence where they
+  // are.
+  std::vector<GlobeRectangle> finerRectangles;
+  std::vector<const Tile*> tilesToVisit;
+  for (const Tile& child : tile.getChildren()) {
+    tilesToVisit.emplace_back(&child);
+  }
+  while (!tilesToVisit.empty()) {
+    const Tile* pTile = tilesToVisit.back();
+    tilesToVisit.pop_back();
+    if (!hasLoadedContent(*pTile)) {
+      for (const Tile& child : pTile->getChildren()) {
+        tilesToVisit.emplace_back(&child);
+      }
+      continue;
+    }
+
+    std::optional<GlobeRectangle> maybeChildRectangle =
+        this->getRectangle(*pTile);
+    if (maybeChildRectangle) {
+      finerRectangles.emplace_back(*maybeChildRectangle);
+    }
+  }
+
+  return this->addGrid(
+      &tile,
+      *maybeRectangle,
+      tile.getGeometricError(),
+      model,
+      modelToEcef,
+      finerRectangles);
+}
+
+void TerrainHeightCache::insertGrid(std::unique_ptr<HeightGrid>&& pGrid) {
+  this->eraseGrid(pGrid->pTile);
+
+  // The deepest level at which the rectangle overlaps no more than two nodes
+  // in each direction. Every rectangle does at level zero, which has only two
+  // nodes.
+  const GlobeRectangle& rectangle = pGrid->rectangle;
+  int32_t level = maximumQuadtreeLevel;
+  for (; level > 0; --level) {
+    const int64_t columns = getNodeX(rectangle.getEast(), level) -
+                            getNodeX(rectangle.getWest(), level) + 1;
+    const int64_t rows = getNodeY(rectangle.getNorth(), level) -
+                         getNodeY(rectangle.getSouth(), level) + 1;
+    if (columns <= 2 && rows <= 2) {
+      break;
+    }
+  }
+
+  // The grid goes in each of those nodes, so that a small tile straddling a
+  // node boundary, such as the prime meridian, is found from either side of
+  // it.
+  HeightGrid* pGridInNodes = pGrid.get();
+  for (int64_t y = getNodeY(rectangle.getSouth(), level);
+       y <= getNodeY(rectangle.getNorth(), level);
+       ++y) {
+    for (int64_t x = getNodeX(rectangle.getWest(), level);
+         x <= getNodeX(rectangle.getEast(), level);
+         ++x) {
+      const uint64_t nodeKey = getNodeKey(level, x, y);
+      pGrid->nodeKeys.emplace_back(nodeKey);
+      this->_nodes[nodeKey].emplace_back(pGridInNodes);
+    }
+  }
+
+  this->_grids.emplace(pGrid->pTile, std::move(pGrid));
+}
+
+std::vector<TerrainHeightCache::HeightGrid*>
+TerrainHeightCache::findGrids(const GlobeRectangle& rectangle) const {
+  std::vector<HeightGrid*> result;
+
+  // A rectangle that crosses the antimeridian is looked up as its two halves.
+  if (rectangle.getWest() > rectangle.getEast()) {
+    for (const GlobeRectangle& half :
+         {GlobeRectangle(
+              rectangle.getWest(),
+              rectangle.getSouth(),
+              Math::OnePi,
+              rectangle.getNorth()),
+          GlobeRectangle(
+              -Math::OnePi,
+              rectangle.getSouth(),
+              rectangle.getEast(),
+              rectangle.getNorth())}) {
+      std::vector<HeightGrid*> grids = this->findGrids(half);
+      result.insert(result.end(), grids.begin(), grids.end());
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+  }
+
+  for (int32_t level = 0; level <= maximumQuadtreeLevel; ++level) {
+    const int64_t west = getNodeX(rectangle.getWest(), level);
+    const int64_t east = getNodeX(rectangle.getEast(), level);
+    const int64_t south = getNodeY(rectangle.getSouth(), level);
+    const int64_t north = getNodeY(rectangle.getNorth(), level);
+
+    // A rectangle overlaps about four times as many nodes at each level as at
+    // the one above it. Once that is more than the number of nodes that hold
+    // grids, it is quicker to check each of those for the remaining levels.
+    if (uint64_t((east - west + 1) * (north - south + 1)) >
+        this->_nodes.size()) {
+      for (const auto& [nodeKey, grids] : this->_nodes) {
+        if (nodeOverlaps(nodeKey, level, rectangle)) {
+          result.insert(result.end(), grids.begin(), grids.end());
+        }
+      }
+      break;
+    }
+
+    for (int64_t y = south; y <= north; ++y) {
+      for (int64_t x = west; x <= east; ++x) {
+        auto nodeIt = this->_nodes.find(getNodeKey(level, x, y));
+        if (nodeIt != this->_nodes.end()) {
+          result.insert(
+              result.end(),
+              nodeIt->second.begin(),
+              nodeIt->second.end());
+        }
+      }
+    }
+  }
+
+  // A grid is in every node that it overlaps, so it may have been found more
+  // than once.
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+void TerrainHeightCache::eraseGrid(const void* pTile) {
+  auto gridIt = this->_grids.find(pTile);
+  if (gridIt == this->_grids.end()) {
+    return;
+  }
+
+  for (uint64_t nodeKey : gridIt->second->nodeKeys) {
+    auto nodeIt = this->_nodes.find(nodeKey);
+    if (nodeIt != this->_nodes.end()) {
+      std::erase(nodeIt->second, gridIt->second.get());
+      if (nodeIt->second.empty()) {
+        this->_nodes.erase(nodeIt);
+      }
+    }
+  }
+
+  this->_grids.erase(gridIt);
+}
+
+std::optional<GlobeRectangle>
+TerrainHeightCache::getRectangle(const Tile& tile) const {
+  return estimateGlobeRectangle(tile.getBoundingVolume(), this->_ellipsoid);
+}
+
+} // namespace CesiumForUnityNative
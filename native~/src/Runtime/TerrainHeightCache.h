@@ -0,0 +1,201 @@
+#pragma once
+
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+class Tileset;
+} // namespace Cesium3DTilesSelection
+
+namespace CesiumGeospatial {
+class Cartographic;
+}
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief A height sampled from a {@link TerrainHeightCache}.
+ */
+struct TerrainHeightSample {
+  /**
+   * @brief The height above the ellipsoid, in meters.
+   */
+  double height;
+
+  /**
+   * @brief An estimate of the error in the height, in meters: the geometric
+   * error of the tile that the height came from, plus the most that the
+   * tile's grid of heights differs from its triangles at their vertices. A
+   * larger error means a coarser tile.
+   */
+  double geometricError;
+};
+
+/**
+ * @brief Caches grids of heights extracted from a tileset's loaded tiles, so
+ * that repeated height queries over the same area are answered without
+ * intersecting the tiles' geometry again.
+ *
+ * The first query that lands on a tile casts a ray against the loaded tiles,
+ * as {@link LoadedTileHeightSampler} does, and then rasterizes the triangles
+ * of the tile that was hit into a grid of heights over its longitude and
+ * latitude, with about two grid points for each vertex along each side. Later
+ * queries in that tile are bilinearly interpolated from the grid. Grids are
+ * indexed by a geodetic quadtree, so that the grid of the most detailed tile
+ * at a position is found with a handful of lookups.
+ *
+ * A grid is discarded when its tile is unloaded. When a more detailed tile is
+ * loaded, the part of each coarser grid that it covers is cleared, so that
+ * queries there move on to the new tile.
+ *
+ * This must only be used from the main thread.
+ */
+class TerrainHeightCache {
+public:
+  TerrainHeightCache();
+  ~TerrainHeightCache();
+
+  /**
+   * @brief Samples the height of a tileset at a position from its loaded
+   * tiles, without loading any more.
+   *
+   * @param tileset The tileset whose tiles are cached.
+   * @param position The position. Its height is ignored.
+   * @return The sampled height, or nothing if no loaded tile has geometry at
+   * the position.
+   */
+  std::optional<TerrainHeightSample> sampleHeight(
+      const Cesium3DTilesSelection::Tileset& tileset,
+      const CesiumGeospatial::Cartographic& position);
+
+  /**
+   * @brief Clears the parts of coarser grids that a newly-loaded tile covers.
+   */
+  void tileLoaded(const Cesium3DTilesSelection::Tile& tile);
+
+  /**
+   * @brief Clears the parts of coarser grids that a newly-loaded tile covers.
+   *
+   * @param pTile An identifier for the tile.
+   * @param rectangle The tile's rectangle.
+   * @param geometricError The tile's geometric error. Only grids with a larger
+   * error are cleared.
+   */
+  void tileLoaded(
+      const void* pTile,
+      const CesiumGeospatial::GlobeRectangle& rectangle,
+      double geometricError);
+
+  /**
+   * @brief Discards the grid of a tile that is being unloaded.
+   */
+  void tileUnloaded(const Cesium3DTilesSelection::Tile& tile);
+
+  /**
+   * @brief Discards the grid of a tile that is being unloaded, and marks the
+   * coarser grids that it overlaps to be extracted again.
+   *
+   * @param pTile An identifier for the tile.
+   * @param rectangle The tile's rectangle.
+   * @param geometricError The tile's geometric error.
+   */
+  void tileUnloaded(
+      const void* pTile,
+      const CesiumGeospatial::GlobeRectangle& rectangle,
+      double geometricError);
+
+  /**
+   * @brief Rasterizes the triangles of a tile's model into a grid of heights
+   * and caches it, replacing any grid that the tile already has.
+   *
+   * {@link sampleHeight} does this for the tile that a query lands on.
+   *
+   * @param pTile An identifier for the tile.
+   * @param rectangle The tile's rectangle, which must not cross the
+   * antimeridian. Geometry outside of it is ignored.
+   * @param geometricError The tile's geometric error. Where grids overlap, the
+   * one with the smallest error is used.
+   * @param model The tile's model.
+   * @param modelToEcef The transformation from the model's coordinates to
+   * ECEF, including its RTC center and up axis.
+   * @param finerRectangles The rectangles of more detailed tiles that are
+   * already loaded. The grid is cleared within them.
+   * @return Whether a grid was cached. It is not if the model has no triangles
+   * within the rectangle.
+   */
+  bool addGrid(
+      const void* pTile,
+      const CesiumGeospatial::GlobeRectangle& rectangle,
+      double geometricError,
+      const CesiumGltf::Model& model,
+      const glm::dmat4& modelToEcef,
+      const std::vector<CesiumGeospatial::GlobeRectangle>& finerRectangles);
+
+  /**
+   * @brief Samples a height from the cached grids alone.
+   *
+   * @param position The position. Its height is ignored.
+   * @return The height from the most detailed grid with heights around the
+   * position, or nothing if there is none.
+   */
+  std::optional<TerrainHeightSample>
+  findHeight(const CesiumGeospatial::Cartographic& position) const;
+
+  /**
+   * @brief Gets the number of tiles whose heights are cached.
+   */
+  size_t getGridCount() const noexcept { return this->_grids.size(); }
+
+private:
+  struct HeightGrid {
+    const void* pTile;
+    CesiumGeospatial::GlobeRectangle rectangle;
+    double geometricError;
+    // The most that the grid differs from the tile's triangles at their
+    // vertices, which is added to the geometric error of its heights.
+    double resamplingError;
+    // The keys of the quadtree nodes that the grid is in.
+    std::vector<uint64_t> nodeKeys;
+    // Whether a more detailed tile that cleared part of this grid has since
+    // been unloaded, so that the grid should be extracted again.
+    bool stale;
+    // The number of heights along each side.
+    int32_t size;
+    // Heights at evenly-spaced longitudes and latitudes, from the
+    // south-west corner, row by row. NaN where there is no geometry. Floats
+    // are precise to a millimeter or so at any height on Earth.
+    std::vector<float> heights;
+  };
+
+  bool extractGrid(const Cesium3DTilesSelection::Tile& tile);
+  void insertGrid(std::unique_ptr<HeightGrid>&& pGrid);
+  // The grids in the quadtree nodes that a rectangle overlaps, each once.
+  // Their own rectangles may not overlap it.
+  std::vector<HeightGrid*>
+  findGrids(const CesiumGeospatial::GlobeRectangle& rectangle) const;
+  void eraseGrid(const void* pTile);
+  std::optional<CesiumGeospatial::GlobeRectangle>
+  getRectangle(const Cesium3DTilesSelection::Tile& tile) const;
+
+  CesiumGeospatial::Ellipsoid _ellipsoid;
+  std::unordered_map<const void*, std::unique_ptr<HeightGrid>> _grids;
+  // The grids in each node of the quadtree, by the node's key. A grid is in
+  // every node that its rectangle overlaps, at the deepest level where it
+  // overlaps no more than two by two nodes.
+  std::unordered_map<uint64_t, std::vector<HeightGrid*>> _nodes;
+};
+
+} // namespace CesiumForUnityNative
@@ -4,6 +4,7 @@
 #include <CesiumGltf/Sampler.h>
 #include <CesiumUtility/Tracing.h>
 
+#include <DotNet/CesiumForUnity/CesiumRasterOverlayTexturePool.h>
 #include <DotNet/Unity/Collections/LowLevel/Unsafe/NativeArrayUnsafeUtility.h>
 #include <DotNet/Unity/Collections/NativeArray1.h>
 #include <DotNet/UnityEngine/FilterMode.h>
@@ -70,27 +71,25 @@ getUncompressedPixelFormat(const CesiumImage::ImageAsset& image) {
   }
 }
 
-} // namespace
-
-UnityEngine::Texture
-TextureLoader::loadTexture(const CesiumImage::ImageAsset& image, bool sRGB) {
-  CESIUM_TRACE("TextureLoader::loadTexture");
-  std::int32_t mipCount =
-      image.mipPositions.empty() ? 1 : std::int32_t(image.mipPositions.size());
-
-  UnityEngine::TextureFormat textureFormat;
+UnityEngine::TextureFormat
+getTextureFormat(const CesiumImage::ImageAsset& image) {
   if (image.compressedPixelFormat != GpuCompressedPixelFormat::NONE) {
-    textureFormat = getCompressedPixelFormat(image);
+    return getCompressedPixelFormat(image);
   } else {
-    textureFormat = getUncompressedPixelFormat(image);
+    return getUncompressedPixelFormat(image);
   }
+}
 
-  UnityEngine::Texture2D
-      result(image.width, image.height, textureFormat, mipCount, !sRGB);
-  result.hideFlags(UnityEngine::HideFlags::HideAndDontSave);
+std::int32_t getMipCount(const CesiumImage::ImageAsset& image) {
+  return image.mipPositions.empty() ? 1
+                                    : std::int32_t(image.mipPositions.size());
+}
 
+void copyPixelData(
+    const CesiumImage::ImageAsset& image,
+    UnityEngine::Texture2D& texture) {
   Unity::Collections::NativeArray1<std::uint8_t> textureData =
-      result.GetRawTextureData<std::uint8_t>();
+      texture.GetRawTextureData<std::uint8_t>();
   std::uint8_t* pixels = static_cast<std::uint8_t*>(
       Unity::Collections::LowLevel::Unsafe::NativeArrayUnsafeUtility::
           GetUnsafeBufferPointerWithoutChecks(textureData));
@@ -102,7 +101,6 @@ TextureLoader::loadTexture(const CesiumImage::ImageAsset& image, bool sRGB) {
     // No mipmaps, copy the whole thing and then let Unity generate mipmaps on a
     // worker thread.
     std::memcpy(pixels, image.pixelData.data(), image.pixelData.size());
-    result.Apply(false, true);
   } else {
     // Copy the mipmaps explicitly.
     std::uint8_t* pWritePosition = pixels;
@@ -117,9 +115,45 @@ TextureLoader::loadTexture(const CesiumImage::ImageAsset& image, bool sRGB) {
       std::memcpy(pWritePosition, pReadBuffer + start, mip.byteSize);
       pWritePosition += mip.byteSize;
     }
-
-    result.Apply(false, true);
   }
+}
+
+} // namespace
+
+UnityEngine::Texture
+TextureLoader::loadTexture(const CesiumImage::ImageAsset& image, bool sRGB) {
+  CESIUM_TRACE("TextureLoader::loadTexture");
+  UnityEngine::Texture2D result(
+      image.width,
+      image.height,
+      getTextureFormat(image),
+      getMipCount(image),
+      !sRGB);
+  result.hideFlags(UnityEngine::HideFlags::HideAndDontSave);
+
+  copyPixelData(image, result);
+  result.Apply(false, true);
+
+  return result;
+}
+
+UnityEngine::Texture TextureLoader::loadPooledTexture(
+    const CesiumImage::ImageAsset& image,
+    bool sRGB) {
+  CESIUM_TRACE("TextureLoader::loadPooledTexture");
+  UnityEngine::Texture2D result =
+      CesiumForUnity::CesiumRasterOverlayTexturePool::Get(
+          image.width,
+          image.height,
+          getTextureFormat(image),
+          getMipCount(image),
+          !sRGB);
+
+  copyPixelData(image, result);
+
+  // Keep the texture readable so that its pixels can be replaced when it is
+  // reused.
+  result.Apply(false, false);
 
   return result;
 }
@@ -212,4 +246,35 @@ UnityEngine::Texture TextureLoader::loadTexture(
   return unityTexture;
 }
 
+int64_t
+TextureLoader::computeByteSize(const CesiumImage::ImageAsset& image) {
+  // The texture holds exactly the levels copied from the image. Unity frees
+  // its own copy of the pixels once the texture is no longer readable.
+  if (image.mipPositions.empty()) {
+    return int64_t(image.pixelData.size());
+  }
+
+  int64_t bytes = 0;
+  for (const ImageAssetMipPosition& mip : image.mipPositions) {
+    bytes += int64_t(mip.byteSize);
+  }
+  return bytes;
+}
+
+int64_t TextureLoader::computeByteSize(
+    const CesiumGltf::Model& model,
+    std::int32_t textureIndex) {
+  const Texture* pTexture = Model::getSafe(&model.textures, textureIndex);
+  if (!pTexture) {
+    return 0;
+  }
+
+  const Image* pImage = Model::getSafe(&model.images, pTexture->source);
+  if (!pImage || !pImage->pAsset) {
+    return 0;
+  }
+
+  return TextureLoader::computeByteSize(*pImage->pAsset);
+}
+
 } // namespace CesiumForUnityNative
@@ -22,6 +22,15 @@ public:
   static ::DotNet::UnityEngine::Texture
   loadTexture(const CesiumImage::ImageAsset& image, bool sRGB);
 
+  /**
+   * @brief Loads an image into a texture from the
+   * `CesiumRasterOverlayTexturePool`. The texture is left readable so that it
+   * can be reused, and should be returned to the pool when it is no longer
+   * needed.
+   */
+  static ::DotNet::UnityEngine::Texture
+  loadPooledTexture(const CesiumImage::ImageAsset& image, bool sRGB);
+
   static ::DotNet::UnityEngine::Texture loadTexture(
       const CesiumGltf::Model& model,
       std::int32_t textureIndex,
@@ -31,6 +40,20 @@ public:
       const CesiumGltf::Model& model,
       const CesiumGltf::Texture& texture,
       bool sRGB);
+
+  /**
+   * @brief Computes the size of the pixel data, including all mip levels, of
+   * a texture loaded from the given image, in bytes.
+   */
+  static std::int64_t computeByteSize(const CesiumImage::ImageAsset& image);
+
+  /**
+   * @brief Computes the size of the pixel data of the texture loaded for the
+   * glTF texture with the given index, in bytes, or zero if there is no such
+   * texture.
+   */
+  static std::int64_t
+  computeByteSize(const CesiumGltf::Model& model, std::int32_t textureIndex);
 };
 
 } // namespace CesiumForUnityNative
@@ -0,0 +1,238 @@
+#include "TileLifecycleTracer.h"
+
+#include <CesiumGltf/Model.h>
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// Beyond this, new events are dropped so that a forgotten trace can't use
+// unbounded memory. Each event takes 72 bytes on 64-bit platforms, plus a heap
+// allocation for any URL too long for the string's inline buffer, so a full
+// trace uses around 40 MB before counting URLs.
+constexpr size_t maximumEventCount = 512 * 1024;
+
+struct TraceEvent {
+  const char* name;
+  char phase;
+  uint64_t traceID;
+  int64_t timestamp;
+  size_t threadID;
+  std::string url;
+};
+
+std::mutex eventsMutex;
+std::vector<TraceEvent> events;
+size_t droppedEventCount = 0;
+
+// Handoffs from requests that never reach the renderer, such as tileset.json
+// and raster overlay images, are never consumed. The map is simply cleared if
+// it grows too large.
+constexpr size_t maximumHandoffCount = 64 * 1024;
+std::unordered_map<uint64_t, int64_t> handoffs;
+
+int64_t now() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+size_t currentThreadID() {
+  return std::hash<std::thread::id>{}(std::this_thread::get_id());
+}
+
+// Must be called with eventsMutex held.
+void add(TraceEvent&& event) {
+  if (events.size() >= maximumEventCount) {
+    ++droppedEventCount;
+    return;
+  }
+  events.emplace_back(std::move(event));
+}
+
+void record(
+    uint64_t traceID,
+    const char* name,
+    char phase,
+    const std::string& url = {}) {
+  if (traceID == 0 || !TileLifecycleTracer::isEnabled()) {
+    return;
+  }
+
+  TraceEvent event{name, phase, traceID, now(), currentThreadID(), url};
+
+  std::lock_guard<std::mutex> lock(eventsMutex);
+  add(std::move(event));
+}
+
+std::string escapeJson(const std::string& value) {
+  std::string result;
+  result.reserve(value.size());
+  for (char c : value) {
+    switch (c) {
+    case '"':
+      result += "\\\"";
+      break;
+    case '\\':
+      result += "\\\\";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        result += fmt::format("\\u{:04x}", int(c));
+      } else {
+        result += c;
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+std::atomic<bool> TileLifecycleTracer::_enabled{false};
+
+/*static*/ void TileLifecycleTracer::setEnabled(bool enabled) {
+  TileLifecycleTracer::_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/*static*/ uint64_t TileLifecycleTracer::getTraceID(const std::string& url) {
+  if (!TileLifecycleTracer::isEnabled() || url.empty()) {
+    return 0;
+  }
+
+  // Zero is reserved for tiles that aren't traced.
+  uint64_t traceID = std::hash<std::string>{}(url);
+  return traceID == 0 ? 1 : traceID;
+}
+
+/*static*/ uint64_t
+TileLifecycleTracer::getTraceID(const CesiumGltf::Model& model) {
+  if (!TileLifecycleTracer::isEnabled()) {
+    return 0;
+  }
+
+  auto urlIt = model.extras.find("Cesium3DTiles_TileUrl");
+  if (urlIt == model.extras.end()) {
+    return 0;
+  }
+
+  return TileLifecycleTracer::getTraceID(urlIt->second.getStringOrDefault(""));
+}
+
+/*static*/ void TileLifecycleTracer::begin(
+    uint64_t traceID,
+    const char* name,
+    const std::string& url) {
+  record(traceID, name, 'b', url);
+}
+
+/*static*/ void TileLifecycleTracer::end(uint64_t traceID, const char* name) {
+  record(traceID, name, 'e');
+}
+
+/*static*/ void TileLifecycleTracer::endAndBegin(
+    uint64_t traceID,
+    const char* endName,
+    const char* beginName) {
+  record(traceID, endName, 'e');
+  record(traceID, beginName, 'b');
+}
+
+/*static*/ void
+TileLifecycleTracer::handoff(uint64_t traceID, const char* endName) {
+  if (traceID == 0 || !TileLifecycleTracer::isEnabled()) {
+    return;
+  }
+
+  int64_t timestamp = now();
+
+  std::lock_guard<std::mutex> lock(eventsMutex);
+  add(TraceEvent{endName, 'e', traceID, timestamp, currentThreadID(), {}});
+  if (handoffs.size() >= maximumHandoffCount) {
+    handoffs.clear();
+  }
+  handoffs[traceID] = timestamp;
+}
+
+/*static*/ void
+TileLifecycleTracer::spanFromHandoff(uint64_t traceID, const char* name) {
+  if (traceID == 0 || !TileLifecycleTracer::isEnabled()) {
+    return;
+  }
+
+  int64_t timestamp = now();
+  size_t threadID = currentThreadID();
+
+  std::lock_guard<std::mutex> lock(eventsMutex);
+  auto it = handoffs.find(traceID);
+  if (it == handoffs.end()) {
+    return;
+  }
+  add(TraceEvent{name, 'b', traceID, it->second, threadID, {}});
+  add(TraceEvent{name, 'e', traceID, timestamp, threadID, {}});
+  handoffs.erase(it);
+}
+
+/*static*/ void
+TileLifecycleTracer::instant(uint64_t traceID, const char* name) {
+  record(traceID, name, 'n');
+}
+
+/*static*/ bool TileLifecycleTracer::write(const std::string& path) {
+  std::vector<TraceEvent> snapshot;
+  size_t dropped;
+  {
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    snapshot = events;
+    dropped = droppedEventCount;
+  }
+
+  std::ofstream stream(path, std::ios::out | std::ios::trunc);
+  if (!stream) {
+    return false;
+  }
+
+  stream << "{\"otherData\":{\"droppedEvents\":" << dropped
+         << "},\"traceEvents\":[";
+
+  bool first = true;
+  for (const TraceEvent& event : snapshot) {
+    stream << (first ? "\n" : ",\n");
+    first = false;
+
+    stream << fmt::format(
+        "{{\"name\":\"{}\",\"cat\":\"tile\",\"ph\":\"{}\",\"id\":\"0x{:x}\","
+        "\"ts\":{},\"pid\":1,\"tid\":{}",
+        event.name,
+        event.phase,
+        event.traceID,
+        event.timestamp,
+        event.threadID % 1000000);
+    if (!event.url.empty()) {
+      stream << ",\"args\":{\"url\":\"" << escapeJson(event.url) << "\"}";
+    }
+    stream << "}";
+  }
+
+  stream << "\n]}\n";
+  return bool(stream);
+}
+
+/*static*/ void TileLifecycleTracer::clear() {
+  std::lock_guard<std::mutex> lock(eventsMutex);
+  events.clear();
+  droppedEventCount = 0;
+  handoffs.clear();
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Records the stages that each tile passes through as it loads, as
+ * asynchronous spans that can be written to a Chrome trace file.
+ *
+ * Unlike `CESIUM_TRACE`, this is available in every build and is toggled at
+ * runtime with `CesiumForUnity.CesiumTileTracing`. Spans are keyed by a hash of
+ * the tile's content URL, so every stage of one tile appears on the same track
+ * in `chrome://tracing` or Perfetto. A trace ID of zero means the tile is not
+ * being traced, and every method does nothing when given one.
+ *
+ * All methods may be called from any thread.
+ */
+class TileLifecycleTracer {
+public:
+  /**
+   * @brief Whether tracing is currently enabled.
+   */
+  static bool isEnabled() noexcept {
+    return TileLifecycleTracer::_enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Starts or stops recording new spans. Spans that were already
+   * recorded are kept until {@link clear} is called.
+   */
+  static void setEnabled(bool enabled);
+
+  /**
+   * @brief Gets the trace ID of the tile with the given content URL, or zero
+   * if tracing is disabled.
+   */
+  static uint64_t getTraceID(const std::string& url);
+
+  /**
+   * @brief Gets the trace ID of the tile that a glTF was loaded from, using
+   * the URL that cesium-native stores in its extras, or zero if tracing is
+   * disabled or the URL is unknown.
+   */
+  static uint64_t getTraceID(const CesiumGltf::Model& model);
+
+  /**
+   * @brief Begins a span for a tile. If given, the URL is recorded with the
+   * span.
+   */
+  static void
+  begin(uint64_t traceID, const char* name, const std::string& url = {});
+
+  /**
+   * @brief Ends a span that was begun with the same trace ID and name.
+   */
+  static void end(uint64_t traceID, const char* name);
+
+  /**
+   * @brief Ends one span and begins the next at the same moment.
+   */
+  static void
+  endAndBegin(uint64_t traceID, const char* endName, const char* beginName);
+
+  /**
+   * @brief Ends a span and remembers when, so that the next stage can be begun
+   * retroactively by {@link spanFromHandoff}.
+   *
+   * This is used where the work between two stages happens inside
+   * cesium-native, and the next stage is only seen once it is done.
+   */
+  static void handoff(uint64_t traceID, const char* endName);
+
+  /**
+   * @brief Begins a span at the time of the last {@link handoff} with the
+   * same trace ID, and immediately ends it. Does nothing if there was no
+   * handoff.
+   */
+  static void spanFromHandoff(uint64_t traceID, const char* name);
+
+  /**
+   * @brief Records a moment in the life of a tile.
+   */
+  static void instant(uint64_t traceID, const char* name);
+
+  /**
+   * @brief Writes all recorded spans to a file in the Chrome trace event
+   * format.
+   *
+   * @return True if the file was written.
+   */
+  static bool write(const std::string& path);
+
+  /**
+   * @brief Discards all recorded spans.
+   */
+  static void clear();
+
+private:
+  static std::atomic<bool> _enabled;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,121 @@
+#include "TileLoadScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/*static*/ TileLoadScheduler& TileLoadScheduler::getInstance() {
+  static TileLoadScheduler instance;
+  return instance;
+}
+
+TileLoadScheduler::TileLoadScheduler() : _tick(0), _tilesets() {}
+
+int32_t TileLoadScheduler::beginTilesetUpdate(
+    const void* pTileset,
+    uint64_t tick,
+    int32_t globalLimit,
+    float weight,
+    int32_t maximumSimultaneousTileLoads) {
+  if (globalLimit <= 0) {
+    return maximumSimultaneousTileLoads;
+  }
+
+  if (tick != this->_tick) {
+    this->beginTick(tick, globalLimit);
+  }
+
+  auto [it, added] = this->_tilesets.try_emplace(pTileset);
+  TilesetState& state = it->second;
+  state.weight = std::max(weight, 0.0f);
+  state.maximumSimultaneousTileLoads = maximumSimultaneousTileLoads;
+  state.updatedThisTick = true;
+
+  // A tileset that has not reported its pending loads yet gets a single slot,
+  // so that it can start loading before the next allocation.
+  return std::min(state.allocation, maximumSimultaneousTileLoads);
+}
+
+void TileLoadScheduler::endTilesetUpdate(
+    const void* pTileset,
+    int32_t pendingLoads) {
+  auto it = this->_tilesets.find(pTileset);
+  if (it != this->_tilesets.end()) {
+    it->second.pendingLoads = pendingLoads;
+  }
+}
+
+void TileLoadScheduler::removeTileset(const void* pTileset) {
+  this->_tilesets.erase(pTileset);
+}
+
+void TileLoadScheduler::beginTick(uint64_t tick, int32_t globalLimit) {
+  this->_tick = tick;
+
+  // Tilesets that did not update in the previous tick, for example because
+  // they were disabled, no longer compete for loads.
+  std::erase_if(this->_tilesets, [](const auto& pair) {
+    return !pair.second.updatedThisTick;
+  });
+
+  std::vector<TilesetState*> waiting;
+  for (auto& [pTileset, state] : this->_tilesets) {
+    state.updatedThisTick = false;
+    state.allocation = 1;
+    if (state.pendingLoads > 0 && state.maximumSimultaneousTileLoads > 0) {
+      waiting.emplace_back(&state);
+    }
+  }
+
+  // Every waiting tileset is guaranteed one slot. The rest of the limit is
+  // filled in proportion to weight, handing out what a tileset can't use to
+  // the others until either the limit or the demand is exhausted.
+  int32_t remaining = globalLimit - int32_t(waiting.size());
+  auto isSatisfied = [](const TilesetState* pState) {
+    return pState->allocation >=
+           std::min(pState->pendingLoads, pState->maximumSimultaneousTileLoads);
+  };
+  std::erase_if(waiting, isSatisfied);
+
+  while (remaining > 0 && !waiting.empty()) {
+    float totalWeight = 0.0f;
+    for (const TilesetState* pState : waiting) {
+      totalWeight += pState->weight;
+    }
+
+    int32_t distributed = 0;
+    for (TilesetState* pState : waiting) {
+      int32_t demand =
+          std::min(pState->pendingLoads, pState->maximumSimultaneousTileLoads) -
+          pState->allocation;
+      float share = totalWeight > 0.0f
+                        ? float(remaining) * pState->weight / totalWeight
+                        : float(remaining) / float(waiting.size());
+      int32_t grant = std::min(demand, int32_t(std::floor(share)));
+      pState->allocation += grant;
+      distributed += grant;
+    }
+
+    if (distributed == 0) {
+      // The shares were all fractional, so give the remainder out one at a
+      // time, heaviest first.
+      std::sort(waiting.begin(), waiting.end(), [](auto* pLeft, auto* pRight) {
+        return pLeft->weight > pRight->weight;
+      });
+      for (TilesetState* pState : waiting) {
+        if (distributed == remaining) {
+          break;
+        }
+        ++pState->allocation;
+        ++distributed;
+      }
+    }
+
+    remaining -= distributed;
+    std::erase_if(waiting, isSatisfied);
+  }
+}
+
+} // namespace CesiumForUnityNative
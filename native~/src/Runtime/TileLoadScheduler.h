@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Shares a scene-wide limit on simultaneous tile loads between all
+ * tilesets.
+ *
+ * Each tileset keeps its own load queue, ordered by cesium-native so that the
+ * tiles with the largest screen-space error nearest the camera load first.
+ * This scheduler decides how many loads each queue may have in flight. On the
+ * first tileset update of each {@link TilesetUpdateTick}, the global limit is
+ * divided between the tilesets that reported pending loads in the previous
+ * tick, in proportion to their weights. A tileset never receives more than it
+ * has pending or than its own `maximumSimultaneousTileLoads`; any excess is
+ * redistributed to the others. Every tileset with pending loads receives at
+ * least one slot, so a tileset with a small weight, such as terrain beneath
+ * buildings, always makes progress.
+ *
+ * This must only be used from the main thread.
+ */
+class TileLoadScheduler {
+public:
+  /**
+   * @brief Gets the scheduler shared by all tilesets.
+   */
+  static TileLoadScheduler& getInstance();
+
+  TileLoadScheduler();
+
+  /**
+   * @brief Gets the number of simultaneous loads a tileset may have during
+   * this update, dividing the global limit again if this is the first update
+   * of a new tick.
+   *
+   * @param pTileset An identifier for the tileset.
+   * @param tick The {@link TilesetUpdateTick} of the update.
+   * @param globalLimit The number of simultaneous loads shared by all
+   * tilesets, or zero or less for no global limit.
+   * @param weight The tileset's share of the global limit relative to other
+   * tilesets.
+   * @param maximumSimultaneousTileLoads The tileset's own limit, which is
+   * returned unchanged if there is no global limit.
+   */
+  int32_t beginTilesetUpdate(
+      const void* pTileset,
+      uint64_t tick,
+      int32_t globalLimit,
+      float weight,
+      int32_t maximumSimultaneousTileLoads);
+
+  /**
+   * @brief Records the number of loads that a tileset had waiting at the end
+   * of its update.
+   */
+  void endTilesetUpdate(const void* pTileset, int32_t pendingLoads);
+
+  /**
+   * @brief Stops scheduling loads for a tileset that has been destroyed.
+   */
+  void removeTileset(const void* pTileset);
+
+private:
+  struct TilesetState {
+    float weight = 1.0f;
+    int32_t maximumSimultaneousTileLoads = 0;
+    int32_t pendingLoads = 0;
+    int32_t allocation = 1;
+    bool updatedThisTick = false;
+  };
+
+  void beginTick(uint64_t tick, int32_t globalLimit);
+
+  uint64_t _tick;
+  std::unordered_map<const void*, TilesetState> _tilesets;
+};
+
+} // namespace CesiumForUnityNative
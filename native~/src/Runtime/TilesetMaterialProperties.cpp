@@ -82,6 +82,10 @@ const std::string
         "_overlayTextureCoordinateIndex_";
 const std::string TilesetMaterialProperties::_overlayTranslationAndScalePrefix =
     "_overlayTranslationAndScale_";
+const std::string TilesetMaterialProperties::_overlayTextureArrayPrefix =
+    "_overlayTextureArray_";
+const std::string TilesetMaterialProperties::_overlayTextureSliceIndexPrefix =
+    "_overlayTextureSliceIndex_";
 #pragma endregion
 
 TilesetMaterialProperties::TilesetMaterialProperties()
@@ -133,7 +137,10 @@ TilesetMaterialProperties::TilesetMaterialProperties()
           Shader::PropertyToID(System::String(_occlusionTextureRotationName))),
       _overlayTextureCoordinateIndexIDs(),
       _overlayTextureIDs(),
-      _overlayTranslationAndScaleIDs() {}
+      _overlayTranslationAndScaleIDs(),
+      _overlayTextureArrayIDs(),
+      _overlayTextureSliceIndexIDs(),
+      _overlayIndices() {}
 
 const std::optional<int32_t>
 TilesetMaterialProperties::getOverlayTextureCoordinateIndexID(
@@ -164,6 +171,35 @@ TilesetMaterialProperties::getOverlayTranslationAndScaleID(
   return this->_overlayTranslationAndScaleIDs.at(key);
 }
 
+const std::optional<int32_t>
+TilesetMaterialProperties::getOverlayTextureArrayID(
+    const std::string& key) const noexcept {
+  auto iter = this->_overlayTextureArrayIDs.find(key);
+  if (iter == this->_overlayTextureArrayIDs.end()) {
+    return std::nullopt;
+  }
+  return this->_overlayTextureArrayIDs.at(key);
+}
+
+const std::optional<int32_t>
+TilesetMaterialProperties::getOverlayTextureSliceIndexID(
+    const std::string& key) const noexcept {
+  auto iter = this->_overlayTextureSliceIndexIDs.find(key);
+  if (iter == this->_overlayTextureSliceIndexIDs.end()) {
+    return std::nullopt;
+  }
+  return this->_overlayTextureSliceIndexIDs.at(key);
+}
+
+const std::optional<int32_t> TilesetMaterialProperties::getOverlayIndex(
+    const std::string& key) const noexcept {
+  auto iter = this->_overlayIndices.find(key);
+  if (iter == this->_overlayIndices.end()) {
+    return std::nullopt;
+  }
+  return this->_overlayIndices.at(key);
+}
+
 void TilesetMaterialProperties::updateOverlayParameterIDs(
     const std::vector<std::string>& overlayMaterialKeys) {
   const size_t size = overlayMaterialKeys.size();
@@ -171,11 +207,16 @@ void TilesetMaterialProperties::updateOverlayParameterIDs(
   this->_overlayTextureIDs.reserve(size);
   this->_overlayTextureCoordinateIndexIDs.reserve(size);
   this->_overlayTranslationAndScaleIDs.reserve(size);
+  this->_overlayTextureArrayIDs.reserve(size);
+  this->_overlayTextureSliceIndexIDs.reserve(size);
+  this->_overlayIndices.reserve(size);
 
   System::String texturePrefix(_overlayTexturePrefix);
   System::String textureCoordinateIndexPrefix(
       _overlayTextureCoordinateIndexPrefix);
   System::String translationAndScalePrefix(_overlayTranslationAndScalePrefix);
+  System::String textureArrayPrefix(_overlayTextureArrayPrefix);
+  System::String textureSliceIndexPrefix(_overlayTextureSliceIndexPrefix);
 
   std::unordered_set<std::string> uniqueKeys;
 
@@ -203,6 +244,15 @@ void TilesetMaterialProperties::updateOverlayParameterIDs(
         {keyStlString,
          Shader::PropertyToID(
              System::String::Concat(translationAndScalePrefix, key))});
+    this->_overlayTextureArrayIDs.insert(
+        {keyStlString,
+         Shader::PropertyToID(
+             System::String::Concat(textureArrayPrefix, key))});
+    this->_overlayTextureSliceIndexIDs.insert(
+        {keyStlString,
+         Shader::PropertyToID(
+             System::String::Concat(textureSliceIndexPrefix, key))});
+    this->_overlayIndices.insert({keyStlString, static_cast<int32_t>(i)});
   }
 }
 
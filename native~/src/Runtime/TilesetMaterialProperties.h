@@ -92,6 +92,17 @@ public:
   getOverlayTextureID(const std::string& key) const noexcept;
   const std::optional<int32_t>
   getOverlayTranslationAndScaleID(const std::string& key) const noexcept;
+  const std::optional<int32_t>
+  getOverlayTextureArrayID(const std::string& key) const noexcept;
+  const std::optional<int32_t>
+  getOverlayTextureSliceIndexID(const std::string& key) const noexcept;
+
+  /**
+   * @brief Gets the position of the overlay with the given material key among
+   * the tileset's overlays, which determines the order they are applied in.
+   */
+  const std::optional<int32_t>
+  getOverlayIndex(const std::string& key) const noexcept;
 
   void updateOverlayParameterIDs(
       const std::vector<std::string>& overlayMaterialKeys);
@@ -131,6 +142,9 @@ private:
   std::unordered_map<std::string, int32_t> _overlayTextureCoordinateIndexIDs;
   std::unordered_map<std::string, int32_t> _overlayTextureIDs;
   std::unordered_map<std::string, int32_t> _overlayTranslationAndScaleIDs;
+  std::unordered_map<std::string, int32_t> _overlayTextureArrayIDs;
+  std::unordered_map<std::string, int32_t> _overlayTextureSliceIndexIDs;
+  std::unordered_map<std::string, int32_t> _overlayIndices;
 
   static const std::string _doubleSidedEnableName;
   static const std::string _cullName;
@@ -166,6 +180,8 @@ private:
   static const std::string _overlayTexturePrefix;
   static const std::string _overlayTextureCoordinateIndexPrefix;
   static const std::string _overlayTranslationAndScalePrefix;
+  static const std::string _overlayTextureArrayPrefix;
+  static const std::string _overlayTextureSliceIndexPrefix;
 };
 
 } // namespace CesiumForUnityNative
@@ -0,0 +1,27 @@
+#include "TilesetUpdateTick.h"
+
+namespace CesiumForUnityNative {
+
+/*static*/ TilesetUpdateTick& TilesetUpdateTick::getInstance() {
+  static TilesetUpdateTick instance;
+  return instance;
+}
+
+TilesetUpdateTick::TilesetUpdateTick()
+    : _frameCount(-1), _tick(0), _tilesetsUpdated() {}
+
+uint64_t TilesetUpdateTick::beginTilesetUpdate(
+    const void* pTileset,
+    int32_t frameCount) {
+  if (frameCount != this->_frameCount ||
+      this->_tilesetsUpdated.contains(pTileset)) {
+    this->_frameCount = frameCount;
+    ++this->_tick;
+    this->_tilesetsUpdated.clear();
+  }
+
+  this->_tilesetsUpdated.insert(pTileset);
+  return this->_tick;
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_set>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Counts the rounds in which every active tileset updates once.
+ *
+ * In Play mode, tilesets update once per frame. In the Editor outside Play
+ * mode, they update from `EditorApplication.update`, which may be called many
+ * times without `Time.frameCount` changing. Work that is shared by all
+ * tilesets and should be redone once per round, such as reading the cameras or
+ * dividing a budget, is keyed on this tick instead of on the frame count.
+ *
+ * A new tick begins when the frame count changes, or when a tileset updates
+ * again before the frame count changes.
+ *
+ * This must only be used from the main thread.
+ */
+class TilesetUpdateTick {
+public:
+  /**
+   * @brief Gets the tick shared by all tilesets.
+   */
+  static TilesetUpdateTick& getInstance();
+
+  TilesetUpdateTick();
+
+  /**
+   * @brief Records that a tileset is starting an update, beginning a new tick
+   * if needed.
+   *
+   * @param pTileset An identifier for the tileset.
+   * @param frameCount The current `Time.frameCount`.
+   * @return The tick that the update belongs to.
+   */
+  uint64_t beginTilesetUpdate(const void* pTileset, int32_t frameCount);
+
+  /**
+   * @brief Gets the tick of the most recent tileset update.
+   */
+  uint64_t getCurrentTick() const noexcept { return this->_tick; }
+
+private:
+  int32_t _frameCount;
+  uint64_t _tick;
+  std::unordered_set<const void*> _tilesetsUpdated;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,273 @@
+#include "TilesetWarmStart.h"
+
+#include "StableHash.h"
+
+#include <Cesium3DTilesSelection/Tileset.h>
+#include <Cesium3DTilesSelection/TilesetViewGroup.h>
+#include <Cesium3DTilesSelection/ViewUpdateResult.h>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace Cesium3DTilesSelection;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+const char* snapshotHeader = "CesiumTilesetSnapshot 1";
+
+// The number of values on a view line.
+constexpr size_t viewValueCount = 13;
+
+// How often the snapshot is saved while the tileset is in use, in seconds.
+constexpr double saveInterval = 10.0;
+
+// How long to keep restoring the snapshot, in seconds, if its tiles have not
+// all loaded by then.
+constexpr double maximumRestoreTime = 30.0;
+
+// The tiles of the snapshot get this share of the tile loads relative to the
+// tiles for the live cameras, whose weight is 1.0. It is lower so that the
+// views of the previous session never delay what the cameras see now.
+constexpr double restoreViewGroupWeight = 0.5;
+
+bool parseValues(const char* pCurrent, std::vector<double>& values) {
+  values.clear();
+  while (*pCurrent != '\0') {
+    char* pNext = nullptr;
+    double value = std::strtod(pCurrent, &pNext);
+    if (pNext == pCurrent) {
+      return false;
+    }
+    values.emplace_back(value);
+
+    pCurrent = pNext;
+    if (*pCurrent == ',') {
+      ++pCurrent;
+    } else {
+      break;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+/*static*/ std::optional<TilesetSnapshot>
+TilesetSnapshot::load(const std::string& path) {
+  std::ifstream file{std::filesystem::path(path)};
+  if (!file) {
+    return std::nullopt;
+  }
+
+  std::string line;
+  if (!std::getline(file, line) || line != snapshotHeader) {
+    return std::nullopt;
+  }
+
+  TilesetSnapshot snapshot;
+  std::vector<double> values;
+  while (std::getline(file, line)) {
+    if (line.rfind("view,", 0) == 0 &&
+        parseValues(line.c_str() + 5, values) &&
+        values.size() == viewValueCount) {
+      snapshot.views.emplace_back(View{
+          glm::dvec3(values[0], values[1], values[2]),
+          glm::dvec3(values[3], values[4], values[5]),
+          glm::dvec3(values[6], values[7], values[8]),
+          values[9],
+          values[10],
+          glm::dvec2(values[11], values[12])});
+    }
+  }
+
+  return snapshot;
+}
+
+bool TilesetSnapshot::save(const std::string& path) const {
+  std::string contents = snapshotHeader;
+  contents += '\n';
+
+  auto out = std::back_inserter(contents);
+  for (const View& view : this->views) {
+    fmt::format_to(
+        out,
+        "view,{},{},{},{},{},{},{},{},{},{},{},{},{}\n",
+        view.position.x,
+        view.position.y,
+        view.position.z,
+        view.direction.x,
+        view.direction.y,
+        view.direction.z,
+        view.up.x,
+        view.up.y,
+        view.up.z,
+        view.horizontalFieldOfView,
+        view.verticalFieldOfView,
+        view.viewportSize.x,
+        view.viewportSize.y);
+  }
+
+  // A snapshot that is cut short, such as when the application is killed
+  // while saving, must not replace the previous one.
+  std::filesystem::path finalPath(path);
+  std::filesystem::path temporaryPath(path + ".tmp");
+  {
+    std::ofstream file(temporaryPath, std::ios::binary);
+    if (!file.write(contents.data(), std::streamsize(contents.size()))) {
+      SPDLOG_LOGGER_ERROR(
+          spdlog::default_logger(),
+          "Could not write the tileset snapshot {}.",
+          temporaryPath.generic_string());
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporaryPath, finalPath, error);
+  if (error) {
+    SPDLOG_LOGGER_ERROR(
+        spdlog::default_logger(),
+        "Could not save the tileset snapshot {}: {}",
+        path,
+        error.message());
+    return false;
+  }
+
+  return true;
+}
+
+/*static*/ std::string TilesetWarmStart::getSnapshotPath(
+    const std::string& directory,
+    const std::string& tilesetKey) {
+  StableHash hash;
+  hash.add(tilesetKey);
+  return fmt::format(
+      "{}/cesium-tileset-snapshot-{:016x}.txt",
+      directory,
+      hash.value());
+}
+
+TilesetWarmStart::TilesetWarmStart(
+    Tileset& tileset,
+    const std::string& snapshotPath,
+    double time)
+    : _tileset(tileset),
+      _snapshotPath(snapshotPath),
+      _snapshot(),
+      _nextSaveTime(time + saveInterval),
+      _pViewGroup(),
+      _restoreViewStates(),
+      _restoreStartTime(time) {
+  std::optional<TilesetSnapshot> maybeSnapshot =
+      TilesetSnapshot::load(snapshotPath);
+  if (!maybeSnapshot || maybeSnapshot->views.empty()) {
+    return;
+  }
+
+  const CesiumGeospatial::Ellipsoid& ellipsoid = tileset.getOptions().ellipsoid;
+  for (const TilesetSnapshot::View& view : maybeSnapshot->views) {
+    this->_restoreViewStates.emplace_back(ViewState(
+        view.position,
+        view.direction,
+        view.up,
+        view.viewportSize,
+        view.horizontalFieldOfView,
+        view.verticalFieldOfView,
+        ellipsoid));
+  }
+
+  // Until the tileset has been used long enough to be saved again, the
+  // previous snapshot is still the best one.
+  this->_snapshot = std::move(*maybeSnapshot);
+
+  this->_pViewGroup = std::make_unique<TilesetViewGroup>();
+  this->_pViewGroup->setWeight(restoreViewGroupWeight);
+  tileset.registerLoadRequester(*this->_pViewGroup);
+}
+
+TilesetWarmStart::~TilesetWarmStart() = default;
+
+size_t TilesetWarmStart::restore(double time) {
+  if (!this->_pViewGroup) {
+    return 0;
+  }
+
+  const ViewUpdateResult& result = this->_tileset.updateViewGroup(
+      *this->_pViewGroup,
+      this->_restoreViewStates,
+      0.0f);
+
+  // Nothing is rendered until the root of the tileset has loaded, so an empty
+  // queue before then doesn't mean that the snapshot has been restored. The
+  // queues are also empty while the last loads are in flight, which only the
+  // load progress accounts for.
+  const bool loaded =
+      !result.tilesToRenderThisFrame.empty() &&
+      result.workerThreadTileLoadQueueLength == 0 &&
+      result.mainThreadTileLoadQueueLength == 0 &&
+      this->_pViewGroup->getPreviousLoadProgressPercentage() >= 100.0f;
+  const double elapsed = time - this->_restoreStartTime;
+  if (!loaded && elapsed < maximumRestoreTime) {
+    return result.workerThreadTileLoadQueueLength;
+  }
+
+  SPDLOG_LOGGER_INFO(
+      this->_tileset.getExternals().pLogger,
+      "Restored {} tiles for the {} views in the tileset snapshot in {:.2f} "
+      "seconds{}.",
+      result.tilesToRenderThisFrame.size(),
+      this->_restoreViewStates.size(),
+      elapsed,
+      loaded ? "" : ", stopping before all had loaded");
+
+  // The restored tiles stay loaded for as long as the tileset's cache allows.
+  this->_pViewGroup.reset();
+  this->_restoreViewStates.clear();
+  return 0;
+}
+
+void TilesetWarmStart::update(
+    const std::vector<ViewState>& viewStates,
+    const ViewUpdateResult& result,
+    double time) {
+  // Views with nothing rendered for them, such as before the root tile has
+  // loaded, would make a useless snapshot.
+  if (viewStates.empty() || result.tilesToRenderThisFrame.empty()) {
+    return;
+  }
+
+  this->_snapshot.views.clear();
+  for (const ViewState& viewState : viewStates) {
+    this->_snapshot.views.emplace_back(TilesetSnapshot::View{
+        viewState.getPosition(),
+        viewState.getDirection(),
+        viewState.getUp(),
+        viewState.getHorizontalFieldOfView(),
+        viewState.getVerticalFieldOfView(),
+        viewState.getViewportSize()});
+  }
+
+  if (time < this->_nextSaveTime) {
+    return;
+  }
+  this->_nextSaveTime = time + saveInterval;
+
+  this->save();
+}
+
+void TilesetWarmStart::save() {
+  if (this->_snapshot.views.empty()) {
+    return;
+  }
+
+  this->_snapshot.save(this->_snapshotPath);
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/ViewState.h>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class Tileset;
+class TilesetViewGroup;
+class ViewUpdateResult;
+} // namespace Cesium3DTilesSelection
+
+namespace CesiumGeospatial {
+class Ellipsoid;
+}
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief The camera views of a tileset, saved so that a later session can
+ * start by loading the tiles for them.
+ *
+ * A snapshot is a small text file. Its first line is `CesiumTilesetSnapshot`
+ * followed by the format version. Each line starting with `view,` holds the
+ * position, direction, and up vectors of one camera in the tileset's ECEF
+ * coordinates, its horizontal and vertical fields of view in radians, and its
+ * viewport width and height. Other lines are ignored.
+ */
+struct TilesetSnapshot {
+  struct View {
+    glm::dvec3 position;
+    glm::dvec3 direction;
+    glm::dvec3 up;
+    double horizontalFieldOfView;
+    double verticalFieldOfView;
+    glm::dvec2 viewportSize;
+  };
+
+  std::vector<View> views;
+
+  /**
+   * @brief Reads a snapshot, returning nothing if the file does not exist or
+   * is not a snapshot.
+   */
+  static std::optional<TilesetSnapshot> load(const std::string& path);
+
+  /**
+   * @brief Writes this snapshot, replacing the file only once it has been
+   * completely written.
+   */
+  bool save(const std::string& path) const;
+};
+
+/**
+ * @brief Saves a snapshot of a tileset's views as it is used, and restores
+ * the tiles for the previous session's views when the tileset is created.
+ *
+ * cesium-native only loads tiles as they are selected by traversing the
+ * tileset, so the tiles are restored by selecting for the saved views in a
+ * view group of their own, which is updated before the live cameras but gets
+ * a smaller share of the tile loads. Their
+ * content is usually served from the request cache. The group is dropped once
+ * all of its tiles have loaded, or after a time limit in case the tileset has
+ * changed since the snapshot was saved.
+ */
+class TilesetWarmStart {
+public:
+  /**
+   * @brief Gets the path of the snapshot for a tileset.
+   *
+   * @param directory The directory that holds the snapshots.
+   * @param tilesetKey A string that identifies the tileset, such as its URL.
+   */
+  static std::string
+  getSnapshotPath(const std::string& directory, const std::string& tilesetKey);
+
+  /**
+   * @brief Starts restoring the snapshot at the given path, if there is one,
+   * into a newly-created tileset.
+   *
+   * @param tileset The tileset. It must outlive this object.
+   * @param snapshotPath The path that the snapshot is read from and saved to.
+   * @param time The current time, in seconds.
+   */
+  TilesetWarmStart(
+      Cesium3DTilesSelection::Tileset& tileset,
+      const std::string& snapshotPath,
+      double time);
+  ~TilesetWarmStart();
+
+  /**
+   * @brief Whether the tiles of the previous snapshot are still being
+   * restored.
+   */
+  bool isRestoring() const noexcept { return this->_pViewGroup != nullptr; }
+
+  /**
+   * @brief Selects the tiles for the views of the previous snapshot, so that
+   * they are loaded along with the tiles for the live cameras. Call this
+   * before the default view group is updated.
+   *
+   * @return The number of tiles that are waiting to be loaded for the
+   * snapshot.
+   */
+  size_t restore(double time);
+
+  /**
+   * @brief Records the views that the tileset was updated for, and saves them
+   * every few seconds.
+   */
+  void update(
+      const std::vector<Cesium3DTilesSelection::ViewState>& viewStates,
+      const Cesium3DTilesSelection::ViewUpdateResult& result,
+      double time);
+
+  /**
+   * @brief Saves the most recent views.
+   */
+  void save();
+
+private:
+  Cesium3DTilesSelection::Tileset& _tileset;
+  std::string _snapshotPath;
+  TilesetSnapshot _snapshot;
+  double _nextSaveTime;
+
+  std::unique_ptr<Cesium3DTilesSelection::TilesetViewGroup> _pViewGroup;
+  std::vector<Cesium3DTilesSelection::ViewState> _restoreViewStates;
+  double _restoreStartTime;
+};
+
+} // namespace CesiumForUnityNative
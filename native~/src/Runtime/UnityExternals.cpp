@@ -1,5 +1,6 @@
 #include "UnityExternals.h"
 
+#include "RenderResourceCache.h"
 #include "UnityEmscriptenAssetAccessor.h"
 #include "UnityPrepareRendererResources.h"
 #include "UnityTaskProcessor.h"
@@ -48,6 +49,7 @@ namespace {
 std::shared_ptr<IAssetAccessor> pAccessor = nullptr;
 std::shared_ptr<ITaskProcessor> pTaskProcessor = nullptr;
 std::optional<AsyncSystem> asyncSystem;
+std::shared_ptr<RenderResourceCache> pRenderResourceCache = nullptr;
 
 #ifdef __EMSCRIPTEN__
 std::shared_ptr<UnityEmscriptenAssetAccessor> pWebRequestAccessor = nullptr;
@@ -69,10 +71,16 @@ void initializeExternals() {
     std::string tempPath =
         UnityEngine::Application::temporaryCachePath().ToStlString();
     std::string cacheDBPath = tempPath + "/cesium-request-cache.sqlite";
+    std::string renderResourceCacheDBPath =
+        tempPath + "/cesium-render-resource-cache.sqlite";
 
     int32_t requestsPerCachePrune =
         CesiumForUnity::CesiumRuntimeSettings::requestsPerCachePrune();
     uint64_t maxItems = CesiumForUnity::CesiumRuntimeSettings::maxItems();
+    bool cacheProcessedTextures =
+        CesiumForUnity::CesiumRuntimeSettings::cacheProcessedTextures();
+    bool cacheProcessedMeshes =
+        CesiumForUnity::CesiumRuntimeSettings::cacheProcessedMeshes();
 
     pWebRequestAccessor =
 #ifdef __EMSCRIPTEN__
@@ -91,6 +99,16 @@ void initializeExternals() {
                 maxItems),
             requestsPerCachePrune));
 
+    if (cacheProcessedTextures || cacheProcessedMeshes) {
+      pRenderResourceCache = std::make_shared<RenderResourceCache>(
+          spdlog::default_logger(),
+          renderResourceCacheDBPath,
+          maxItems,
+          requestsPerCachePrune,
+          cacheProcessedTextures,
+          cacheProcessedMeshes);
+    }
+
     pTaskProcessor = std::make_shared<UnityTaskProcessor>();
     asyncSystem.emplace(pTaskProcessor);
   } catch (const std::exception& e) {
@@ -179,6 +197,7 @@ void shutdownExternals() {
 
   pWebRequestAccessor.reset();
   pAccessor.reset();
+  pRenderResourceCache.reset();
   pTaskProcessor.reset();
   asyncSystem.reset();
 }
@@ -199,6 +218,13 @@ const std::shared_ptr<ITaskProcessor>& getTaskProcessor() {
   return pTaskProcessor;
 }
 
+const std::shared_ptr<RenderResourceCache>& getRenderResourceCache() {
+  if (pAccessor == nullptr) {
+    initializeExternals();
+  }
+  return pRenderResourceCache;
+}
+
 AsyncSystem& getAsyncSystem() {
   if (!asyncSystem) {
     initializeExternals();
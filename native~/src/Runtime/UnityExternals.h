@@ -14,8 +14,16 @@ class ITaskProcessor;
 
 namespace CesiumForUnityNative {
 
+class RenderResourceCache;
+
 const std::shared_ptr<CesiumAsync::IAssetAccessor>& getAssetAccessor();
 const std::shared_ptr<CesiumAsync::ITaskProcessor>& getTaskProcessor();
 CesiumAsync::AsyncSystem& getAsyncSystem();
 
+/**
+ * @brief Gets the persistent cache of processed render resources, or nullptr
+ * if it is disabled in the CesiumRuntimeSettings.
+ */
+const std::shared_ptr<RenderResourceCache>& getRenderResourceCache();
+
 } // namespace CesiumForUnityNative
@@ -1,13 +1,18 @@
 #include "UnityPrepareRendererResources.h"
 
 #include "CesiumFeaturesMetadataUtility.h"
+#include "RenderResourceCache.h"
+#include "StableHash.h"
 #include "TextureLoader.h"
+#include "TileLifecycleTracer.h"
 #include "TilesetMaterialProperties.h"
+#include "UnityExternals.h"
 #include "UnityLifetime.h"
 #include "UnityTransforms.h"
 
 #include <Cesium3DTilesSelection/Tile.h>
 #include <Cesium3DTilesSelection/Tileset.h>
+#include <CesiumGeometry/AxisAlignedBox.h>
 #include <CesiumGeometry/Transforms.h>
 #include <CesiumGeospatial/Ellipsoid.h>
 #include <CesiumGltf/AccessorView.h>
@@ -34,6 +39,7 @@
 #include <DotNet/CesiumForUnity/CesiumPointCloudRenderer.h>
 #include <DotNet/CesiumForUnity/CesiumPrimitiveFeatures.h>
 #include <DotNet/CesiumForUnity/CesiumPropertyTable.h>
+#include <DotNet/CesiumForUnity/CesiumRasterOverlayTexturePool.h>
 #include <DotNet/CesiumForUnity/Helpers.h>
 #include <DotNet/System/Array1.h>
 #include <DotNet/System/Collections/Generic/List1.h>
@@ -43,10 +49,12 @@
 #include <DotNet/Unity/Collections/NativeArray1.h>
 #include <DotNet/Unity/Collections/NativeArrayOptions.h>
 #include <DotNet/UnityEngine/Application.h>
+#include <DotNet/UnityEngine/Bounds.h>
 #include <DotNet/UnityEngine/Debug.h>
 #include <DotNet/UnityEngine/FilterMode.h>
 #include <DotNet/UnityEngine/HideFlags.h>
 #include <DotNet/UnityEngine/Material.h>
+#include <DotNet/UnityEngine/MaterialPropertyBlock.h>
 #include <DotNet/UnityEngine/Matrix4x4.h>
 #include <DotNet/UnityEngine/Mesh.h>
 #include <DotNet/UnityEngine/MeshCollider.h>
@@ -64,17 +72,22 @@
 #include <DotNet/UnityEngine/Rendering/VertexAttributeDescriptor.h>
 #include <DotNet/UnityEngine/Resources.h>
 #include <DotNet/UnityEngine/Texture.h>
+#include <DotNet/UnityEngine/Texture2D.h>
 #include <DotNet/UnityEngine/TextureWrapMode.h>
 #include <DotNet/UnityEngine/Transform.h>
 #include <DotNet/UnityEngine/Vector2.h>
 #include <DotNet/UnityEngine/Vector3.h>
 #include <DotNet/UnityEngine/Vector4.h>
+#include <glm/common.hpp>
 #include <glm/gtc/matrix_inverse.hpp>
 #include <glm/gtc/quaternion.hpp>
 
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
 #include <unordered_map>
 #include <variant>
 
@@ -138,6 +151,12 @@ void computeFlatNormals(
 struct MeshDataResult {
   UnityEngine::MeshDataArray meshDataArray;
   std::vector<CesiumPrimitiveInfo> primitiveInfos;
+
+  /**
+   * @brief The bounds of each mesh, if they were computed while the mesh data
+   * was populated. Otherwise, Unity must recalculate them.
+   */
+  std::vector<std::optional<AxisAlignedBox>> bounds{};
 };
 
 template <typename TIndex> struct CopyVertexColors {
@@ -263,7 +282,9 @@ bool validateVertexColors(
 
 void generateMipMaps(
     Model* pModel,
-    const std::optional<TextureInfo>& textureInfo) {
+    const std::optional<TextureInfo>& textureInfo,
+    RenderResourceCache* pCache,
+    const std::optional<std::string>& contentKey) {
   if (textureInfo) {
     Texture* pTexture = Model::getSafe(&pModel->textures, textureInfo->index);
     if (pTexture) {
@@ -285,8 +306,23 @@ void generateMipMaps(
         case CesiumGltf::Sampler::MinFilter::LINEAR_MIPMAP_LINEAR:
         case CesiumGltf::Sampler::MinFilter::LINEAR_MIPMAP_NEAREST:
         case CesiumGltf::Sampler::MinFilter::NEAREST_MIPMAP_LINEAR:
-        case CesiumGltf::Sampler::MinFilter::NEAREST_MIPMAP_NEAREST:
-          CesiumImage::ImageDecoder::generateMipMaps(*pImage->pAsset);
+        case CesiumGltf::Sampler::MinFilter::NEAREST_MIPMAP_NEAREST: {
+          ImageAsset& image = *pImage->pAsset;
+          bool canCache = pCache && pCache->cacheTextures() && contentKey &&
+                          image.mipPositions.empty() &&
+                          image.compressedPixelFormat ==
+                              GpuCompressedPixelFormat::NONE;
+          if (canCache &&
+              pCache->readImage(*contentKey, pTexture->source, image)) {
+            break;
+          }
+
+          CesiumImage::ImageDecoder::generateMipMaps(image);
+
+          if (canCache && !image.mipPositions.empty()) {
+            pCache->writeImage(*contentKey, pTexture->source, image);
+          }
+        }
         }
       }
     }
@@ -295,21 +331,27 @@ void generateMipMaps(
 
 void generateMipMapsForPrimitive(
     Model* pModel,
-    const MeshPrimitive& primitive) {
+    const MeshPrimitive& primitive,
+    RenderResourceCache* pCache,
+    const std::optional<std::string>& contentKey) {
   const Material* pMaterial =
       Model::getSafe(&pModel->materials, primitive.material);
   if (pMaterial) {
     if (pMaterial->pbrMetallicRoughness) {
       generateMipMaps(
           pModel,
-          pMaterial->pbrMetallicRoughness->baseColorTexture);
+          pMaterial->pbrMetallicRoughness->baseColorTexture,
+          pCache,
+          contentKey);
       generateMipMaps(
           pModel,
-          pMaterial->pbrMetallicRoughness->metallicRoughnessTexture);
+          pMaterial->pbrMetallicRoughness->metallicRoughnessTexture,
+          pCache,
+          contentKey);
     }
-    generateMipMaps(pModel, pMaterial->normalTexture);
-    generateMipMaps(pModel, pMaterial->occlusionTexture);
-    generateMipMaps(pModel, pMaterial->emissiveTexture);
+    generateMipMaps(pModel, pMaterial->normalTexture, pCache, contentKey);
+    generateMipMaps(pModel, pMaterial->occlusionTexture, pCache, contentKey);
+    generateMipMaps(pModel, pMaterial->emissiveTexture, pCache, contentKey);
   }
 }
 
@@ -325,7 +367,8 @@ void loadPrimitive(
     const glm::dmat4& transform,
     const TIndexAccessor& indicesView,
     UnityEngine::Rendering::IndexFormat indexFormat,
-    const AccessorView<UnityEngine::Vector3>& positionView) {
+    const AccessorView<UnityEngine::Vector3>& positionView,
+    ProcessedPrimitive* pProcessed) {
   using namespace DotNet::UnityEngine;
   using namespace DotNet::UnityEngine::Rendering;
   using namespace DotNet::Unity::Collections;
@@ -390,7 +433,8 @@ void loadPrimitive(
         transform,
         indicesView,
         IndexFormat::UInt32,
-        positionView);
+        positionView,
+        pProcessed);
     return;
   }
 
@@ -541,6 +585,9 @@ void loadPrimitive(
 
   NativeArray1<uint8_t> nativeVertexBuffer =
       meshData.GetVertexData<uint8_t>(streamIndex);
+  primitiveInfo.indexCount = indexCount;
+  primitiveInfo.meshBytes = int64_t(nativeVertexBuffer.Length()) +
+                            int64_t(indexCount) * int64_t(sizeof(TIndex));
   uint8_t* pBufferStart = static_cast<uint8_t*>(
       NativeArrayUnsafeUtility::GetUnsafeBufferPointerWithoutChecks(
           nativeVertexBuffer));
@@ -665,6 +712,178 @@ void loadPrimitive(
   subMeshDescriptor.vertexCount = 0;
 
   meshData.SetSubMesh(0, subMeshDescriptor, MeshUpdateFlags::Default);
+
+  if (pProcessed) {
+    // Capture the final buffers so they can be copied straight back into a
+    // MeshData the next time this tile is loaded.
+    pProcessed->hasMesh = true;
+    pProcessed->attributes.clear();
+    for (int32_t i = 0; i < numberOfAttributes; ++i) {
+      pProcessed->attributes.emplace_back(ProcessedVertexAttribute{
+          int32_t(descriptor[i].attribute),
+          int32_t(descriptor[i].format),
+          descriptor[i].dimension,
+          descriptor[i].stream});
+    }
+    pProcessed->vertexCount = vertexCount;
+    pProcessed->indexFormat = int32_t(indexFormat);
+    pProcessed->indexCount = indexCount;
+    pProcessed->topology = int32_t(subMeshDescriptor.topology);
+
+    const std::byte* pVertexBytes = reinterpret_cast<std::byte*>(pBufferStart);
+    pProcessed->vertexData.assign(
+        pVertexBytes,
+        pVertexBytes + size_t(vertexCount) * stride);
+    const std::byte* pIndexBytes = reinterpret_cast<std::byte*>(indices);
+    pProcessed->indexData.assign(
+        pIndexBytes,
+        pIndexBytes + size_t(indexCount) * sizeof(TIndex));
+
+    glm::vec3 minimum(std::numeric_limits<float>::max());
+    glm::vec3 maximum(std::numeric_limits<float>::lowest());
+    for (int32_t i = 0; i < vertexCount; ++i) {
+      const Vector3& position =
+          *reinterpret_cast<const Vector3*>(pBufferStart + i * stride);
+      glm::vec3 p(position.x, position.y, position.z);
+      minimum = glm::min(minimum, p);
+      maximum = glm::max(maximum, p);
+    }
+    pProcessed->minimumPosition = minimum;
+    pProcessed->maximumPosition = maximum;
+  }
+}
+
+void loadProcessedPrimitive(
+    UnityEngine::MeshData meshData,
+    CesiumPrimitiveInfo& primitiveInfo,
+    const ProcessedPrimitive& processed) {
+  using namespace DotNet::UnityEngine;
+  using namespace DotNet::UnityEngine::Rendering;
+  using namespace DotNet::Unity::Collections;
+  using namespace DotNet::Unity::Collections::LowLevel::Unsafe;
+
+  CESIUM_TRACE("Cesium::loadProcessedPrimitive");
+  if (!processed.hasMesh) {
+    return;
+  }
+
+  const IndexFormat indexFormat = IndexFormat(processed.indexFormat);
+  meshData.SetIndexBufferParams(processed.indexCount, indexFormat);
+  void* pIndices;
+  int64_t indexBytes;
+  if (indexFormat == IndexFormat::UInt32) {
+    NativeArray1<uint32_t> dest = meshData.GetIndexData<uint32_t>();
+    pIndices = NativeArrayUnsafeUtility::GetUnsafeBufferPointerWithoutChecks(dest);
+    indexBytes = int64_t(dest.Length()) * sizeof(uint32_t);
+  } else {
+    NativeArray1<uint16_t> dest = meshData.GetIndexData<uint16_t>();
+    pIndices = NativeArrayUnsafeUtility::GetUnsafeBufferPointerWithoutChecks(dest);
+    indexBytes = int64_t(dest.Length()) * sizeof(uint16_t);
+  }
+
+  System::Array1<VertexAttributeDescriptor> attributes(
+      int32_t(processed.attributes.size()));
+  for (int32_t i = 0, len = attributes.Length(); i < len; ++i) {
+    const ProcessedVertexAttribute& attribute = processed.attributes[i];
+    VertexAttributeDescriptor descriptor{};
+    descriptor.attribute = VertexAttribute(attribute.attribute);
+    descriptor.format = VertexAttributeFormat(attribute.format);
+    descriptor.dimension = attribute.dimension;
+    descriptor.stream = attribute.stream;
+    attributes.Item(i, descriptor);
+  }
+  meshData.SetVertexBufferParams(processed.vertexCount, attributes);
+
+  NativeArray1<uint8_t> nativeVertexBuffer = meshData.GetVertexData<uint8_t>(0);
+  void* pVertices = NativeArrayUnsafeUtility::GetUnsafeBufferPointerWithoutChecks(
+      nativeVertexBuffer);
+  int64_t vertexBytes = nativeVertexBuffer.Length();
+
+  // Guard against a corrupted cache entry rather than overrunning Unity's
+  // buffers.
+  if (indexBytes != int64_t(processed.indexData.size()) ||
+      vertexBytes != int64_t(processed.vertexData.size())) {
+    meshData.SetIndexBufferParams(0, indexFormat);
+    meshData.SetVertexBufferParams(0, attributes);
+    return;
+  }
+
+  std::memcpy(pIndices, processed.indexData.data(), processed.indexData.size());
+  primitiveInfo.indexCount = processed.indexCount;
+  primitiveInfo.meshBytes = indexBytes + vertexBytes;
+  std::memcpy(
+      pVertices,
+      processed.vertexData.data(),
+      processed.vertexData.size());
+
+  meshData.subMeshCount(1);
+
+  SubMeshDescriptor subMeshDescriptor{};
+  subMeshDescriptor.topology = MeshTopology(processed.topology);
+  subMeshDescriptor.indexStart = 0;
+  subMeshDescriptor.indexCount = processed.indexCount;
+  subMeshDescriptor.baseVertex = 0;
+  subMeshDescriptor.firstVertex = 0;
+  subMeshDescriptor.vertexCount = 0;
+
+  meshData.SetSubMesh(0, subMeshDescriptor, MeshUpdateFlags::Default);
+}
+
+// The number of raster overlay texture coordinates sampled from each
+// primitive for the mesh settings hash.
+constexpr int64_t overlayUvSampleCount = 16;
+
+/**
+ * @brief Computes a hash of everything, besides the tile content itself, that
+ * affects how a model is converted to Unity meshes.
+ *
+ * Raster overlay texture coordinates are generated by cesium-native according
+ * to the projections of the overlays attached to the tileset. Because the
+ * positions are fixed by the content, a handful of evenly-spaced coordinates
+ * is enough to tell projections apart, without hashing every vertex. The
+ * attributes of each primitive are included as well, which captures normals
+ * generated by cesium-native when generateSmoothNormals is enabled.
+ */
+uint64_t
+computeMeshSettingsHash(const Model& model, const CreateModelOptions& options) {
+  CESIUM_TRACE("Cesium::computeMeshSettingsHash");
+  StableHash hash;
+  hash.add(options.ignoreKhrMaterialUnlit);
+  hash.add(options.generateSmoothNormals);
+  hash.add(options.createPhysicsMeshes);
+
+  model.forEachPrimitiveInScene(
+      -1,
+      [&hash](
+          const Model& gltf,
+          const Node& node,
+          const Mesh& mesh,
+          const MeshPrimitive& primitive,
+          const glm::dmat4& transform) {
+        hash.add(primitive.mode);
+        for (const auto& [name, accessorID] : primitive.attributes) {
+          hash.add(name);
+          const Accessor* pAccessor = Model::getSafe(&gltf.accessors, accessorID);
+          hash.add(pAccessor ? pAccessor->count : int64_t(-1));
+
+          if (name.starts_with("_CESIUMOVERLAY_")) {
+            AccessorView<UnityEngine::Vector2> view(gltf, accessorID);
+            const int64_t count = view.size();
+            const int64_t step =
+                std::max(count / overlayUvSampleCount, int64_t(1));
+            for (int64_t i = 0; i < count; i += step) {
+              hash.add(view[i].x);
+              hash.add(view[i].y);
+            }
+            if (count > 0) {
+              hash.add(view[count - 1].x);
+              hash.add(view[count - 1].y);
+            }
+          }
+        }
+      });
+
+  return hash.value();
 }
 } // namespace
 
@@ -684,29 +903,78 @@ int32_t countPrimitives(const CesiumGltf::Model& model) {
 void populateMeshDataArray(
     MeshDataResult& meshDataResult,
     TileLoadResult& tileLoadResult,
-    const CreateModelOptions& options) {
+    const CreateModelOptions& options,
+    RenderResourceCache* pCache) {
   CesiumGltf::Model* pModel =
       std::get_if<CesiumGltf::Model>(&tileLoadResult.contentKind);
   if (!pModel)
     return;
 
+  // Tiles without a request of their own, such as upsampled tiles, have no
+  // stable identity and so cannot use the render resource cache.
+  std::optional<std::string> contentKey;
+  if (pCache && tileLoadResult.pCompletedRequest) {
+    contentKey =
+        RenderResourceCache::getContentKey(*tileLoadResult.pCompletedRequest);
+  }
+
+  int32_t numberOfPrimitives = countPrimitives(*pModel);
+
+  // Either copy all primitives from the cache, or convert them all from the
+  // glTF while capturing them for the cache.
+  std::optional<std::string> meshKey;
+  std::vector<ProcessedPrimitive> processedPrimitives;
+  bool useProcessedPrimitives = false;
+  if (contentKey && pCache->cacheMeshes()) {
+    meshKey = RenderResourceCache::getMeshKey(
+        *contentKey,
+        computeMeshSettingsHash(*pModel, options));
+    useProcessedPrimitives =
+        pCache->readPrimitives(*meshKey, processedPrimitives) &&
+        processedPrimitives.size() == size_t(numberOfPrimitives);
+    if (!useProcessedPrimitives) {
+      processedPrimitives.clear();
+      processedPrimitives.resize(size_t(numberOfPrimitives));
+    }
+  }
+
   int32_t meshDataInstance = 0;
 
-  meshDataResult.primitiveInfos.reserve(countPrimitives(*pModel));
+  meshDataResult.primitiveInfos.reserve(numberOfPrimitives);
 
   pModel->forEachPrimitiveInScene(
       -1,
-      [&meshDataResult, &meshDataInstance, pModel, &options](
+      [&meshDataResult,
+       &meshDataInstance,
+       pModel,
+       &options,
+       pCache,
+       &contentKey,
+       &meshKey,
+       &processedPrimitives,
+       useProcessedPrimitives](
           const Model& gltf,
           const Node& node,
           const Mesh& mesh,
           const MeshPrimitive& primitive,
           const glm::dmat4& transform) {
+        int32_t primitiveIndex = meshDataInstance++;
         UnityEngine::MeshData meshData =
-            meshDataResult.meshDataArray[meshDataInstance++];
+            meshDataResult.meshDataArray[primitiveIndex];
         CesiumPrimitiveInfo& primitiveInfo =
             meshDataResult.primitiveInfos.emplace_back();
 
+        ProcessedPrimitive* pProcessed =
+            meshKey ? &processedPrimitives[size_t(primitiveIndex)] : nullptr;
+        if (useProcessedPrimitives) {
+          primitiveInfo = pProcessed->primitiveInfo;
+          if (pProcessed->hasMesh) {
+            generateMipMapsForPrimitive(pModel, primitive, pCache, contentKey);
+            loadProcessedPrimitive(meshData, primitiveInfo, *pProcessed);
+          }
+          return;
+        }
+
         auto positionAccessorIt = primitive.attributes.find("POSITION");
         if (positionAccessorIt == primitive.attributes.end()) {
           // This primitive doesn't have a POSITION semantic, ignore it.
@@ -722,7 +990,7 @@ void populateMeshDataArray(
           return;
         }
 
-        generateMipMapsForPrimitive(pModel, primitive);
+        generateMipMapsForPrimitive(pModel, primitive, pCache, contentKey);
 
         if (primitive.indices < 0 ||
             primitive.indices >= gltf.accessors.size()) {
@@ -739,7 +1007,8 @@ void populateMeshDataArray(
                 transform,
                 generateIndices<std::uint32_t>(indexCount),
                 UnityEngine::Rendering::IndexFormat::UInt32,
-                positionView);
+                positionView,
+                pProcessed);
           } else {
             loadPrimitive<std::uint16_t>(
                 meshData,
@@ -752,7 +1021,8 @@ void populateMeshDataArray(
                 transform,
                 generateIndices<std::uint16_t>(indexCount),
                 UnityEngine::Rendering::IndexFormat::UInt16,
-                positionView);
+                positionView,
+                pProcessed);
           }
         } else {
           const Accessor& indexAccessorGltf = gltf.accessors[primitive.indices];
@@ -770,7 +1040,8 @@ void populateMeshDataArray(
                 transform,
                 indexAccessor,
                 UnityEngine::Rendering::IndexFormat::UInt16,
-                positionView);
+                positionView,
+                pProcessed);
             break;
           }
           case Accessor::ComponentType::UNSIGNED_BYTE: {
@@ -786,7 +1057,8 @@ void populateMeshDataArray(
                 transform,
                 indexAccessor,
                 UnityEngine::Rendering::IndexFormat::UInt16,
-                positionView);
+                positionView,
+                pProcessed);
             break;
           }
           case Accessor::ComponentType::SHORT: {
@@ -802,7 +1074,8 @@ void populateMeshDataArray(
                 transform,
                 indexAccessor,
                 UnityEngine::Rendering::IndexFormat::UInt16,
-                positionView);
+                positionView,
+                pProcessed);
             break;
           }
           case Accessor::ComponentType::UNSIGNED_SHORT: {
@@ -818,7 +1091,8 @@ void populateMeshDataArray(
                 transform,
                 indexAccessor,
                 UnityEngine::Rendering::IndexFormat::UInt16,
-                positionView);
+                positionView,
+                pProcessed);
             break;
           }
           case Accessor::ComponentType::UNSIGNED_INT: {
@@ -834,7 +1108,8 @@ void populateMeshDataArray(
                 transform,
                 indexAccessor,
                 UnityEngine::Rendering::IndexFormat::UInt32,
-                positionView);
+                positionView,
+                pProcessed);
             break;
           }
           default:
@@ -842,6 +1117,32 @@ void populateMeshDataArray(
           }
         }
       });
+
+  if (!meshKey) {
+    return;
+  }
+
+  if (!useProcessedPrimitives) {
+    for (size_t i = 0; i < processedPrimitives.size(); ++i) {
+      processedPrimitives[i].primitiveInfo = meshDataResult.primitiveInfos[i];
+    }
+    pCache->writePrimitives(*meshKey, *contentKey, processedPrimitives);
+  }
+
+  meshDataResult.bounds.reserve(processedPrimitives.size());
+  for (const ProcessedPrimitive& processed : processedPrimitives) {
+    if (processed.hasMesh) {
+      meshDataResult.bounds.emplace_back(AxisAlignedBox(
+          processed.minimumPosition.x,
+          processed.minimumPosition.y,
+          processed.minimumPosition.z,
+          processed.maximumPosition.x,
+          processed.maximumPosition.y,
+          processed.maximumPosition.z));
+    } else {
+      meshDataResult.bounds.emplace_back(std::nullopt);
+    }
+  }
 }
 
 bool isDegenerateTriangleMesh(const UnityEngine::Mesh& mesh) {
@@ -862,6 +1163,19 @@ bool isDegenerateTriangleMesh(const UnityEngine::Mesh& mesh) {
   return false;
 }
 
+// Estimates the size of the physics mesh that Unity bakes for a mesh
+// collider, which is not exposed. A baked mesh holds a float position for
+// each vertex, and for each triangle three 32-bit indices, a 32-bit index
+// back into the source mesh, edge flags, and its share of the bounding volume
+// hierarchy used for queries.
+int64_t estimateMeshColliderBytes(int32_t vertexCount, int32_t indexCount) {
+  constexpr int64_t bytesPerVertex = 3 * sizeof(float);
+  constexpr int64_t bytesPerTriangle =
+      3 * sizeof(uint32_t) + sizeof(uint32_t) + 1 + 16;
+  return int64_t(vertexCount) * bytesPerVertex +
+         int64_t(indexCount / 3) * bytesPerTriangle;
+}
+
 /**
  * @brief The result of the async part of mesh loading.
  */
@@ -872,7 +1186,93 @@ struct LoadThreadResult {
 
 UnityPrepareRendererResources::UnityPrepareRendererResources(
     const UnityEngine::GameObject& tilesetGameObject)
-    : _tilesetGameObject(tilesetGameObject), _materialProperties() {}
+    : _tilesetGameObject(tilesetGameObject),
+      _materialProperties(),
+      _pRenderResourceCache(getRenderResourceCache()),
+      _sharedMaterials(),
+      _overlayPropertyBlock(),
+      _overlayAtlasRequested(false),
+      _useOverlayAtlas(false),
+      _overlayAtlas(),
+      _gameObjectsWithPendingOverlays(),
+      _compositeOverlays(false),
+      _gameObjectsWithCompositeWork(),
+      _wastedPredictedTiles(0),
+      _wastedPredictedBytes(0),
+      _renderResourceBytes(0),
+      _terrainHeightCache() {
+  DotNet::CesiumForUnity::Cesium3DTileset tilesetComponent =
+      tilesetGameObject.GetComponent<DotNet::CesiumForUnity::Cesium3DTileset>();
+  if (tilesetComponent == nullptr) {
+    return;
+  }
+
+  // A composite is a single texture per tile, so there is nothing to atlas.
+  this->_compositeOverlays = tilesetComponent.compositeRasterOverlays();
+  if (!this->_compositeOverlays && tilesetComponent.useRasterOverlayAtlas()) {
+    this->_overlayAtlasRequested = RasterOverlayAtlas::isSupported();
+    this->_useOverlayAtlas = this->_overlayAtlasRequested;
+    if (!this->_overlayAtlasRequested) {
+      UnityEngine::Debug::LogWarning(System::String(
+          "This platform cannot copy textures into texture arrays, so raster "
+          "overlays will be applied as separate textures instead of with an "
+          "atlas."));
+    }
+  }
+}
+
+void UnityPrepareRendererResources::updateOverlayAtlasSupport(
+    const std::vector<std::string>& overlayMaterialKeys) {
+  if (!this->_overlayAtlasRequested) {
+    return;
+  }
+
+  DotNet::CesiumForUnity::Cesium3DTileset tilesetComponent =
+      this->_tilesetGameObject
+          .GetComponent<DotNet::CesiumForUnity::Cesium3DTileset>();
+  if (tilesetComponent == nullptr) {
+    return;
+  }
+
+  // Without a custom material, lit and unlit primitives use different default
+  // materials, and both must support the atlas.
+  std::vector<UnityEngine::Material> materials;
+  UnityEngine::Material opaqueMaterial = tilesetComponent.opaqueMaterial();
+  if (opaqueMaterial != nullptr) {
+    materials.emplace_back(opaqueMaterial);
+  } else {
+    materials.emplace_back(UnityEngine::Resources::Load<UnityEngine::Material>(
+        System::String("CesiumDefaultTilesetMaterial")));
+    materials.emplace_back(UnityEngine::Resources::Load<UnityEngine::Material>(
+        System::String("CesiumUnlitTilesetMaterial")));
+  }
+
+  bool supported = true;
+  for (const std::string& key : overlayMaterialKeys) {
+    std::optional<int32_t> textureArrayID =
+        this->_materialProperties.getOverlayTextureArrayID(key);
+    std::optional<int32_t> sliceIndexID =
+        this->_materialProperties.getOverlayTextureSliceIndexID(key);
+    for (const UnityEngine::Material& material : materials) {
+      if (!textureArrayID || !sliceIndexID || material == nullptr ||
+          !material.HasProperty(*textureArrayID) ||
+          !material.HasProperty(*sliceIndexID)) {
+        supported = false;
+      }
+    }
+  }
+
+  if (!supported && this->_useOverlayAtlas) {
+    UnityEngine::Debug::LogWarning(System::String(
+        "The tileset's material does not have the _overlayTextureArray_KEY "
+        "and _overlayTextureSliceIndex_KEY properties for each raster "
+        "overlay, so raster overlays will be applied as separate textures "
+        "instead of with an atlas. See CesiumRasterOverlayAtlas.hlsl for how "
+        "to sample the atlas in a custom material."));
+  }
+
+  this->_useOverlayAtlas = supported;
+}
 
 CesiumAsync::Future<TileLoadResultAndRenderResources>
 UnityPrepareRendererResources::prepareInLoadThread(
@@ -887,6 +1287,12 @@ UnityPrepareRendererResources::prepareInLoadThread(
     return asyncSystem.createResolvedFuture(
         TileLoadResultAndRenderResources{std::move(tileLoadResult), nullptr});
 
+  // Decompressing, parsing, and decoding the response all happen inside
+  // cesium-native, so they are traced as a single span ending here.
+  uint64_t traceID = TileLifecycleTracer::getTraceID(*pModel);
+  TileLifecycleTracer::spanFromHandoff(traceID, "Processing response");
+  TileLifecycleTracer::begin(traceID, "Building mesh data");
+
   int32_t numberOfPrimitives = countPrimitives(*pModel);
 
   struct IntermediateLoadThreadResult {
@@ -906,8 +1312,10 @@ UnityPrepareRendererResources::prepareInLoadThread(
       // Unity Wasm can only access managed code from the main thread.
       .thenInMainThread(
 #endif
-          [tileLoadResult = std::move(tileLoadResult), rendererOptions](
-              UnityEngine::MeshDataArray&& meshDataArray) mutable {
+          [tileLoadResult = std::move(tileLoadResult),
+           rendererOptions,
+           pCache = this->_pRenderResourceCache,
+           traceID](UnityEngine::MeshDataArray&& meshDataArray) mutable {
             MeshDataResult meshDataResult{std::move(meshDataArray), {}};
             // Free the MeshDataArray if something goes wrong.
             ScopeGuard sg([&meshDataResult]() {
@@ -917,22 +1325,35 @@ UnityPrepareRendererResources::prepareInLoadThread(
             const auto* pOptions =
                 std::any_cast<CreateModelOptions>(&rendererOptions);
             if (pOptions)
-              populateMeshDataArray(meshDataResult, tileLoadResult, *pOptions);
+              populateMeshDataArray(
+                  meshDataResult,
+                  tileLoadResult,
+                  *pOptions,
+                  pCache.get());
             else
-              populateMeshDataArray(meshDataResult, tileLoadResult, {});
+              populateMeshDataArray(
+                  meshDataResult,
+                  tileLoadResult,
+                  {},
+                  pCache.get());
 
             // We're returning the MeshDataArray, so don't free it.
             sg.release();
+            TileLifecycleTracer::endAndBegin(
+                traceID,
+                "Building mesh data",
+                "Creating meshes");
             return IntermediateLoadThreadResult{
                 std::move(meshDataResult),
                 std::move(tileLoadResult)};
           })
       .thenInMainThread(
-          [asyncSystem, tileset = this->_tilesetGameObject](
+          [asyncSystem, tileset = this->_tilesetGameObject, traceID](
               IntermediateLoadThreadResult&& workerResult) mutable {
             if (tileset == nullptr) {
               // Tileset GameObject was deleted while we were loading a tile
               // (possibly play mode was exited or another cause).
+              TileLifecycleTracer::end(traceID, "Creating meshes");
               return asyncSystem.createResolvedFuture(
                   TileLoadResultAndRenderResources{
                       std::move(workerResult.tileLoadResult),
@@ -985,8 +1406,20 @@ UnityPrepareRendererResources::prepareInLoadThread(
 
             // TODO: we should be able to do this in the worker thread, even if
             // we have to do it manually.
+            const std::vector<std::optional<AxisAlignedBox>>& bounds =
+                workerResult.meshDataResult.bounds;
             for (int32_t i = 0, len = meshes.Length(); i < len; ++i) {
-              meshes[i].RecalculateBounds();
+              if (size_t(i) < bounds.size() && bounds[i]) {
+                const AxisAlignedBox& aabb = *bounds[i];
+                meshes[i].bounds(UnityEngine::Bounds::Construct(
+                    UnityTransforms::toUnity(aabb.center),
+                    UnityEngine::Vector3{
+                        float(aabb.lengthX),
+                        float(aabb.lengthY),
+                        float(aabb.lengthZ)}));
+              } else {
+                meshes[i].RecalculateBounds();
+              }
             }
 
             if (shouldCreatePhysicsMeshes) {
@@ -1012,6 +1445,10 @@ UnityPrepareRendererResources::prepareInLoadThread(
               }
 
               if (objectIds.size() > 0) {
+                TileLifecycleTracer::endAndBegin(
+                    traceID,
+                    "Creating meshes",
+                    "Baking physics meshes");
 #ifndef __EMSCRIPTEN__
                 return asyncSystem.runInWorkerThread(
 #else
@@ -1020,11 +1457,17 @@ UnityPrepareRendererResources::prepareInLoadThread(
 #endif
                     [workerResult = std::move(workerResult),
                      objectIds = std::move(objectIds),
-                     meshes = std::move(meshes)]() mutable {
+                     meshes = std::move(meshes),
+                     traceID]() mutable {
                       for (std::uint64_t objectID : objectIds) {
                         CesiumForUnity::Helpers::BakeMeshFromId(objectID);
                       }
 
+                      TileLifecycleTracer::endAndBegin(
+                          traceID,
+                          "Baking physics meshes",
+                          "Waiting for main thread");
+
                       LoadThreadResult* pResult = new LoadThreadResult{
                           std::move(meshes),
                           std::move(
@@ -1036,6 +1479,11 @@ UnityPrepareRendererResources::prepareInLoadThread(
               }
             }
 
+            TileLifecycleTracer::endAndBegin(
+                traceID,
+                "Creating meshes",
+                "Waiting for main thread");
+
             LoadThreadResult* pResult = new LoadThreadResult{
                 std::move(meshes),
                 std::move(workerResult.meshDataResult.primitiveInfos)};
@@ -1074,12 +1522,139 @@ gltfVectorToUnityVector(const std::vector<double>& values, float defaultValue) {
   return result;
 }
 
+/**
+ * @brief Describes everything that determines the Material created for a
+ * primitive, so that primitives with identical materials can share one.
+ *
+ * Materials are only shared when their descriptions are equal, so unlike a
+ * hash, two different materials can never be mistaken for one another.
+ *
+ * A texture is identified by the URL of the tile that the model was loaded
+ * from and its index in the model, which determine its image and sampler.
+ * The textures of a shared material are created once, for the first
+ * primitive that uses it.
+ *
+ * @return The description, or nothing if the material uses textures but the
+ * model has no tile URL to identify them by.
+ */
+std::optional<std::string> computeSharedMaterialKey(
+    const Model& model,
+    const CesiumPrimitiveInfo& primitiveInfo,
+    const CesiumGltf::Material* pGltfMaterial,
+    const UnityEngine::Material& baseMaterial) {
+  std::string key;
+  auto append = [&key](const auto& value) {
+    const char* pBytes = reinterpret_cast<const char*>(&value);
+    key.append(pBytes, sizeof(value));
+  };
+
+  append(CesiumForUnity::Helpers::GetObjectId(baseMaterial));
+  if (!pGltfMaterial) {
+    return key;
+  }
+
+  auto appendAll = [&append](const std::vector<double>& values) {
+    append(uint32_t(values.size()));
+    for (double value : values) {
+      append(value);
+    }
+  };
+  auto isBound = [&primitiveInfo](const TextureInfo* pTextureInfo) {
+    return pTextureInfo &&
+           primitiveInfo.uvIndexMap.contains(pTextureInfo->texCoord);
+  };
+  auto appendTexture = [&append, &primitiveInfo, &isBound](
+                           const TextureInfo* pTextureInfo) {
+    if (!isBound(pTextureInfo)) {
+      append(uint8_t(0));
+      return;
+    }
+
+    append(uint8_t(1));
+    append(pTextureInfo->index);
+    append(primitiveInfo.uvIndexMap.at(pTextureInfo->texCoord));
+  };
+  auto appendTextureTransform = [&append](const TextureInfo* pTextureInfo) {
+    if (!pTextureInfo) {
+      append(uint8_t(0));
+      return;
+    }
+
+    const ExtensionKhrTextureTransform* pTransform =
+        pTextureInfo->getExtension<ExtensionKhrTextureTransform>();
+    if (!pTransform) {
+      append(uint8_t(0));
+      return;
+    }
+
+    KhrTextureTransform textureTransform(*pTransform);
+    if (textureTransform.status() != KhrTextureTransformStatus::Valid) {
+      append(uint8_t(0));
+      return;
+    }
+
+    append(uint8_t(1));
+    append(textureTransform.offset().x);
+    append(textureTransform.offset().y);
+    append(textureTransform.scale().x);
+    append(textureTransform.scale().y);
+    append(textureTransform.rotationSineCosine().x);
+    append(textureTransform.rotationSineCosine().y);
+  };
+
+  const CesiumGltf::MaterialPBRMetallicRoughness& pbr =
+      pGltfMaterial->pbrMetallicRoughness
+          ? pGltfMaterial->pbrMetallicRoughness.value()
+          : defaultPbrMetallicRoughness;
+
+  const TextureInfo* textures[] = {
+      pbr.baseColorTexture ? &*pbr.baseColorTexture : nullptr,
+      pbr.metallicRoughnessTexture ? &*pbr.metallicRoughnessTexture : nullptr,
+      pGltfMaterial->emissiveTexture ? &*pGltfMaterial->emissiveTexture
+                                     : nullptr,
+      pGltfMaterial->normalTexture ? &*pGltfMaterial->normalTexture : nullptr,
+      pGltfMaterial->occlusionTexture ? &*pGltfMaterial->occlusionTexture
+                                      : nullptr};
+  std::string tileUrl;
+  if (std::any_of(std::begin(textures), std::end(textures), isBound)) {
+    auto urlIt = model.extras.find("Cesium3DTiles_TileUrl");
+    if (urlIt != model.extras.end()) {
+      tileUrl = urlIt->second.getStringOrDefault("");
+    }
+    if (tileUrl.empty()) {
+      return std::nullopt;
+    }
+  }
+
+  append(uint8_t(pGltfMaterial->doubleSided));
+  appendAll(pbr.baseColorFactor);
+  append(pbr.metallicFactor);
+  append(pbr.roughnessFactor);
+  appendAll(pGltfMaterial->emissiveFactor);
+  for (const TextureInfo* pTextureInfo : textures) {
+    appendTexture(pTextureInfo);
+    appendTextureTransform(pTextureInfo);
+  }
+  append(
+      pGltfMaterial->normalTexture ? pGltfMaterial->normalTexture->scale : 1.0);
+  append(
+      pGltfMaterial->occlusionTexture
+          ? pGltfMaterial->occlusionTexture->strength
+          : 1.0);
+
+  // Last, so that its length doesn't need to be stored.
+  key += tileUrl;
+
+  return key;
+}
+
 void setGltfMaterialParameterValues(
     const CesiumGltf::Model& model,
     const CesiumPrimitiveInfo& primitiveInfo,
     const CesiumGltf::Material& gltfMaterial,
     const UnityEngine::Material& unityMaterial,
-    const TilesetMaterialProperties& materialProperties) {
+    const TilesetMaterialProperties& materialProperties,
+    int64_t& textureBytes) {
   CESIUM_TRACE("Cesium::CreateMaterials");
 
   // These similar-sounding material properties are used in various render
@@ -1134,6 +1709,8 @@ void setGltfMaterialParameterValues(
       UnityEngine::Texture texture =
           TextureLoader::loadTexture(model, baseColorTexture->index, true);
       if (texture != nullptr) {
+        textureBytes +=
+            TextureLoader::computeByteSize(model, baseColorTexture->index);
         texture.hideFlags(DotNet::UnityEngine::HideFlags::HideAndDontSave);
         unityMaterial.SetTexture(
             materialProperties.getBaseColorTextureID(),
@@ -1154,6 +1731,8 @@ void setGltfMaterialParameterValues(
       UnityEngine::Texture texture =
           TextureLoader::loadTexture(model, metallicRoughness->index, false);
       if (texture != nullptr) {
+        textureBytes +=
+            TextureLoader::computeByteSize(model, metallicRoughness->index);
         texture.hideFlags(DotNet::UnityEngine::HideFlags::HideAndDontSave);
         unityMaterial.SetTexture(
             materialProperties.getMetallicRoughnessTextureID(),
@@ -1178,6 +1757,9 @@ void setGltfMaterialParameterValues(
           gltfMaterial.emissiveTexture->index,
           true);
       if (texture != nullptr) {
+        textureBytes += TextureLoader::computeByteSize(
+            model,
+            gltfMaterial.emissiveTexture->index);
         texture.hideFlags(DotNet::UnityEngine::HideFlags::HideAndDontSave);
         unityMaterial.SetTexture(
             materialProperties.getEmissiveTextureID(),
@@ -1198,6 +1780,9 @@ void setGltfMaterialParameterValues(
           gltfMaterial.normalTexture->index,
           false);
       if (texture != nullptr) {
+        textureBytes += TextureLoader::computeByteSize(
+            model,
+            gltfMaterial.normalTexture->index);
         texture.hideFlags(DotNet::UnityEngine::HideFlags::HideAndDontSave);
         unityMaterial.SetTexture(
             materialProperties.getNormalMapTextureID(),
@@ -1221,6 +1806,9 @@ void setGltfMaterialParameterValues(
           gltfMaterial.occlusionTexture->index,
           false);
       if (texture != nullptr) {
+        textureBytes += TextureLoader::computeByteSize(
+            model,
+            gltfMaterial.occlusionTexture->index);
         texture.hideFlags(DotNet::UnityEngine::HideFlags::HideAndDontSave);
         unityMaterial.SetTexture(
             materialProperties.getOcclusionTextureID(),
@@ -1402,11 +1990,11 @@ void* UnityPrepareRendererResources::prepareInMainThread(
   CESIUM_TRACE("Cesium::LoadModel");
   const Model& model = pRenderContent->getModel();
 
-  std::string name = "glTF";
-  auto urlIt = model.extras.find("Cesium3DTiles_TileUrl");
-  if (urlIt != model.extras.end()) {
-    name = urlIt->second.getStringOrDefault("glTF");
-  }
+  uint64_t traceID = TileLifecycleTracer::getTraceID(model);
+  TileLifecycleTracer::endAndBegin(
+      traceID,
+      "Waiting for main thread",
+      "Creating game object");
 
   DotNet::CesiumForUnity::Cesium3DTileset tilesetComponent =
       this->_tilesetGameObject
@@ -1418,12 +2006,20 @@ void* UnityPrepareRendererResources::prepareInMainThread(
                                 ->getOverlays()
                                 .size());
 
-  auto pModelGameObject =
-      std::make_unique<UnityEngine::GameObject>(System::String(name));
+  auto pModelGameObject = std::make_unique<UnityEngine::GameObject>(
+      CesiumForUnity::CesiumObjectPools::TileGameObjectPool().Get());
 
   const bool showTilesInHierarchy = tilesetComponent.showTilesInHierarchy();
 
   if (showTilesInHierarchy) {
+    // Names are only visible in the hierarchy, so don't pay for them
+    // otherwise.
+    std::string name = "glTF";
+    auto urlIt = model.extras.find("Cesium3DTiles_TileUrl");
+    if (urlIt != model.extras.end()) {
+      name = urlIt->second.getStringOrDefault("glTF");
+    }
+    pModelGameObject->name(System::String(name));
     pModelGameObject->hideFlags(UnityEngine::HideFlags::DontSave);
   } else {
     pModelGameObject->hideFlags(
@@ -1453,6 +2049,7 @@ void* UnityPrepareRendererResources::prepareInMainThread(
   }
 
   const bool createPhysicsMeshes = tilesetComponent.createPhysicsMeshes();
+  const bool shareMaterials = tilesetComponent.shareMaterials();
 
   int32_t meshIndex = 0;
 
@@ -1474,10 +2071,15 @@ void* UnityPrepareRendererResources::prepareInMainThread(
     }
   }
 
+  std::vector<CesiumPrimitiveRenderer> primitiveRenderers;
+  int64_t renderResourceBytes = 0;
+
   model.forEachPrimitiveInScene(
       -1,
       [&meshes,
        &primitiveInfos,
+       &primitiveRenderers,
+       &renderResourceBytes,
        &pModelGameObject,
        &tileTransform,
        &meshIndex,
@@ -1485,9 +2087,11 @@ void* UnityPrepareRendererResources::prepareInMainThread(
        pCoordinateSystem,
        createPhysicsMeshes,
        showTilesInHierarchy,
+       shareMaterials,
        &metadataComponent,
        &tile,
        &materialProperties = this->_materialProperties,
+       &sharedMaterials = this->_sharedMaterials,
        tilesetLayer = this->_tilesetGameObject.layer()](
           const Model& gltf,
           const Node& node,
@@ -1517,11 +2121,13 @@ void* UnityPrepareRendererResources::prepareInMainThread(
           return;
         }
 
-        int64_t primitiveIndex = &primitive - &mesh.primitives[0];
-        UnityEngine::GameObject primitiveGameObject(System::String(
-            "Mesh " + std::to_string(meshIndex - 1) + " Primitive " +
-            std::to_string(primitiveIndex)));
+        UnityEngine::GameObject primitiveGameObject =
+            CesiumForUnity::CesiumObjectPools::PrimitiveGameObjectPool().Get();
         if (showTilesInHierarchy) {
+          int64_t primitiveIndex = &primitive - &mesh.primitives[0];
+          primitiveGameObject.name(System::String(
+              "Mesh " + std::to_string(meshIndex - 1) + " Primitive " +
+              std::to_string(primitiveIndex)));
           primitiveGameObject.hideFlags(UnityEngine::HideFlags::DontSave);
         } else {
           primitiveGameObject.hideFlags(
@@ -1529,8 +2135,13 @@ void* UnityPrepareRendererResources::prepareInMainThread(
               UnityEngine::HideFlags::HideInHierarchy);
         }
 
-        primitiveGameObject.transform().parent(pModelGameObject->transform());
+        primitiveGameObject.transform().SetParent(
+            pModelGameObject->transform(),
+            false);
         primitiveGameObject.layer(tilesetLayer);
+        // The tile itself is still inactive, so this won't enable anything
+        // until the tile is shown.
+        primitiveGameObject.SetActive(true);
         glm::dmat4 modelToEcef = tileTransform * transform;
 
         CesiumForUnity::CesiumGlobeAnchor anchor =
@@ -1541,12 +2152,18 @@ void* UnityPrepareRendererResources::prepareInMainThread(
         anchor.localToGlobeFixedMatrix(
             UnityTransforms::toUnityMathematics(modelToEcef));
 
+        // Pooled primitive game objects always have these components.
         UnityEngine::MeshFilter meshFilter =
-            primitiveGameObject.AddComponent<UnityEngine::MeshFilter>();
+            primitiveGameObject.GetComponent<UnityEngine::MeshFilter>();
         meshFilter.sharedMesh(unityMesh);
+        renderResourceBytes += primitiveInfo.meshBytes;
 
         UnityEngine::MeshRenderer meshRenderer =
-            primitiveGameObject.AddComponent<UnityEngine::MeshRenderer>();
+            primitiveGameObject.GetComponent<UnityEngine::MeshRenderer>();
+        primitiveRenderers.emplace_back(CesiumPrimitiveRenderer{
+            meshRenderer,
+            UnityEngine::Material(nullptr),
+            size_t(meshIndex - 1)});
 
         const Material* pMaterial =
             Model::getSafe(&gltf.materials, primitive.material);
@@ -1566,17 +2183,34 @@ void* UnityPrepareRendererResources::prepareInMainThread(
           }
         }
 
-        UnityEngine::Material material =
-            UnityEngine::Object::Instantiate(opaqueMaterial);
-        material.hideFlags(UnityEngine::HideFlags::HideAndDontSave);
-        meshRenderer.material(material);
-        if (pMaterial) {
-          setGltfMaterialParameterValues(
-              gltf,
-              primitiveInfo,
-              *pMaterial,
-              material,
-              materialProperties);
+        auto createMaterial = [&](int64_t& textureBytes) {
+          UnityEngine::Material material =
+              UnityEngine::Object::Instantiate(opaqueMaterial);
+          material.hideFlags(UnityEngine::HideFlags::HideAndDontSave);
+          if (pMaterial) {
+            setGltfMaterialParameterValues(
+                gltf,
+                primitiveInfo,
+                *pMaterial,
+                material,
+                materialProperties,
+                textureBytes);
+          }
+          return material;
+        };
+
+        std::optional<std::string> sharedMaterialKey =
+            shareMaterials ? computeSharedMaterialKey(
+                                 gltf,
+                                 primitiveInfo,
+                                 pMaterial,
+                                 opaqueMaterial)
+                           : std::nullopt;
+        if (sharedMaterialKey) {
+          meshRenderer.sharedMaterial(
+              sharedMaterials.acquire(*sharedMaterialKey, createMaterial));
+        } else {
+          meshRenderer.material(createMaterial(renderResourceBytes));
         }
 
         if (primitiveInfo.mode == CesiumGltf::MeshPrimitive::Mode::POINTS) {
@@ -1619,8 +2253,17 @@ void* UnityPrepareRendererResources::prepareInMainThread(
               // This should not trigger mesh baking for physics, because the
               // meshes were already baked in the worker thread.
               UnityEngine::MeshCollider meshCollider =
-                  primitiveGameObject.AddComponent<UnityEngine::MeshCollider>();
+                  primitiveGameObject.GetComponent<UnityEngine::MeshCollider>();
+              if (meshCollider == nullptr) {
+                meshCollider =
+                    primitiveGameObject
+                        .AddComponent<UnityEngine::MeshCollider>();
+              }
+              meshCollider.enabled(true);
               meshCollider.sharedMesh(unityMesh);
+              renderResourceBytes += estimateMeshColliderBytes(
+                  unityMesh.vertexCount(),
+                  primitiveInfo.indexCount);
             }
             break;
           }
@@ -1648,9 +2291,24 @@ void* UnityPrepareRendererResources::prepareInMainThread(
 
   tilesetComponent.BroadcastNewGameObjectCreated(*pModelGameObject);
 
+  // Handlers of the event above may replace materials, so only look them up
+  // afterward.
+  for (CesiumPrimitiveRenderer& primitiveRenderer : primitiveRenderers) {
+    primitiveRenderer.material = primitiveRenderer.meshRenderer.sharedMaterial();
+  }
+
   CesiumGltfGameObject* pCesiumGameObject = new CesiumGltfGameObject{
       std::move(pModelGameObject),
-      std::move(pLoadThreadResult->primitiveInfos)};
+      std::move(pLoadThreadResult->primitiveInfos),
+      std::move(primitiveRenderers)};
+  pCesiumGameObject->gameObjectID = CesiumForUnity::Helpers::GetObjectId(
+      *pCesiumGameObject->pGameObject);
+  pCesiumGameObject->traceID = traceID;
+  pCesiumGameObject->renderResourceBytes = renderResourceBytes;
+  this->_renderResourceBytes += renderResourceBytes;
+  this->_terrainHeightCache.tileLoaded(tile);
+
+  TileLifecycleTracer::end(traceID, "Creating game object");
 
   return pCesiumGameObject;
 }
@@ -1676,9 +2334,26 @@ void freePrimitiveFeatures(
   }
 }
 
+void destroyMaterialAndTextures(const UnityEngine::Material& material) {
+  System::Collections::Generic::List1<int> textureIDs;
+  material.GetTexturePropertyNameIDs(textureIDs);
+  for (int32_t i = 0, len = textureIDs.Count(); i < len; ++i) {
+    int32_t textureID = textureIDs[i];
+    UnityEngine::Texture texture = material.GetTexture(textureID);
+    if (texture != nullptr &&
+        (texture.hideFlags() & UnityEngine::HideFlags::HideAndDontSave) ==
+            UnityEngine::HideFlags::HideAndDontSave) {
+      UnityLifetime::Destroy(texture);
+    }
+  }
+
+  UnityLifetime::Destroy(material);
+}
+
 void freePrimitiveGameObject(
     const DotNet::UnityEngine::GameObject& primitiveGameObject,
-    const DotNet::CesiumForUnity::CesiumMetadata& metadataComponent) {
+    const DotNet::CesiumForUnity::CesiumMetadata& metadataComponent,
+    SharedMaterialCache& sharedMaterials) {
   // Kept for backwards compatibility.
   if (metadataComponent != nullptr) {
     metadataComponent.NativeImplementation().removeMetadata(
@@ -1691,20 +2366,9 @@ void freePrimitiveGameObject(
       primitiveGameObject.GetComponent<UnityEngine::MeshRenderer>();
   if (meshRenderer != nullptr) {
     UnityEngine::Material material = meshRenderer.sharedMaterial();
-
-    System::Collections::Generic::List1<int> textureIDs;
-    material.GetTexturePropertyNameIDs(textureIDs);
-    for (int32_t i = 0, len = textureIDs.Count(); i < len; ++i) {
-      int32_t textureID = textureIDs[i];
-      UnityEngine::Texture texture = material.GetTexture(textureID);
-      if (texture != nullptr &&
-          (texture.hideFlags() & UnityEngine::HideFlags::HideAndDontSave) ==
-              UnityEngine::HideFlags::HideAndDontSave) {
-        UnityLifetime::Destroy(texture);
-      }
+    if (sharedMaterials.release(material)) {
+      destroyMaterialAndTextures(material);
     }
-
-    UnityLifetime::Destroy(material);
   }
 
   UnityEngine::MeshFilter meshFilter =
@@ -1716,6 +2380,15 @@ void freePrimitiveGameObject(
 
   // The MeshCollider shares a mesh with the MeshFilter, so no need to
   // destroy it explicitly.
+
+  // Only objects that came from the pool can go back to it. Anything else,
+  // such as a child added by user code, is simply destroyed.
+  if (meshFilter != nullptr && meshRenderer != nullptr) {
+    CesiumForUnity::CesiumObjectPools::PrimitiveGameObjectPool().Release(
+        primitiveGameObject);
+  } else {
+    UnityLifetime::Destroy(primitiveGameObject);
+  }
 }
 
 void freeModelMetadata(const DotNet::UnityEngine::GameObject& modelGameObject) {
@@ -1743,6 +2416,8 @@ void UnityPrepareRendererResources::free(
     void* pLoadThreadResult,
     void* pMainThreadResult) noexcept {
   try {
+    this->_terrainHeightCache.tileUnloaded(tile);
+
     if (pLoadThreadResult) {
       LoadThreadResult* pTyped =
           static_cast<LoadThreadResult*>(pLoadThreadResult);
@@ -1757,6 +2432,38 @@ void UnityPrepareRendererResources::free(
       std::unique_ptr<CesiumGltfGameObject> pCesiumGameObject(
           static_cast<CesiumGltfGameObject*>(pMainThreadResult));
 
+      if (pCesiumGameObject->isPredicted) {
+        ++this->_wastedPredictedTiles;
+        this->_wastedPredictedBytes += pCesiumGameObject->predictedBytes;
+      }
+
+      this->_renderResourceBytes -= pCesiumGameObject->renderResourceBytes;
+
+      if (!pCesiumGameObject->pendingRasterOverlays.empty()) {
+        std::erase(
+            this->_gameObjectsWithPendingOverlays,
+            pCesiumGameObject.get());
+      }
+
+      if (pCesiumGameObject->pOverlayComposite) {
+        // Any composite still in progress is discarded when it completes.
+        if (pCesiumGameObject->pOverlayComposite->queued) {
+          std::erase(
+              this->_gameObjectsWithCompositeWork,
+              pCesiumGameObject.get());
+        }
+
+        this->_renderResourceBytes -=
+            pCesiumGameObject->pOverlayComposite->textureBytes;
+
+        for (const UnityEngine::Texture& texture :
+             pCesiumGameObject->pOverlayComposite->textures) {
+          if (texture != nullptr) {
+            CesiumForUnity::CesiumRasterOverlayTexturePool::Release(texture);
+          }
+        }
+      }
+
       // It's possible that the game object has already been destroyed. In which
       // case Unity will throw a MissingReferenceException if we try to use it.
       // So don't do that.
@@ -1768,20 +2475,23 @@ void UnityPrepareRendererResources::free(
         UnityEngine::Transform parentTransform =
             pCesiumGameObject->pGameObject->transform();
 
-        // Destroying primitives will remove them from the child list, so
+        // Releasing primitives will remove them from the child list, so
         // work backwards.
         for (int32_t i = parentTransform.childCount() - 1; i >= 0; --i) {
           UnityEngine::GameObject primitiveGameObject =
               parentTransform.GetChild(i).gameObject();
-          freePrimitiveGameObject(primitiveGameObject, metadataComponent);
-          UnityLifetime::Destroy(primitiveGameObject);
+          freePrimitiveGameObject(
+              primitiveGameObject,
+              metadataComponent,
+              this->_sharedMaterials);
         }
 
         if (metadataComponent == nullptr) {
           freeModelMetadata(*pCesiumGameObject->pGameObject);
         }
 
-        UnityLifetime::Destroy(*pCesiumGameObject->pGameObject);
+        CesiumForUnity::CesiumObjectPools::TileGameObjectPool().Release(
+            *pCesiumGameObject->pGameObject);
       }
     }
   } catch (...) {
@@ -1802,12 +2512,39 @@ void* UnityPrepareRendererResources::prepareRasterInLoadThread(
 void* UnityPrepareRendererResources::prepareRasterInMainThread(
     CesiumRasterOverlays::RasterOverlayTile& rasterTile,
     void* pLoadThreadResult) {
-  auto pTexture = std::make_unique<UnityEngine::Texture>(
-      TextureLoader::loadTexture(*rasterTile.getImage(), true));
-  pTexture->wrapMode(UnityEngine::TextureWrapMode::Clamp);
-  pTexture->filterMode(UnityEngine::FilterMode::Trilinear);
-  pTexture->anisoLevel(16);
-  return pTexture.release();
+  auto pResources = std::make_unique<CesiumRasterOverlayTexture>();
+
+  if (this->_compositeOverlays) {
+    // The image is only needed to create each tile's composite.
+    pResources->pImage = rasterTile.getImage();
+    return pResources.release();
+  }
+
+  const CesiumImage::ImageAsset& image = *rasterTile.getImage();
+  UnityEngine::Texture texture =
+      CesiumForUnity::CesiumRasterOverlayTexturePool::maximumPooledBytes() > 0
+          ? TextureLoader::loadPooledTexture(image, true)
+          : TextureLoader::loadTexture(image, true);
+
+  // An atlas slice has the same size and format as the texture it is copied
+  // from.
+  pResources->textureBytes = TextureLoader::computeByteSize(image);
+  this->_renderResourceBytes += pResources->textureBytes;
+
+  if (this->_useOverlayAtlas) {
+    pResources->atlasSlice = this->_overlayAtlas.add(texture);
+    if (pResources->atlasSlice) {
+      // The atlas has its own copy now.
+      CesiumForUnity::CesiumRasterOverlayTexturePool::Release(texture);
+      return pResources.release();
+    }
+  }
+
+  texture.wrapMode(UnityEngine::TextureWrapMode::Clamp);
+  texture.filterMode(UnityEngine::FilterMode::Trilinear);
+  texture.anisoLevel(16);
+  pResources->texture = texture;
+  return pResources.release();
 }
 
 void UnityPrepareRendererResources::freeRaster(
@@ -1815,10 +2552,15 @@ void UnityPrepareRendererResources::freeRaster(
     void* pLoadThreadResult,
     void* pMainThreadResult) noexcept {
   if (pMainThreadResult) {
-    std::unique_ptr<UnityEngine::Texture> pTexture(
-        static_cast<UnityEngine::Texture*>(pMainThreadResult));
-    if (*pTexture != nullptr) {
-      UnityLifetime::Destroy(*pTexture);
+    std::unique_ptr<CesiumRasterOverlayTexture> pResources(
+        static_cast<CesiumRasterOverlayTexture*>(pMainThreadResult));
+    this->_renderResourceBytes -= pResources->textureBytes;
+    if (pResources->atlasSlice) {
+      this->_overlayAtlas.remove(*pResources->atlasSlice);
+    } else if (pResources->texture != nullptr) {
+      // Textures that did not come from the pool are simply destroyed.
+      CesiumForUnity::CesiumRasterOverlayTexturePool::Release(
+          pResources->texture);
     }
   }
 }
@@ -1839,78 +2581,181 @@ void UnityPrepareRendererResources::attachRasterInMainThread(
 
   CesiumGltfGameObject* pCesiumGameObject =
       static_cast<CesiumGltfGameObject*>(pRenderContent->getRenderResources());
-  UnityEngine::Texture* pTexture =
-      static_cast<UnityEngine::Texture*>(pMainThreadRendererResources);
-  if (!pCesiumGameObject || !pCesiumGameObject->pGameObject || !pTexture)
+  const CesiumRasterOverlayTexture* pOverlayTexture =
+      static_cast<const CesiumRasterOverlayTexture*>(
+          pMainThreadRendererResources);
+  if (!pCesiumGameObject || !pCesiumGameObject->pGameObject ||
+      !pOverlayTexture)
     return;
 
-  std::string key = rasterTile.getOverlay().getName();
+  if (this->_compositeOverlays) {
+    if (!pCesiumGameObject->pOverlayComposite) {
+      pCesiumGameObject->pOverlayComposite =
+          std::make_shared<CesiumRasterOverlayComposite>();
+    }
 
-  // We're assuming here that the order of primitives in the transform chain
-  // is the same as the order in the `primitiveInfos`, which should
-  // always be true.
-  uint32_t primitiveIndex = 0;
+    CesiumRasterOverlayComposite& composite =
+        *pCesiumGameObject->pOverlayComposite;
+    composite.overlays.emplace_back(CesiumAttachedRasterOverlay{
+        rasterTile.getOverlay().getName(),
+        overlayTextureCoordinateID,
+        pOverlayTexture,
+        translation,
+        scale});
+    ++composite.version;
+
+    if (!composite.queued) {
+      composite.queued = true;
+      this->_gameObjectsWithCompositeWork.emplace_back(pCesiumGameObject);
+    }
+    return;
+  }
 
-  UnityEngine::Transform transform =
-      pCesiumGameObject->pGameObject->transform();
-  for (int32_t i = 0, len = transform.childCount(); i < len; ++i) {
-    UnityEngine::Transform childTransform = transform.GetChild(i);
-    if (childTransform == nullptr)
-      continue;
+  // A tile usually receives several overlays in the same frame, so defer the
+  // work until they can all be applied at once.
+  if (pCesiumGameObject->pendingRasterOverlays.empty()) {
+    this->_gameObjectsWithPendingOverlays.emplace_back(pCesiumGameObject);
+  }
 
-    UnityEngine::GameObject child = childTransform.gameObject();
-    if (child == nullptr)
-      continue;
+  pCesiumGameObject->pendingRasterOverlays.emplace_back(
+      CesiumAttachedRasterOverlay{
+          rasterTile.getOverlay().getName(),
+          overlayTextureCoordinateID,
+          pOverlayTexture,
+          translation,
+          scale});
+}
 
-    UnityEngine::MeshRenderer meshRenderer =
-        child.GetComponent<UnityEngine::MeshRenderer>();
-    if (meshRenderer == nullptr)
-      continue;
+void UnityPrepareRendererResources::applyPendingRasterOverlays() {
+  if (this->_gameObjectsWithPendingOverlays.empty() &&
+      this->_gameObjectsWithCompositeWork.empty()) {
+    return;
+  }
 
-    UnityEngine::Material material = meshRenderer.sharedMaterial();
-    if (material == nullptr)
+  CESIUM_TRACE("UnityPrepareRendererResources::applyPendingRasterOverlays");
+  for (CesiumGltfGameObject* pCesiumGameObject :
+       this->_gameObjectsWithPendingOverlays) {
+    this->applyPendingRasterOverlays(*pCesiumGameObject);
+    pCesiumGameObject->pendingRasterOverlays.clear();
+  }
+
+  this->_gameObjectsWithPendingOverlays.clear();
+
+  std::erase_if(
+      this->_gameObjectsWithCompositeWork,
+      [this](CesiumGltfGameObject* pCesiumGameObject) {
+        if (this->updateOverlayComposite(*pCesiumGameObject)) {
+          return false;
+        }
+        pCesiumGameObject->pOverlayComposite->queued = false;
+        return true;
+      });
+}
+
+void UnityPrepareRendererResources::applyPendingRasterOverlays(
+    CesiumGltfGameObject& gltfGameObject) {
+  const std::vector<CesiumAttachedRasterOverlay>& overlays =
+      gltfGameObject.pendingRasterOverlays;
+  if (overlays.empty() || *gltfGameObject.pGameObject == nullptr) {
+    return;
+  }
+
+  UnityEngine::MaterialPropertyBlock& block = this->_overlayPropertyBlock;
+
+  for (const CesiumPrimitiveRenderer& primitiveRenderer :
+       gltfGameObject.primitiveRenderers) {
+    const UnityEngine::Material& material = primitiveRenderer.material;
+    if (material == nullptr || primitiveRenderer.meshRenderer == nullptr)
       continue;
 
     const CesiumPrimitiveInfo& primitiveInfo =
-        pCesiumGameObject->primitiveInfos[primitiveIndex++];
+        gltfGameObject.primitiveInfos[primitiveRenderer.primitiveInfoIndex];
+
+    // A material shared with other tiles can't hold this tile's overlays, so
+    // they are set on the renderer instead. Atlas slices are always set on the
+    // renderer, so that the material remains shareable.
+    const bool isShared = this->_sharedMaterials.isShared(material);
+    bool hasBlock = false;
+
+    for (const CesiumAttachedRasterOverlay& overlay : overlays) {
+      // Note: The overlay texture coordinate index corresponds to the glTF
+      // attribute _CESIUMOVERLAY_<i>. Here we retrieve the Unity texture
+      // coordinate index corresponding to the glTF texture coordinate index
+      // for this primitive.
+      auto texCoordIndexIt = primitiveInfo.rasterOverlayUvIndexMap.find(
+          overlay.overlayTextureCoordinateID);
+      if (texCoordIndexIt == primitiveInfo.rasterOverlayUvIndexMap.end()) {
+        // The associated UV coords for this overlay are missing.
+        // TODO: log warning?
+        continue;
+      }
 
-    // Note: The overlay texture coordinate index corresponds to the glTF
-    // attribute _CESIUMOVERLAY_<i>. Here we retrieve the Unity texture
-    // coordinate index corresponding to the glTF texture coordinate index for
-    // this primitive.
-    auto texCoordIndexIt =
-        primitiveInfo.rasterOverlayUvIndexMap.find(overlayTextureCoordinateID);
-    if (texCoordIndexIt == primitiveInfo.rasterOverlayUvIndexMap.end()) {
-      // The associated UV coords for this overlay are missing.
-      // TODO: log warning?
-      continue;
-    }
+      // Note: The overlay index is NOT the same as the overlay texture
+      // coordinate index. For instance, multiple overlays could point to the
+      // same overlay UV index - multiple overlays can use the _CESIUMOVERLAY_0
+      // attribute for example. The _CESIUMOVERLAY_<i> attributes correspond
+      // to unique _projections_, not unique overlays.
+      const std::optional<RasterOverlayAtlas::Slice>& atlasSlice =
+          overlay.pTexture->atlasSlice;
+      const bool useBlock = atlasSlice || isShared;
+      if (useBlock && !hasBlock) {
+        primitiveRenderer.meshRenderer.GetPropertyBlock(block);
+        hasBlock = true;
+      }
 
-    // Note: The overlay index is NOT the same as the overlay texture coordinate
-    // index. For instance, multiple overlays could point to the same overlay UV
-    // index - multiple overlays can use the _CESIUMOVERLAY_0 attribute for
-    // example. The _CESIUMOVERLAY_<i> attributes correspond to unique
-    // _projections_, not unique overlays.
-    auto maybeID =
-        this->_materialProperties.getOverlayTextureCoordinateIndexID(key);
-    if (maybeID) {
-      material.SetFloat(*maybeID, static_cast<float>(texCoordIndexIt->second));
-    }
+      auto maybeID = this->_materialProperties
+                         .getOverlayTextureCoordinateIndexID(overlay.key);
+      if (maybeID) {
+        float texCoordIndex = static_cast<float>(texCoordIndexIt->second);
+        if (useBlock) {
+          block.SetFloat(*maybeID, texCoordIndex);
+        } else {
+          material.SetFloat(*maybeID, texCoordIndex);
+        }
+      }
 
-    maybeID = this->_materialProperties.getOverlayTextureID(key);
-    if (maybeID) {
-      material.SetTexture(*maybeID, *pTexture);
-    }
+      if (atlasSlice) {
+        maybeID =
+            this->_materialProperties.getOverlayTextureArrayID(overlay.key);
+        if (maybeID) {
+          block.SetTexture(*maybeID, atlasSlice->texture);
+        }
+
+        maybeID = this->_materialProperties.getOverlayTextureSliceIndexID(
+            overlay.key);
+        if (maybeID) {
+          block.SetFloat(*maybeID, static_cast<float>(atlasSlice->index));
+        }
+      } else {
+        maybeID = this->_materialProperties.getOverlayTextureID(overlay.key);
+        if (maybeID) {
+          if (useBlock) {
+            block.SetTexture(*maybeID, overlay.pTexture->texture);
+          } else {
+            material.SetTexture(*maybeID, overlay.pTexture->texture);
+          }
+        }
+      }
 
-    UnityEngine::Vector4 translationAndScale{
-        float(translation.x),
-        float(translation.y),
-        float(scale.x),
-        float(scale.y)};
+      UnityEngine::Vector4 translationAndScale{
+          float(overlay.translation.x),
+          float(overlay.translation.y),
+          float(overlay.scale.x),
+          float(overlay.scale.y)};
+
+      maybeID = this->_materialProperties.getOverlayTranslationAndScaleID(
+          overlay.key);
+      if (maybeID) {
+        if (useBlock) {
+          block.SetVector(*maybeID, translationAndScale);
+        } else {
+          material.SetVector(*maybeID, translationAndScale);
+        }
+      }
+    }
 
-    maybeID = this->_materialProperties.getOverlayTranslationAndScaleID(key);
-    if (maybeID) {
-      material.SetVector(*maybeID, translationAndScale);
+    if (hasBlock) {
+      primitiveRenderer.meshRenderer.SetPropertyBlock(block);
     }
   }
 }
@@ -1929,38 +2774,359 @@ void UnityPrepareRendererResources::detachRasterInMainThread(
 
   CesiumGltfGameObject* pCesiumGameObject =
       static_cast<CesiumGltfGameObject*>(pRenderContent->getRenderResources());
-  UnityEngine::Texture* pTexture =
-      static_cast<UnityEngine::Texture*>(pMainThreadRendererResources);
+  const CesiumRasterOverlayTexture* pOverlayTexture =
+      static_cast<const CesiumRasterOverlayTexture*>(
+          pMainThreadRendererResources);
   if (pCesiumGameObject == nullptr ||
-      pCesiumGameObject->pGameObject == nullptr ||
-      *pCesiumGameObject->pGameObject == nullptr || pTexture == nullptr ||
-      *pTexture == nullptr)
+      pCesiumGameObject->pGameObject == nullptr || pOverlayTexture == nullptr)
     return;
 
-  UnityEngine::Transform transform =
-      pCesiumGameObject->pGameObject->transform();
-  for (int32_t i = 0, len = transform.childCount(); i < len; ++i) {
-    UnityEngine::Transform childTransform = transform.GetChild(i);
-    if (childTransform == nullptr)
-      continue;
+  const std::string& key = rasterTile.getOverlay().getName();
+
+  if (pCesiumGameObject->pOverlayComposite) {
+    // The composite is recreated without this overlay. Until then, the old
+    // composite stays in place; it doesn't reference the overlay's resources.
+    CesiumRasterOverlayComposite& composite =
+        *pCesiumGameObject->pOverlayComposite;
+    std::erase_if(
+        composite.overlays,
+        [pOverlayTexture, &key](const auto& overlay) {
+          return overlay.pTexture == pOverlayTexture && overlay.key == key;
+        });
+    ++composite.version;
+
+    if (!composite.queued) {
+      composite.queued = true;
+      this->_gameObjectsWithCompositeWork.emplace_back(pCesiumGameObject);
+    }
+    return;
+  }
+
+  // An overlay that was never applied doesn't need to be removed from the
+  // renderers, but it must not be applied later either, because its texture
+  // may be freed.
+  std::vector<CesiumAttachedRasterOverlay>& pending =
+      pCesiumGameObject->pendingRasterOverlays;
+  std::erase_if(pending, [pOverlayTexture, &key](const auto& overlay) {
+    return overlay.pTexture == pOverlayTexture && overlay.key == key;
+  });
+
+  if (*pCesiumGameObject->pGameObject == nullptr ||
+      (!pOverlayTexture->atlasSlice && pOverlayTexture->texture == nullptr))
+    return;
 
-    UnityEngine::GameObject child = childTransform.gameObject();
-    if (child == nullptr)
+  for (const CesiumPrimitiveRenderer& primitiveRenderer :
+       pCesiumGameObject->primitiveRenderers) {
+    const UnityEngine::MeshRenderer& meshRenderer =
+        primitiveRenderer.meshRenderer;
+    const UnityEngine::Material& material = primitiveRenderer.material;
+    if (material == nullptr || meshRenderer == nullptr)
       continue;
 
-    UnityEngine::MeshRenderer meshRenderer =
-        child.GetComponent<UnityEngine::MeshRenderer>();
-    if (meshRenderer == nullptr)
+    if (pOverlayTexture->atlasSlice) {
+      // The shader treats a negative slice index as no overlay.
+      auto maybeID =
+          this->_materialProperties.getOverlayTextureSliceIndexID(key);
+      if (maybeID) {
+        UnityEngine::MaterialPropertyBlock& block = this->_overlayPropertyBlock;
+        meshRenderer.GetPropertyBlock(block);
+        block.SetFloat(*maybeID, -1.0f);
+        meshRenderer.SetPropertyBlock(block);
+      }
       continue;
+    }
 
-    UnityEngine::Material material = meshRenderer.sharedMaterial();
-    if (material == nullptr)
+    auto maybeID = this->_materialProperties.getOverlayTextureID(key);
+    if (!maybeID) {
       continue;
+    }
 
-    auto maybeID = this->_materialProperties.getOverlayTextureID(
-        rasterTile.getOverlay().getName());
-    if (maybeID) {
+    if (this->_sharedMaterials.isShared(material)) {
+      // A MaterialPropertyBlock can't hold a null texture, so use the same
+      // black texture that the overlay texture properties default to.
+      UnityEngine::MaterialPropertyBlock& block = this->_overlayPropertyBlock;
+      meshRenderer.GetPropertyBlock(block);
+      block.SetTexture(*maybeID, UnityEngine::Texture2D::blackTexture());
+      meshRenderer.SetPropertyBlock(block);
+    } else {
       material.SetTexture(*maybeID, UnityEngine::Texture(nullptr));
     }
   }
 }
+
+bool UnityPrepareRendererResources::updateOverlayComposite(
+    CesiumGltfGameObject& gltfGameObject) {
+  CesiumRasterOverlayComposite& composite = *gltfGameObject.pOverlayComposite;
+
+  if (composite.completedVersion) {
+    // A composite of inputs that have since changed is discarded, and another
+    // is started below.
+    if (*composite.completedVersion == composite.version) {
+      this->applyOverlayComposite(gltfGameObject, composite.completedGroups);
+      composite.appliedVersion = composite.version;
+    }
+    composite.completedVersion.reset();
+    composite.completedGroups.clear();
+  }
+
+  if (composite.failedVersion) {
+    // The overlays could not be composited, so each is bound as a texture of
+    // its own instead.
+    if (*composite.failedVersion == composite.version) {
+      std::vector<CesiumRasterOverlayCompositeGroup> groups;
+      for (const CesiumAttachedRasterOverlay& overlay : composite.overlays) {
+        groups.emplace_back(CesiumRasterOverlayCompositeGroup{
+            overlay.overlayTextureCoordinateID,
+            overlay.key,
+            {},
+            {},
+            overlay.pTexture->pImage,
+            overlay.translation,
+            overlay.scale});
+      }
+      this->applyOverlayComposite(gltfGameObject, groups);
+      composite.appliedVersion = composite.version;
+    }
+    composite.failedVersion.reset();
+  }
+
+  if (composite.inFlight) {
+    return true;
+  }
+
+  if (composite.appliedVersion == composite.version) {
+    return false;
+  }
+
+  if (composite.overlays.empty()) {
+    this->applyOverlayComposite(gltfGameObject, {});
+    composite.appliedVersion = composite.version;
+    return false;
+  }
+
+  // Overlays are blended in the order they were added to the tileset, so that
+  // later overlays are drawn on top as they are with separate textures.
+  std::vector<const CesiumAttachedRasterOverlay*> overlays;
+  overlays.reserve(composite.overlays.size());
+  for (const CesiumAttachedRasterOverlay& overlay : composite.overlays) {
+    overlays.emplace_back(&overlay);
+  }
+
+  auto getOrder = [this](const CesiumAttachedRasterOverlay* pOverlay) {
+    return this->_materialProperties.getOverlayIndex(pOverlay->key)
+        .value_or(std::numeric_limits<int32_t>::max());
+  };
+  std::stable_sort(
+      overlays.begin(),
+      overlays.end(),
+      [&getOrder](const auto* pLeft, const auto* pRight) {
+        return getOrder(pLeft) < getOrder(pRight);
+      });
+
+  std::vector<CesiumRasterOverlayCompositeGroup> groups;
+  for (const CesiumAttachedRasterOverlay* pOverlay : overlays) {
+    auto groupIt = std::find_if(
+        groups.begin(),
+        groups.end(),
+        [pOverlay](const CesiumRasterOverlayCompositeGroup& group) {
+          return group.overlayTextureCoordinateID ==
+                 pOverlay->overlayTextureCoordinateID;
+        });
+
+    if (groupIt == groups.end()) {
+      groupIt = groups.emplace(
+          groups.end(),
+          CesiumRasterOverlayCompositeGroup{
+              pOverlay->overlayTextureCoordinateID,
+              pOverlay->key,
+              {},
+              {},
+              nullptr});
+    } else if (
+        groupIt->key != pOverlay->key &&
+        std::find(
+            groupIt->otherKeys.begin(),
+            groupIt->otherKeys.end(),
+            pOverlay->key) == groupIt->otherKeys.end()) {
+      groupIt->otherKeys.emplace_back(pOverlay->key);
+    }
+
+    if (pOverlay->pTexture->pImage) {
+      groupIt->layers.emplace_back(RasterOverlayCompositeLayer{
+          pOverlay->pTexture->pImage,
+          pOverlay->translation,
+          pOverlay->scale});
+    }
+  }
+
+  // The layers hold references to the overlay images, so the worker doesn't
+  // depend on the overlay tiles staying loaded.
+  composite.inFlight = true;
+  const uint64_t version = composite.version;
+  std::weak_ptr<CesiumRasterOverlayComposite> pWeakComposite =
+      gltfGameObject.pOverlayComposite;
+
+  getAsyncSystem()
+      .runInWorkerThread([groups = std::move(groups)]() mutable {
+        CESIUM_TRACE("RasterOverlayCompositor::composite");
+        for (CesiumRasterOverlayCompositeGroup& group : groups) {
+          group.pImage = RasterOverlayCompositor::composite(group.layers);
+          group.layers.clear();
+        }
+        return std::move(groups);
+      })
+      .thenInMainThread(
+          [pWeakComposite,
+           version](std::vector<CesiumRasterOverlayCompositeGroup>&& groups) {
+            // The tile may have been unloaded in the meantime.
+            std::shared_ptr<CesiumRasterOverlayComposite> pComposite =
+                pWeakComposite.lock();
+            if (!pComposite) {
+              return;
+            }
+
+            pComposite->inFlight = false;
+            pComposite->completedVersion = version;
+            pComposite->completedGroups = std::move(groups);
+          })
+      .catchInMainThread([pWeakComposite, version](std::exception&& e) {
+        UnityEngine::Debug::LogWarning(System::String(
+            std::string("A tile's raster overlays could not be composited, so "
+                        "they will be applied as separate textures instead: ") +
+            e.what()));
+
+        std::shared_ptr<CesiumRasterOverlayComposite> pComposite =
+            pWeakComposite.lock();
+        if (pComposite) {
+          pComposite->inFlight = false;
+          pComposite->failedVersion = version;
+        }
+      });
+
+  return true;
+}
+
+void UnityPrepareRendererResources::applyOverlayComposite(
+    CesiumGltfGameObject& gltfGameObject,
+    const std::vector<CesiumRasterOverlayCompositeGroup>& groups) {
+  CesiumRasterOverlayComposite& composite = *gltfGameObject.pOverlayComposite;
+
+  for (const UnityEngine::Texture& texture : composite.textures) {
+    if (texture != nullptr) {
+      CesiumForUnity::CesiumRasterOverlayTexturePool::Release(texture);
+    }
+  }
+  composite.textures.clear();
+  this->_renderResourceBytes -= composite.textureBytes;
+  composite.textureBytes = 0;
+
+  if (*gltfGameObject.pGameObject == nullptr) {
+    composite.appliedKeys.clear();
+    return;
+  }
+
+  for (const CesiumRasterOverlayCompositeGroup& group : groups) {
+    UnityEngine::Texture texture(nullptr);
+    if (group.pImage) {
+      texture = TextureLoader::loadTexture(*group.pImage, true);
+      texture.wrapMode(UnityEngine::TextureWrapMode::Clamp);
+      texture.filterMode(UnityEngine::FilterMode::Trilinear);
+      texture.anisoLevel(16);
+      composite.textureBytes += TextureLoader::computeByteSize(*group.pImage);
+    }
+    composite.textures.emplace_back(texture);
+  }
+  this->_renderResourceBytes += composite.textureBytes;
+
+  UnityEngine::MaterialPropertyBlock& block = this->_overlayPropertyBlock;
+
+  for (const CesiumPrimitiveRenderer& primitiveRenderer :
+       gltfGameObject.primitiveRenderers) {
+    const UnityEngine::Material& material = primitiveRenderer.material;
+    if (material == nullptr || primitiveRenderer.meshRenderer == nullptr)
+      continue;
+
+    const CesiumPrimitiveInfo& primitiveInfo =
+        gltfGameObject.primitiveInfos[primitiveRenderer.primitiveInfoIndex];
+
+    const bool isShared = this->_sharedMaterials.isShared(material);
+    if (isShared) {
+      primitiveRenderer.meshRenderer.GetPropertyBlock(block);
+    }
+
+    // A MaterialPropertyBlock can't hold a null texture, so use the same black
+    // texture that the overlay texture properties default to.
+    auto setTexture = [&](const std::string& key,
+                          const UnityEngine::Texture& texture) {
+      auto maybeID = this->_materialProperties.getOverlayTextureID(key);
+      if (!maybeID) {
+        return;
+      }
+      if (isShared) {
+        block.SetTexture(
+            *maybeID,
+            texture != nullptr ? texture
+                               : UnityEngine::Texture2D::blackTexture());
+      } else {
+        material.SetTexture(*maybeID, texture);
+      }
+    };
+
+    for (const std::string& key : composite.appliedKeys) {
+      setTexture(key, UnityEngine::Texture(nullptr));
+    }
+
+    for (size_t i = 0; i < groups.size(); ++i) {
+      const CesiumRasterOverlayCompositeGroup& group = groups[i];
+
+      auto texCoordIndexIt = primitiveInfo.rasterOverlayUvIndexMap.find(
+          group.overlayTextureCoordinateID);
+      if (texCoordIndexIt == primitiveInfo.rasterOverlayUvIndexMap.end()) {
+        continue;
+      }
+
+      auto maybeID =
+          this->_materialProperties.getOverlayTextureCoordinateIndexID(
+              group.key);
+      if (maybeID) {
+        float texCoordIndex = static_cast<float>(texCoordIndexIt->second);
+        if (isShared) {
+          block.SetFloat(*maybeID, texCoordIndex);
+        } else {
+          material.SetFloat(*maybeID, texCoordIndex);
+        }
+      }
+
+      setTexture(group.key, composite.textures[i]);
+
+      maybeID =
+          this->_materialProperties.getOverlayTranslationAndScaleID(group.key);
+      if (maybeID) {
+        const UnityEngine::Vector4 translationAndScale{
+            float(group.translation.x),
+            float(group.translation.y),
+            float(group.scale.x),
+            float(group.scale.y)};
+        if (isShared) {
+          block.SetVector(*maybeID, translationAndScale);
+        } else {
+          material.SetVector(*maybeID, translationAndScale);
+        }
+      }
+
+      // The other overlays in the group are part of the composite.
+      for (const std::string& key : group.otherKeys) {
+        setTexture(key, UnityEngine::Texture(nullptr));
+      }
+    }
+
+    if (isShared) {
+      primitiveRenderer.meshRenderer.SetPropertyBlock(block);
+    }
+  }
+
+  composite.appliedKeys.clear();
+  for (const CesiumRasterOverlayCompositeGroup& group : groups) {
+    composite.appliedKeys.emplace_back(group.key);
+  }
+}
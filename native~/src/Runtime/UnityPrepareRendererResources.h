@@ -1,14 +1,31 @@
 #pragma once
 
+#include "CesiumPrimitiveInfo.h"
+#include "RasterOverlayAtlas.h"
+#include "RasterOverlayCompositor.h"
+#include "SharedMaterialCache.h"
+#include "TerrainHeightCache.h"
 #include "TilesetMaterialProperties.h"
 
 #include <Cesium3DTilesSelection/IPrepareRendererResources.h>
 
 #include <DotNet/CesiumForUnity/Cesium3DTileset.h>
 #include <DotNet/UnityEngine/GameObject.h>
+#include <DotNet/UnityEngine/Material.h>
+#include <DotNet/UnityEngine/MaterialPropertyBlock.h>
+#include <DotNet/UnityEngine/MeshRenderer.h>
+#include <DotNet/UnityEngine/Texture.h>
+#include <glm/vec2.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace CesiumForUnityNative {
 
+class RenderResourceCache;
+
 struct CreateModelOptions {
   /**
    * Whether to ignore the KHR_materials_unlit extension in the model. If this
@@ -17,47 +34,187 @@ struct CreateModelOptions {
    */
   bool ignoreKhrMaterialUnlit = false;
 
+  /**
+   * Whether cesium-native generates smooth normals, rather than flat ones,
+   * for models that lack them.
+   */
+  bool generateSmoothNormals = false;
+
+  /**
+   * Whether physics meshes are baked for the model's meshes.
+   */
+  bool createPhysicsMeshes = false;
+
   CreateModelOptions() = default;
   explicit CreateModelOptions(
       const DotNet::CesiumForUnity::Cesium3DTileset& tilesetComponent)
-      : ignoreKhrMaterialUnlit(tilesetComponent.ignoreKhrMaterialsUnlit()) {}
+      : ignoreKhrMaterialUnlit(tilesetComponent.ignoreKhrMaterialsUnlit()),
+        generateSmoothNormals(tilesetComponent.generateSmoothNormals()),
+        createPhysicsMeshes(tilesetComponent.createPhysicsMeshes()) {}
+};
+
+/**
+ * @brief The main-thread renderer resources of a raster overlay tile.
+ */
+struct CesiumRasterOverlayTexture {
+  /**
+   * @brief The overlay texture, or null if it is stored in an atlas slice.
+   */
+  ::DotNet::UnityEngine::Texture texture{nullptr};
+
+  /**
+   * @brief The atlas slice holding the overlay texture, if
+   * DotNet::CesiumForUnity::Cesium3DTileset::useRasterOverlayAtlas() is set.
+   */
+  std::optional<RasterOverlayAtlas::Slice> atlasSlice{};
+
+  /**
+   * @brief The overlay tile's image, if
+   * DotNet::CesiumForUnity::Cesium3DTileset::compositeRasterOverlays() is set.
+   * No texture is created for the overlay tile in that case.
+   */
+  CesiumUtility::IntrusivePointer<CesiumImage::ImageAsset> pImage{};
+
+  /**
+   * @brief The size of the texture or atlas slice, in bytes, as counted by
+   * UnityPrepareRendererResources::getRenderResourceBytes().
+   */
+  int64_t textureBytes = 0;
 };
+
 /**
- * @brief Information about how a given glTF primitive was converted into
- * Unity MeshData.
+ * @brief The renderer of a primitive game object, kept so that raster overlays
+ * can be applied without walking the game object hierarchy.
  */
-struct CesiumPrimitiveInfo {
+struct CesiumPrimitiveRenderer {
+  ::DotNet::UnityEngine::MeshRenderer meshRenderer;
+
+  /**
+   * @brief The renderer's material, as of when the tile's game object was
+   * created and broadcast to `Cesium3DTileset.OnTileGameObjectCreated`.
+   */
+  ::DotNet::UnityEngine::Material material;
+
+  /**
+   * @brief The index of the primitive in
+   * {@link CesiumGltfGameObject::primitiveInfos}.
+   */
+  size_t primitiveInfoIndex;
+};
+
+/**
+ * @brief A raster overlay attached to a tile.
+ */
+struct CesiumAttachedRasterOverlay {
+  std::string key;
+  int32_t overlayTextureCoordinateID;
+  const CesiumRasterOverlayTexture* pTexture;
+  glm::dvec2 translation;
+  glm::dvec2 scale;
+};
+
+/**
+ * @brief The overlays of a tile that share a set of overlay texture
+ * coordinates, flattened into a single image.
+ */
+struct CesiumRasterOverlayCompositeGroup {
+  int32_t overlayTextureCoordinateID;
+
+  /**
+   * @brief The material key of the first overlay in the group, whose
+   * material properties receive the composite.
+   */
+  std::string key;
+
+  /**
+   * @brief The material keys of the other overlays in the group, whose
+   * textures are cleared.
+   */
+  std::vector<std::string> otherKeys;
+
+  std::vector<RasterOverlayCompositeLayer> layers;
+
+  /**
+   * @brief The composite image, or nullptr if it could not be created.
+   */
+  CesiumUtility::IntrusivePointer<CesiumImage::ImageAsset> pImage;
+
+  /**
+   * @brief The translation and scale of the image within the overlay texture
+   * coordinates. A composite covers them exactly, but an overlay image bound
+   * on its own, when compositing fails, may not.
+   */
+  glm::dvec2 translation{0.0, 0.0};
+  glm::dvec2 scale{1.0, 1.0};
+};
+
+/**
+ * @brief The state of a tile's raster overlays when
+ * DotNet::CesiumForUnity::Cesium3DTileset::compositeRasterOverlays() is set.
+ *
+ * This is only accessed from the main thread. Worker threads composite a copy
+ * of the inputs.
+ */
+struct CesiumRasterOverlayComposite {
+  /**
+   * @brief The overlays currently attached to the tile.
+   */
+  std::vector<CesiumAttachedRasterOverlay> overlays{};
+
+  /**
+   * @brief Incremented whenever an overlay is attached or detached.
+   */
+  uint64_t version = 0;
+
+  /**
+   * @brief The version of the inputs that the applied textures were created
+   * from.
+   */
+  uint64_t appliedVersion = 0;
+
+  /**
+   * @brief Whether a composite is being created on a worker thread.
+   */
+  bool inFlight = false;
+
+  /**
+   * @brief Whether the tile is in the list of tiles with composite work.
+   */
+  bool queued = false;
+
+  /**
+   * @brief The version of the inputs of the most recently completed composite
+   * that is waiting to be applied, if any.
+   */
+  std::optional<uint64_t> completedVersion{};
+
   /**
-   * @brief The mode of the glTF primitive.
+   * @brief The most recently completed composite, waiting to be applied.
    */
-  int32_t mode = CesiumGltf::MeshPrimitive::Mode::TRIANGLES;
+  std::vector<CesiumRasterOverlayCompositeGroup> completedGroups{};
 
   /**
-   * @brief Whether or not the primitive contains translucent vertex
-   * colors. This can affect material tags used to render the model.
+   * @brief The version of the inputs that could not be composited, if the
+   * most recent attempt failed. Compositing is not tried again until the
+   * inputs change.
    */
-  bool isTranslucent = false;
+  std::optional<uint64_t> failedVersion{};
 
   /**
-   * @brief Whether or not the primitive material has the KHR_materials_unlit
-   * extension.
-   * @remarks This may be overridden if
-   * DotNet::CesiumForUnity::Cesium3DTileset::ignoreignoreKHRMaterialsUnlit() is
-   * set.
+   * @brief The composite textures currently applied to the tile.
    */
-  bool isUnlit = false;
+  std::vector<::DotNet::UnityEngine::Texture> textures{};
 
   /**
-   * @brief Maps a texture coordinate index i (TEXCOORD_<i>) to the
-   * corresponding Unity texture coordinate index.
+   * @brief The total size of {@link textures}, in bytes, as counted by
+   * UnityPrepareRendererResources::getRenderResourceBytes().
    */
-  std::unordered_map<uint32_t, uint32_t> uvIndexMap{};
+  int64_t textureBytes = 0;
 
   /**
-   * @brief Maps an overlay texture coordinate index i (_CESIUMOVERLAY_<i>) to
-   * the corresponding Unity texture coordinate index.
+   * @brief The material keys that were last set on the tile's renderers.
    */
-  std::unordered_map<uint32_t, uint32_t> rasterOverlayUvIndexMap{};
+  std::vector<std::string> appliedKeys{};
 };
 
 /**
@@ -74,6 +231,70 @@ struct CesiumGltfGameObject {
    * meshes.
    */
   std::vector<CesiumPrimitiveInfo> primitiveInfos{};
+
+  /**
+   * @brief The renderers of the primitives that were created as game objects.
+   * Primitives that were skipped, such as those without positions, have no
+   * entry.
+   */
+  std::vector<CesiumPrimitiveRenderer> primitiveRenderers{};
+
+  /**
+   * @brief Raster overlays attached since overlays were last applied. These
+   * are applied together, so that each renderer's property block is only
+   * read and written once.
+   */
+  std::vector<CesiumAttachedRasterOverlay> pendingRasterOverlays{};
+
+  /**
+   * @brief The composited overlays of this tile, if overlay compositing is
+   * enabled and an overlay has been attached.
+   */
+  std::shared_ptr<CesiumRasterOverlayComposite> pOverlayComposite{};
+
+  /**
+   * @brief Whether the game object was last made active by the tileset. The
+   * game object is created inactive, and is only shown or hidden when this
+   * differs from the tile's selection state.
+   */
+  bool isActive = false;
+
+  /**
+   * @brief The ID of the game object from
+   * `CesiumForUnity.Helpers.GetObjectId`, used to show and hide game objects
+   * in bulk.
+   */
+  uint64_t gameObjectID = 0;
+
+  /**
+   * @brief The ID under which this tile's lifecycle is being traced by
+   * `TileLifecycleTracer`, or zero if it is not being traced.
+   */
+  uint64_t traceID = 0;
+
+  /**
+   * @brief Whether the game object has ever been made active.
+   */
+  bool hasBeenShown = false;
+
+  /**
+   * @brief Whether the tile was loaded for a predicted camera view and has not
+   * been shown since. If it is freed in this state, the load was wasted.
+   */
+  bool isPredicted = false;
+
+  /**
+   * @brief The size of the tile's glTF data when it was loaded for a
+   * predicted camera view.
+   */
+  int64_t predictedBytes = 0;
+
+  /**
+   * @brief The size of the Unity meshes, mesh colliders, and textures created
+   * for this tile alone, in bytes. Textures of shared materials are counted by
+   * the tileset instead, because they outlive the tiles that created them.
+   */
+  int64_t renderResourceBytes = 0;
 };
 
 class UnityPrepareRendererResources
@@ -130,9 +351,89 @@ public:
     return this->_materialProperties;
   }
 
+  /**
+   * @brief Determines whether the tileset's materials can sample raster
+   * overlays from the atlas, given the material keys of its overlays. If the
+   * atlas was requested but a material lacks its properties, overlays are
+   * applied as separate textures instead, with a warning.
+   *
+   * Must be called after the overlay parameter IDs of the material properties
+   * have been updated for the same keys.
+   */
+  void updateOverlayAtlasSupport(
+      const std::vector<std::string>& overlayMaterialKeys);
+
+  /**
+   * @brief Applies the raster overlays that have been attached to tiles since
+   * this was last called, and starts or applies the composites of tiles whose
+   * overlays have changed. Must be called from the main thread after the
+   * tileset has been updated.
+   */
+  void applyPendingRasterOverlays();
+
+  /**
+   * @brief Gets the number of tiles that were loaded for a predicted camera
+   * view and freed without ever being shown.
+   */
+  int64_t getWastedPredictedTiles() const noexcept {
+    return this->_wastedPredictedTiles;
+  }
+
+  /**
+   * @brief Gets the total size of the glTF data of the tiles counted by
+   * {@link getWastedPredictedTiles}.
+   */
+  int64_t getWastedPredictedBytes() const noexcept {
+    return this->_wastedPredictedBytes;
+  }
+
+  /**
+   * @brief Gets the total size of the Unity meshes, mesh colliders, and
+   * textures created for the tileset's loaded tiles and raster overlay tiles,
+   * in bytes.
+   *
+   * cesium-native only counts a tile's glTF data toward the tileset's cache
+   * limit, so this is counted separately. Raster overlay textures are counted
+   * from when they are created until they are freed, including the atlas
+   * slices and composites that stand in for them. Released textures kept in
+   * DotNet::CesiumForUnity::CesiumRasterOverlayTexturePool are limited by the
+   * pool's own size instead.
+   */
+  int64_t getRenderResourceBytes() const noexcept {
+    return this->_renderResourceBytes +
+           this->_sharedMaterials.getTotalTextureBytes();
+  }
+
+  /**
+   * @brief Gets the cache of heights extracted from the tileset's loaded
+   * tiles.
+   */
+  TerrainHeightCache& getTerrainHeightCache() noexcept {
+    return this->_terrainHeightCache;
+  }
+
 private:
+  void applyPendingRasterOverlays(CesiumGltfGameObject& gltfGameObject);
+  bool updateOverlayComposite(CesiumGltfGameObject& gltfGameObject);
+  void applyOverlayComposite(
+      CesiumGltfGameObject& gltfGameObject,
+      const std::vector<CesiumRasterOverlayCompositeGroup>& groups);
+
   ::DotNet::UnityEngine::GameObject _tilesetGameObject;
   TilesetMaterialProperties _materialProperties;
+  std::shared_ptr<RenderResourceCache> _pRenderResourceCache;
+  SharedMaterialCache _sharedMaterials;
+  ::DotNet::UnityEngine::MaterialPropertyBlock _overlayPropertyBlock;
+  bool _overlayAtlasRequested;
+  bool _useOverlayAtlas;
+  RasterOverlayAtlas _overlayAtlas;
+  std::vector<CesiumGltfGameObject*> _gameObjectsWithPendingOverlays;
+  bool _compositeOverlays;
+  std::vector<CesiumGltfGameObject*> _gameObjectsWithCompositeWork;
+  int64_t _wastedPredictedTiles;
+  int64_t _wastedPredictedBytes;
+  int64_t _renderResourceBytes;
+  TerrainHeightCache _terrainHeightCache;
 };
 
 } // namespace CesiumForUnityNative
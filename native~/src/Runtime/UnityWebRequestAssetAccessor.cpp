@@ -1,6 +1,7 @@
 #include "UnityWebRequestAssetAccessor.h"
 
 #include "Cesium.h"
+#include "TileLifecycleTracer.h"
 
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/IAssetResponse.h>
@@ -71,6 +72,9 @@ UnityAssetRequest::UnityAssetRequest(
       _completedCallback(nullptr) {}
 
 void UnityAssetRequest::start() {
+  uint64_t traceID = TileLifecycleTracer::getTraceID(this->_url);
+  TileLifecycleTracer::endAndBegin(traceID, "Request queued", "HTTP request");
+
   DotNet::CesiumForUnity::NativeDownloadHandler handler{};
   this->_webRequest.downloadHandler(handler);
 
@@ -78,8 +82,10 @@ void UnityAssetRequest::start() {
       this->_webRequest.SendWebRequest();
 
   this->_completedCallback = System::Action1<UnityEngine::AsyncOperation>(
-      [handler = std::move(handler), thiz = this->shared_from_this(), op](
-          const UnityEngine::AsyncOperation& operation) mutable {
+      [handler = std::move(handler),
+       thiz = this->shared_from_this(),
+       op,
+       traceID](const UnityEngine::AsyncOperation& operation) mutable {
         ScopeGuard disposeHandler{[&handler]() { handler.Dispose(); }};
 
         State expected = State::Pending;
@@ -90,8 +96,10 @@ void UnityAssetRequest::start() {
             thiz->_maybeResponse = std::make_optional<UnityAssetResponse>(
                 thiz->_webRequest,
                 handler);
+            TileLifecycleTracer::handoff(traceID, "HTTP request");
             thiz->_promise.resolve(thiz);
           } else {
+            TileLifecycleTracer::end(traceID, "HTTP request");
             thiz->_promise.reject(std::runtime_error(fmt::format(
                 "Request for `{}` failed: {}",
                 thiz->_webRequest.url().ToStlString(),
@@ -206,6 +214,11 @@ UnityWebRequestAssetAccessor::get(
     const std::vector<THeader>& headers) {
   std::shared_ptr<UnityWebRequestAssetAccessor> thiz = this->shared_from_this();
 
+  TileLifecycleTracer::begin(
+      TileLifecycleTracer::getTraceID(url),
+      "Request queued",
+      url);
+
   // Sadly, Unity requires us to call this from the main thread.
   return asyncSystem.runInMainThread([asyncSystem, url, headers, thiz]() {
     UnityEngine::Networking::UnityWebRequest request =
@@ -245,6 +258,9 @@ UnityWebRequestAssetAccessor::get(
     }
 
     if (failRequest) {
+      TileLifecycleTracer::end(
+          TileLifecycleTracer::getTraceID(url),
+          "Request queued");
       pAssetRequest->cancel();
     } else {
       pAssetRequest->start();
@@ -281,6 +297,11 @@ UnityWebRequestAssetAccessor::request(
 
   std::shared_ptr<UnityWebRequestAssetAccessor> thiz = this->shared_from_this();
 
+  TileLifecycleTracer::begin(
+      TileLifecycleTracer::getTraceID(url),
+      "Request queued",
+      url);
+
   // Sadly, Unity requires us to call this from the main thread.
   return asyncSystem.runInMainThread(
       [asyncSystem, url, verb, headers, payloadBytes, thiz]() {
@@ -329,6 +350,9 @@ UnityWebRequestAssetAccessor::request(
         }
 
         if (failRequest) {
+          TileLifecycleTracer::end(
+              TileLifecycleTracer::getTraceID(url),
+              "Request queued");
           pAssetRequest->cancel();
         } else {
           pAssetRequest->start();
@@ -0,0 +1,138 @@
+#include "CameraPathRecording.h"
+
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+
+#include <doctest/doctest.h>
+#include <glm/geometric.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumForUnityNative;
+using namespace CesiumGeospatial;
+
+namespace {
+
+// A camera above a position, looking north and tilted down, with
+// coordinates that don't round to short decimals.
+ViewState createView(
+    double longitude,
+    double latitude,
+    double verticalFieldOfView,
+    const glm::dvec2& viewportSize) {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  const glm::dvec3 position = ellipsoid.cartographicToCartesian(
+      Cartographic::fromDegrees(longitude, latitude, 1234.567));
+  const glm::dvec3 surfaceNormal = ellipsoid.geodeticSurfaceNormal(position);
+  const glm::dvec3 east =
+      glm::normalize(glm::cross(glm::dvec3(0.0, 0.0, 1.0), surfaceNormal));
+  const glm::dvec3 north = glm::cross(surfaceNormal, east);
+  const glm::dvec3 direction = glm::normalize(north - 0.3 * surfaceNormal);
+  const glm::dvec3 up = glm::cross(east, direction);
+  const double aspectRatio = viewportSize.x / viewportSize.y;
+  const double horizontalFieldOfView =
+      2.0 * std::atan(std::tan(verticalFieldOfView * 0.5) * aspectRatio);
+  return ViewState(
+      position,
+      direction,
+      up,
+      viewportSize,
+      horizontalFieldOfView,
+      verticalFieldOfView,
+      ellipsoid);
+}
+
+void checkView(const ViewState& actual, const ViewState& expected) {
+  for (glm::length_t i = 0; i < 3; ++i) {
+    CHECK(actual.getPosition()[i] == expected.getPosition()[i]);
+    CHECK(actual.getDirection()[i] == expected.getDirection()[i]);
+    CHECK(actual.getUp()[i] == expected.getUp()[i]);
+  }
+  CHECK(actual.getViewportSize() == expected.getViewportSize());
+
+  // Fields of view are written in degrees, so they may not read back exactly.
+  CHECK(
+      actual.getHorizontalFieldOfView() ==
+      doctest::Approx(expected.getHorizontalFieldOfView()).epsilon(1e-12));
+  CHECK(
+      actual.getVerticalFieldOfView() ==
+      doctest::Approx(expected.getVerticalFieldOfView()).epsilon(1e-12));
+}
+
+} // namespace
+
+TEST_CASE("CameraPathRecording") {
+  const std::string path =
+      (std::filesystem::temp_directory_path() /
+       "CesiumForUnityTestCameraPath.csv")
+          .string();
+
+  // The second update has two cameras.
+  const std::vector<std::vector<ViewState>> frames{
+      {createView(-105.123456789, 39.987654321, 1.0, {1920.0, 1080.0})},
+      {createView(-105.2, 40.1, 0.8, {1280.0, 720.0}),
+       createView(10.0, -20.0, 1.2, {640.0, 480.0})},
+      {createView(-105.3, 40.2, 0.9, {1919.0, 1081.0})}};
+
+  {
+    std::unique_ptr<CameraPathRecorder> pRecorder =
+        CameraPathRecorder::create(path);
+    REQUIRE(pRecorder);
+    for (size_t i = 0; i < frames.size(); ++i) {
+      pRecorder->record(
+          int32_t(100 + i),
+          12.5 + double(i) / 60.0,
+          frames[i],
+          CameraPathFrameStats{int32_t(i), 1, 2, 3, 4096, 1.5});
+    }
+  }
+
+  SUBCASE("replays each recorded update in order") {
+    std::unique_ptr<CameraPathPlayer> pPlayer =
+        CameraPathPlayer::load(path, false);
+    REQUIRE(pPlayer);
+
+    for (const std::vector<ViewState>& expected : frames) {
+      const std::vector<ViewState> actual = pPlayer->next(Ellipsoid::WGS84);
+      REQUIRE(actual.size() == expected.size());
+      for (size_t i = 0; i < actual.size(); ++i) {
+        checkView(actual[i], expected[i]);
+      }
+    }
+
+    // The last update is held once the recording ends.
+    const std::vector<ViewState> held = pPlayer->next(Ellipsoid::WGS84);
+    REQUIRE(held.size() == 1);
+    checkView(held[0], frames.back()[0]);
+  }
+
+  SUBCASE("starts over when looping") {
+    std::unique_ptr<CameraPathPlayer> pPlayer =
+        CameraPathPlayer::load(path, true);
+    REQUIRE(pPlayer);
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+      pPlayer->next(Ellipsoid::WGS84);
+    }
+
+    const std::vector<ViewState> first = pPlayer->next(Ellipsoid::WGS84);
+    REQUIRE(first.size() == 1);
+    checkView(first[0], frames.front()[0]);
+  }
+
+  SUBCASE("does not load a recording without views") {
+    CameraPathRecorder::create(path).reset();
+    CHECK(!CameraPathPlayer::load(path, false));
+  }
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,182 @@
+#include "RasterOverlayCompositor.h"
+
+#include <CesiumImage/ImageAsset.h>
+
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+using namespace CesiumForUnityNative;
+using namespace CesiumImage;
+using namespace CesiumUtility;
+
+namespace {
+
+IntrusivePointer<ImageAsset> createImage(
+    int32_t width,
+    int32_t height,
+    int32_t channels,
+    const std::vector<uint8_t>& pixels) {
+  IntrusivePointer<ImageAsset> pImage;
+  pImage.emplace();
+  pImage->width = width;
+  pImage->height = height;
+  pImage->channels = channels;
+  pImage->bytesPerChannel = 1;
+  for (uint8_t value : pixels) {
+    pImage->pixelData.emplace_back(std::byte(value));
+  }
+  return pImage;
+}
+
+IntrusivePointer<ImageAsset> createSolidImage(
+    int32_t width,
+    int32_t height,
+    uint8_t r,
+    uint8_t g,
+    uint8_t b,
+    uint8_t a) {
+  std::vector<uint8_t> pixels;
+  for (int32_t i = 0; i < width * height; ++i) {
+    pixels.insert(pixels.end(), {r, g, b, a});
+  }
+  return createImage(width, height, 4, pixels);
+}
+
+RasterOverlayCompositeLayer
+createLayer(const IntrusivePointer<ImageAsset>& pImage) {
+  return RasterOverlayCompositeLayer{
+      pImage,
+      glm::dvec2(0.0, 0.0),
+      glm::dvec2(1.0, 1.0)};
+}
+
+// Checks a pixel of the composite's first mip, allowing for rounding.
+void checkPixel(
+    const ImageAsset& image,
+    int32_t x,
+    int32_t y,
+    const std::vector<int32_t>& expected) {
+  const std::byte* pPixel =
+      image.pixelData.data() + (size_t(y) * image.width + size_t(x)) * 4;
+  for (size_t i = 0; i < 4; ++i) {
+    CHECK(std::abs(int32_t(pPixel[i]) - expected[i]) <= 1);
+  }
+}
+
+} // namespace
+
+TEST_CASE("RasterOverlayCompositor") {
+  SUBCASE("returns nothing when no layer can be composited") {
+    CHECK(RasterOverlayCompositor::composite({}) == nullptr);
+
+    IntrusivePointer<ImageAsset> pCompressed =
+        createSolidImage(2, 2, 0, 0, 0, 255);
+    pCompressed->compressedPixelFormat = GpuCompressedPixelFormat::ETC2_RGBA;
+    IntrusivePointer<ImageAsset> pTwoChannel =
+        createImage(1, 1, 2, {255, 255});
+    CHECK(
+        RasterOverlayCompositor::composite(
+            {createLayer(pCompressed), createLayer(pTwoChannel)}) == nullptr);
+  }
+
+  SUBCASE("copies a single layer that covers the tile exactly") {
+    IntrusivePointer<ImageAsset> pImage = createImage(
+        2,
+        2,
+        4,
+        {255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255, 10, 20, 30, 255});
+    IntrusivePointer<ImageAsset> pResult =
+        RasterOverlayCompositor::composite({createLayer(pImage)});
+    REQUIRE(pResult != nullptr);
+    CHECK(pResult->width == 2);
+    CHECK(pResult->height == 2);
+    CHECK(pResult->channels == 4);
+    checkPixel(*pResult, 0, 0, {255, 0, 0, 255});
+    checkPixel(*pResult, 1, 0, {0, 255, 0, 255});
+    checkPixel(*pResult, 0, 1, {0, 0, 255, 255});
+    checkPixel(*pResult, 1, 1, {10, 20, 30, 255});
+  }
+
+  SUBCASE("treats images without alpha as opaque") {
+    IntrusivePointer<ImageAsset> pImage = createImage(1, 1, 3, {10, 20, 30});
+    IntrusivePointer<ImageAsset> pResult =
+        RasterOverlayCompositor::composite({createLayer(pImage)});
+    REQUIRE(pResult != nullptr);
+    checkPixel(*pResult, 0, 0, {10, 20, 30, 255});
+  }
+
+  SUBCASE("blends each layer over the previous ones") {
+    IntrusivePointer<ImageAsset> pRed = createSolidImage(1, 1, 255, 0, 0, 255);
+    IntrusivePointer<ImageAsset> pBlue = createSolidImage(1, 1, 0, 0, 255, 51);
+    IntrusivePointer<ImageAsset> pResult = RasterOverlayCompositor::composite(
+        {createLayer(pRed), createLayer(pBlue)});
+    REQUIRE(pResult != nullptr);
+    checkPixel(*pResult, 0, 0, {204, 0, 51, 255});
+
+    // Applying the composite with a lerp by its alpha must match applying
+    // each layer in turn, so translucent layers keep straight colors.
+    IntrusivePointer<ImageAsset> pTranslucentRed =
+        createSolidImage(1, 1, 255, 0, 0, 51);
+    pResult = RasterOverlayCompositor::composite(
+        {createLayer(pTranslucentRed), createLayer(pBlue)});
+    REQUIRE(pResult != nullptr);
+    // Alpha is 0.2 + 0.2 * 0.8 = 0.36, and the color is red weighted by
+    // 0.2 * 0.8 and blue by 0.2.
+    checkPixel(*pResult, 0, 0, {113, 0, 142, 92});
+
+    IntrusivePointer<ImageAsset> pTransparent =
+        createSolidImage(1, 1, 255, 255, 255, 0);
+    pResult = RasterOverlayCompositor::composite(
+        {createLayer(pTransparent), createLayer(pTransparent)});
+    REQUIRE(pResult != nullptr);
+    checkPixel(*pResult, 0, 0, {0, 0, 0, 0});
+  }
+
+  SUBCASE("maps layers with their translation and scale") {
+    // The right half of the layer covers the whole tile.
+    IntrusivePointer<ImageAsset> pImage =
+        createImage(2, 1, 4, {0, 0, 0, 255, 255, 255, 255, 255});
+    RasterOverlayCompositeLayer layer{
+        pImage,
+        glm::dvec2(0.5, 0.0),
+        glm::dvec2(0.5, 1.0)};
+    IntrusivePointer<ImageAsset> pResult =
+        RasterOverlayCompositor::composite({layer});
+    REQUIRE(pResult != nullptr);
+    CHECK(pResult->width == 1);
+    CHECK(pResult->height == 1);
+    checkPixel(*pResult, 0, 0, {255, 255, 255, 255});
+  }
+
+  SUBCASE("is sized by the most detailed layer") {
+    RasterOverlayCompositeLayer coarse{
+        createSolidImage(4, 4, 0, 0, 0, 255),
+        glm::dvec2(0.0, 0.0),
+        glm::dvec2(0.5, 0.5)};
+    RasterOverlayCompositeLayer detailed{
+        createSolidImage(8, 6, 0, 0, 0, 255),
+        glm::dvec2(0.0, 0.0),
+        glm::dvec2(1.0, 1.0)};
+    IntrusivePointer<ImageAsset> pResult =
+        RasterOverlayCompositor::composite({coarse, detailed});
+    REQUIRE(pResult != nullptr);
+    CHECK(pResult->width == 8);
+    CHECK(pResult->height == 6);
+    CHECK(pResult->mipPositions.size() > 1);
+
+    RasterOverlayCompositeLayer wide = createLayer(createSolidImage(
+        RasterOverlayCompositor::maximumSize * 2,
+        1,
+        0,
+        0,
+        0,
+        255));
+    pResult = RasterOverlayCompositor::composite({wide});
+    REQUIRE(pResult != nullptr);
+    CHECK(pResult->width == RasterOverlayCompositor::maximumSize);
+    CHECK(pResult->height == 1);
+  }
+}
@@ -0,0 +1,167 @@
+#include "RenderResourceCache.h"
+
+#include <doctest/doctest.h>
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+using namespace CesiumForUnityNative;
+
+namespace {
+
+// UnityEngine.Rendering.VertexAttribute and VertexAttributeFormat values.
+constexpr int32_t positionAttribute = 0;
+constexpr int32_t normalAttribute = 1;
+constexpr int32_t float32Format = 0;
+
+// A triangle with positions and normals, and 16-bit indices.
+ProcessedPrimitive createTriangle() {
+  ProcessedPrimitive primitive;
+  primitive.primitiveInfo.mode = 4;
+  primitive.primitiveInfo.isTranslucent = true;
+  primitive.primitiveInfo.uvIndexMap = {{0, 1}};
+  primitive.primitiveInfo.rasterOverlayUvIndexMap = {{0, 2}, {1, 3}};
+  primitive.hasMesh = true;
+  primitive.attributes = {
+      ProcessedVertexAttribute{positionAttribute, float32Format, 3, 0},
+      ProcessedVertexAttribute{normalAttribute, float32Format, 3, 0}};
+  primitive.vertexCount = 3;
+  primitive.indexFormat = 0;
+  primitive.indexCount = 3;
+  primitive.topology = 0;
+  primitive.minimumPosition = glm::vec3(0.0f, 0.0f, 0.0f);
+  primitive.maximumPosition = glm::vec3(1.0f, 1.0f, 0.0f);
+
+  const std::vector<float> vertices{
+      0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, //
+      1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, //
+      0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+  const std::vector<uint16_t> indices{0, 1, 2};
+  primitive.vertexData.resize(vertices.size() * sizeof(float));
+  std::memcpy(
+      primitive.vertexData.data(),
+      vertices.data(),
+      primitive.vertexData.size());
+  primitive.indexData.resize(indices.size() * sizeof(uint16_t));
+  std::memcpy(
+      primitive.indexData.data(),
+      indices.data(),
+      primitive.indexData.size());
+  return primitive;
+}
+
+bool deserialize(
+    const std::vector<ProcessedPrimitive>& primitives,
+    std::vector<ProcessedPrimitive>& result) {
+  return RenderResourceCache::deserializePrimitives(
+      RenderResourceCache::serializePrimitives(primitives),
+      result);
+}
+
+} // namespace
+
+TEST_CASE("RenderResourceCache primitives") {
+  ProcessedPrimitive skipped;
+  skipped.primitiveInfo.mode = 0;
+  skipped.primitiveInfo.isUnlit = true;
+
+  const std::vector<ProcessedPrimitive> primitives{skipped, createTriangle()};
+  std::vector<ProcessedPrimitive> result;
+
+  SUBCASE("round trip through serialization") {
+    REQUIRE(deserialize(primitives, result));
+    REQUIRE(result.size() == 2);
+
+    CHECK(result[0].primitiveInfo.mode == 0);
+    CHECK(result[0].primitiveInfo.isUnlit);
+    CHECK(!result[0].hasMesh);
+
+    const ProcessedPrimitive& expected = primitives[1];
+    const ProcessedPrimitive& actual = result[1];
+    CHECK(actual.primitiveInfo.mode == expected.primitiveInfo.mode);
+    CHECK(actual.primitiveInfo.isTranslucent);
+    CHECK(!actual.primitiveInfo.isUnlit);
+    CHECK(actual.primitiveInfo.uvIndexMap == expected.primitiveInfo.uvIndexMap);
+    CHECK(
+        actual.primitiveInfo.rasterOverlayUvIndexMap ==
+        expected.primitiveInfo.rasterOverlayUvIndexMap);
+    CHECK(actual.hasMesh);
+    REQUIRE(actual.attributes.size() == 2);
+    CHECK(actual.attributes[1].attribute == normalAttribute);
+    CHECK(actual.attributes[1].dimension == 3);
+    CHECK(actual.vertexCount == 3);
+    CHECK(actual.indexFormat == 0);
+    CHECK(actual.indexCount == 3);
+    CHECK(actual.topology == 0);
+    CHECK(actual.minimumPosition == expected.minimumPosition);
+    CHECK(actual.maximumPosition == expected.maximumPosition);
+    CHECK(actual.vertexData == expected.vertexData);
+    CHECK(actual.indexData == expected.indexData);
+  }
+
+  SUBCASE("rejects truncated data") {
+    const std::vector<std::byte> data =
+        RenderResourceCache::serializePrimitives(primitives);
+    for (size_t size = 0; size < data.size(); ++size) {
+      CHECK(!RenderResourceCache::deserializePrimitives(
+          std::span<const std::byte>(data.data(), size),
+          result));
+    }
+    CHECK(result.empty());
+  }
+
+  SUBCASE("rejects trailing data") {
+    std::vector<std::byte> data =
+        RenderResourceCache::serializePrimitives(primitives);
+    data.emplace_back(std::byte(0));
+    CHECK(!RenderResourceCache::deserializePrimitives(data, result));
+  }
+
+  SUBCASE("rejects a primitive count larger than the data could hold") {
+    // The count follows the magic number and the version.
+    std::vector<std::byte> data =
+        RenderResourceCache::serializePrimitives(primitives);
+    const uint32_t hugeCount = 0xffffffff;
+    std::memcpy(
+        data.data() + 2 * sizeof(uint32_t),
+        &hugeCount,
+        sizeof(hugeCount));
+    CHECK(!RenderResourceCache::deserializePrimitives(data, result));
+  }
+
+  SUBCASE("rejects invalid vertex attributes") {
+    ProcessedPrimitive triangle = createTriangle();
+
+    SUBCASE("in a second stream") { triangle.attributes[1].stream = 1; }
+    SUBCASE("of an unknown kind") { triangle.attributes[1].attribute = 14; }
+    SUBCASE("repeated") {
+      triangle.attributes[1].attribute = positionAttribute;
+    }
+    SUBCASE("of an unknown format") { triangle.attributes[1].format = 12; }
+    SUBCASE("with no components") { triangle.attributes[1].dimension = 0; }
+    SUBCASE("with too many components") {
+      triangle.attributes[1].dimension = 5;
+    }
+    SUBCASE("more than Unity allows") {
+      triangle.attributes.resize(15, triangle.attributes[0]);
+    }
+
+    CHECK(!deserialize({triangle}, result));
+  }
+
+  SUBCASE("rejects buffers that don't match the counts") {
+    ProcessedPrimitive triangle = createTriangle();
+
+    SUBCASE("vertices") { triangle.vertexCount = 4; }
+    SUBCASE("indices") { triangle.indexCount = 4; }
+    SUBCASE("index format") { triangle.indexFormat = 1; }
+    SUBCASE("unknown index format") { triangle.indexFormat = 2; }
+    SUBCASE("unknown topology") { triangle.topology = 1; }
+
+    CHECK(!deserialize({triangle}, result));
+  }
+}
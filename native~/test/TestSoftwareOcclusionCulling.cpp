@@ -0,0 +1,224 @@
+#include "SoftwareOcclusionCulling.h"
+
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/Math.h>
+
+#include <doctest/doctest.h>
+#include <glm/mat3x3.hpp>
+#include <glm/vec3.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumForUnityNative;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace {
+
+constexpr int32_t bufferWidth = 256;
+
+// A camera at the origin looking along +X, with a square 90 degree field of
+// view, so that the buffer is 256 by 256 pixels and a point at (x, y, z) is
+// 128 * y / x pixels right of the center.
+ViewState createView(
+    const glm::dvec3& position = glm::dvec3(0.0),
+    const glm::dvec3& direction = glm::dvec3(1.0, 0.0, 0.0)) {
+  return ViewState(
+      position,
+      direction,
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(1024.0, 1024.0),
+      Math::PiOverTwo,
+      Math::PiOverTwo,
+      Ellipsoid::WGS84);
+}
+
+// A square facing the camera at the given distance along +X.
+Model createSquare(double distance, double halfSize) {
+  const float x = float(distance);
+  const float h = float(halfSize);
+  const std::vector<glm::vec3> positions{
+      glm::vec3(x, -h, -h),
+      glm::vec3(x, h, -h),
+      glm::vec3(x, h, h),
+      glm::vec3(x, -h, h)};
+  const std::vector<uint16_t> indices{0, 1, 2, 0, 2, 3};
+  const size_t positionBytes = positions.size() * sizeof(glm::vec3);
+  const size_t indexBytes = indices.size() * sizeof(uint16_t);
+
+  Model model;
+
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(positionBytes + indexBytes);
+  std::memcpy(buffer.cesium.data.data(), positions.data(), positionBytes);
+  std::memcpy(
+      buffer.cesium.data.data() + positionBytes,
+      indices.data(),
+      indexBytes);
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+  BufferView& positionView = model.bufferViews.emplace_back();
+  positionView.buffer = 0;
+  positionView.byteOffset = 0;
+  positionView.byteLength = int64_t(positionBytes);
+
+  BufferView& indexView = model.bufferViews.emplace_back();
+  indexView.buffer = 0;
+  indexView.byteOffset = int64_t(positionBytes);
+  indexView.byteLength = int64_t(indexBytes);
+
+  Accessor& positionAccessor = model.accessors.emplace_back();
+  positionAccessor.bufferView = 0;
+  positionAccessor.componentType = Accessor::ComponentType::FLOAT;
+  positionAccessor.type = Accessor::Type::VEC3;
+  positionAccessor.count = int64_t(positions.size());
+
+  Accessor& indexAccessor = model.accessors.emplace_back();
+  indexAccessor.bufferView = 1;
+  indexAccessor.componentType = Accessor::ComponentType::UNSIGNED_SHORT;
+  indexAccessor.type = Accessor::Type::SCALAR;
+  indexAccessor.count = int64_t(indices.size());
+
+  Mesh& mesh = model.meshes.emplace_back();
+  MeshPrimitive& primitive = mesh.primitives.emplace_back();
+  primitive.mode = MeshPrimitive::Mode::TRIANGLES;
+  primitive.attributes["POSITION"] = 0;
+  primitive.indices = 1;
+
+  model.nodes.emplace_back().mesh = 0;
+  model.scenes.emplace_back().nodes.emplace_back(0);
+  model.scene = 0;
+
+  return model;
+}
+
+OrientedBoundingBox
+createBox(const glm::dvec3& center, const glm::dvec3& halfSize) {
+  return OrientedBoundingBox(
+      center,
+      glm::dmat3(
+          glm::dvec3(halfSize.x, 0.0, 0.0),
+          glm::dvec3(0.0, halfSize.y, 0.0),
+          glm::dvec3(0.0, 0.0, halfSize.z)));
+}
+
+} // namespace
+
+TEST_CASE("OcclusionDepthBuffer") {
+  OcclusionDepthBuffer buffer;
+
+  SUBCASE("occludes nothing without occluders") {
+    buffer.reset(createView(), bufferWidth);
+    buffer.buildHierarchy();
+    CHECK(!buffer.hasOccluders());
+    CHECK(!buffer.isOccluded(
+        createBox(glm::dvec3(20.0, 0.0, 0.0), glm::dvec3(1.0)),
+        0.0));
+  }
+
+  SUBCASE("with a square in front of the camera") {
+    buffer.reset(createView(), bufferWidth);
+    CHECK(
+        buffer.rasterizeModel(createSquare(10.0, 5.0), glm::dmat4(1.0), 100) ==
+        2);
+    buffer.buildHierarchy();
+    CHECK(buffer.hasOccluders());
+
+    SUBCASE("occludes a box behind it") {
+      CHECK(buffer.isOccluded(
+          createBox(glm::dvec3(20.0, 0.0, 0.0), glm::dvec3(1.0)),
+          0.0));
+    }
+
+    SUBCASE("does not occlude a box in front of it") {
+      CHECK(!buffer.isOccluded(
+          createBox(glm::dvec3(5.0, 0.0, 0.0), glm::dvec3(1.0)),
+          0.0));
+    }
+
+    SUBCASE("does not occlude a box that the depth bias moves in front") {
+      CHECK(!buffer.isOccluded(
+          createBox(glm::dvec3(20.0, 0.0, 0.0), glm::dvec3(1.0)),
+          15.0));
+    }
+
+    SUBCASE("does not occlude a box beside it") {
+      CHECK(!buffer.isOccluded(
+          createBox(glm::dvec3(20.0, 15.0, 0.0), glm::dvec3(1.0)),
+          0.0));
+    }
+
+    SUBCASE("does not occlude a box crossing the near plane") {
+      CHECK(!buffer.isOccluded(
+          createBox(glm::dvec3(0.5, 0.0, 0.0), glm::dvec3(1.0)),
+          0.0));
+    }
+  }
+
+  SUBCASE("does not occlude a box peeking past an occluder by under a pixel") {
+    // The square's edges are 64.6 pixels from the center, so the pixels 64.5
+    // pixels out are written even though their outer parts are uncovered.
+    buffer.reset(createView(), bufferWidth);
+    buffer.rasterizeModel(
+        createSquare(10.0, 5.046875),
+        glm::dmat4(1.0),
+        100);
+    buffer.buildHierarchy();
+
+    // The near face of this box reaches 64.8 pixels from the center.
+    CHECK(!buffer.isOccluded(
+        createBox(glm::dvec3(20.0, 0.0, 0.0), glm::dvec3(1.0, 9.61875, 1.0)),
+        0.0));
+
+    // This one reaches 60.6 pixels from the center.
+    CHECK(buffer.isOccluded(
+        createBox(glm::dvec3(20.0, 0.0, 0.0), glm::dvec3(1.0, 9.0, 1.0)),
+        0.0));
+  }
+
+  SUBCASE("occludes nothing after it is cleared") {
+    buffer.reset(createView(), bufferWidth);
+    buffer.rasterizeModel(createSquare(10.0, 5.0), glm::dmat4(1.0), 100);
+    buffer.clear();
+    buffer.buildHierarchy();
+    CHECK(!buffer.hasOccluders());
+    CHECK(!buffer.isOccluded(
+        createBox(glm::dvec3(20.0, 0.0, 0.0), glm::dvec3(1.0)),
+        0.0));
+  }
+
+  SUBCASE("skips models over the triangle limit") {
+    buffer.reset(createView(), bufferWidth);
+    CHECK(
+        buffer.rasterizeModel(createSquare(10.0, 5.0), glm::dmat4(1.0), 1) ==
+        0);
+    CHECK(!buffer.hasOccluders());
+  }
+
+  SUBCASE("is only near views that have barely moved or turned") {
+    CHECK(!buffer.isNearView(createView()));
+
+    buffer.reset(createView(), bufferWidth);
+    CHECK(buffer.isNearView(createView()));
+    CHECK(buffer.isNearView(createView(glm::dvec3(0.0, 0.5, 0.0))));
+    CHECK(!buffer.isNearView(createView(glm::dvec3(0.0, 10.0, 0.0))));
+
+    const double smallTurn = Math::degreesToRadians(0.1);
+    const double largeTurn = Math::degreesToRadians(1.0);
+    CHECK(buffer.isNearView(createView(
+        glm::dvec3(0.0),
+        glm::dvec3(std::cos(smallTurn), std::sin(smallTurn), 0.0))));
+    CHECK(!buffer.isNearView(createView(
+        glm::dvec3(0.0),
+        glm::dvec3(std::cos(largeTurn), std::sin(largeTurn), 0.0))));
+  }
+}
@@ -0,0 +1,352 @@
+#include "TerrainHeightCache.h"
+
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumGltf/Model.h>
+
+#include <doctest/doctest.h>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <vector>
+
+using namespace CesiumForUnityNative;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+
+namespace {
+
+struct TestTile {
+  GlobeRectangle rectangle;
+  double geometricError;
+  Model model;
+  glm::dmat4 modelToEcef;
+};
+
+// A tile whose model is a regular mesh of vertices over its rectangle, with
+// the height of each given as a function of how far east and north across the
+// rectangle it is, from 0 to 1.
+TestTile createTile(
+    const GlobeRectangle& rectangle,
+    double geometricError,
+    int32_t verticesPerSide,
+    const std::function<double(double, double)>& getHeight) {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  const glm::dvec3 center =
+      ellipsoid.cartographicToCartesian(rectangle.computeCenter());
+
+  std::vector<glm::vec3> positions;
+  for (int32_t row = 0; row < verticesPerSide; ++row) {
+    for (int32_t column = 0; column < verticesPerSide; ++column) {
+      const double u = double(column) / double(verticesPerSide - 1);
+      const double v = double(row) / double(verticesPerSide - 1);
+      const Cartographic cartographic(
+          rectangle.getWest() + u * rectangle.computeWidth(),
+          rectangle.getSouth() + v * rectangle.computeHeight(),
+          getHeight(u, v));
+      positions.emplace_back(
+          ellipsoid.cartographicToCartesian(cartographic) - center);
+    }
+  }
+
+  std::vector<uint32_t> indices;
+  for (int32_t row = 0; row + 1 < verticesPerSide; ++row) {
+    for (int32_t column = 0; column + 1 < verticesPerSide; ++column) {
+      const uint32_t southWest = uint32_t(row * verticesPerSide + column);
+      const uint32_t southEast = southWest + 1;
+      const uint32_t northWest = southWest + uint32_t(verticesPerSide);
+      const uint32_t northEast = northWest + 1;
+      indices.insert(
+          indices.end(),
+          {southWest, southEast, northEast, southWest, northEast, northWest});
+    }
+  }
+
+  const size_t positionBytes = positions.size() * sizeof(glm::vec3);
+  const size_t indexBytes = indices.size() * sizeof(uint32_t);
+
+  TestTile tile{
+      rectangle,
+      geometricError,
+      Model(),
+      glm::translate(glm::dmat4(1.0), center)};
+  Model& model = tile.model;
+
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(positionBytes + indexBytes);
+  std::memcpy(buffer.cesium.data.data(), positions.data(), positionBytes);
+  std::memcpy(
+      buffer.cesium.data.data() + positionBytes,
+      indices.data(),
+      indexBytes);
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+  BufferView& positionView = model.bufferViews.emplace_back();
+  positionView.buffer = 0;
+  positionView.byteOffset = 0;
+  positionView.byteLength = int64_t(positionBytes);
+
+  BufferView& indexView = model.bufferViews.emplace_back();
+  indexView.buffer = 0;
+  indexView.byteOffset = int64_t(positionBytes);
+  indexView.byteLength = int64_t(indexBytes);
+
+  Accessor& positionAccessor = model.accessors.emplace_back();
+  positionAccessor.bufferView = 0;
+  positionAccessor.componentType = Accessor::ComponentType::FLOAT;
+  positionAccessor.type = Accessor::Type::VEC3;
+  positionAccessor.count = int64_t(positions.size());
+
+  Accessor& indexAccessor = model.accessors.emplace_back();
+  indexAccessor.bufferView = 1;
+  indexAccessor.componentType = Accessor::ComponentType::UNSIGNED_INT;
+  indexAccessor.type = Accessor::Type::SCALAR;
+  indexAccessor.count = int64_t(indices.size());
+
+  Mesh& mesh = model.meshes.emplace_back();
+  MeshPrimitive& primitive = mesh.primitives.emplace_back();
+  primitive.mode = MeshPrimitive::Mode::TRIANGLES;
+  primitive.attributes["POSITION"] = 0;
+  primitive.indices = 1;
+
+  model.nodes.emplace_back().mesh = 0;
+  model.scenes.emplace_back().nodes.emplace_back(0);
+  model.scene = 0;
+
+  return tile;
+}
+
+TestTile createFlatTile(
+    const GlobeRectangle& rectangle,
+    double geometricError,
+    double height) {
+  return createTile(rectangle, geometricError, 9, [height](double, double) {
+    return height;
+  });
+}
+
+bool addGrid(
+    TerrainHeightCache& cache,
+    const TestTile& tile,
+    const std::vector<GlobeRectangle>& finerRectangles = {}) {
+  return cache.addGrid(
+      &tile,
+      tile.rectangle,
+      tile.geometricError,
+      tile.model,
+      tile.modelToEcef,
+      finerRectangles);
+}
+
+// The position at a fraction of the way across a rectangle.
+Cartographic
+getPosition(const GlobeRectangle& rectangle, double u, double v) {
+  return Cartographic(
+      rectangle.getWest() + u * rectangle.computeWidth(),
+      rectangle.getSouth() + v * rectangle.computeHeight());
+}
+
+} // namespace
+
+TEST_CASE("TerrainHeightCache") {
+  TerrainHeightCache cache;
+
+  SUBCASE("interpolates between the heights of a tile") {
+    const TestTile tile = createTile(
+        GlobeRectangle::fromDegrees(10.0, 20.0, 10.01, 20.01),
+        16.0,
+        9,
+        [](double u, double v) { return 100.0 + 50.0 * u + 30.0 * v; });
+    REQUIRE(addGrid(cache, tile));
+    CHECK(cache.getGridCount() == 1);
+
+    for (double u : {0.2, 0.5, 0.73}) {
+      for (double v : {0.3, 0.5, 0.81}) {
+        std::optional<TerrainHeightSample> sample =
+            cache.findHeight(getPosition(tile.rectangle, u, v));
+        REQUIRE(sample);
+        CHECK(sample->height == doctest::Approx(100.0 + 50.0 * u + 30.0 * v)
+                                    .epsilon(1e-5));
+        CHECK(sample->geometricError == doctest::Approx(16.0).epsilon(1e-3));
+      }
+    }
+
+    CHECK(!cache.findHeight(Cartographic::fromDegrees(10.02, 20.005)));
+  }
+
+  SUBCASE("adds the distance from the triangles to the geometric error") {
+    // A single raised vertex, which falls between the grid's points.
+    const TestTile tile = createTile(
+        GlobeRectangle::fromDegrees(10.0, 20.0, 10.01, 20.01),
+        16.0,
+        5,
+        [](double u, double v) {
+          return u == 0.25 && v == 0.25 ? 150.0 : 100.0;
+        });
+    REQUIRE(addGrid(cache, tile));
+
+    std::optional<TerrainHeightSample> sample =
+        cache.findHeight(getPosition(tile.rectangle, 0.25, 0.25));
+    REQUIRE(sample);
+    const double resamplingError = sample->geometricError - 16.0;
+    CHECK(resamplingError > 1.0);
+    CHECK(150.0 - sample->height <= resamplingError + 0.01);
+  }
+
+  SUBCASE("finds tiles that straddle the prime meridian or the equator") {
+    for (const GlobeRectangle& rectangle :
+         {GlobeRectangle::fromDegrees(-0.005, 45.0, 0.005, 45.01),
+          GlobeRectangle::fromDegrees(20.0, -0.005, 20.01, 0.005)}) {
+      const TestTile tile = createFlatTile(rectangle, 16.0, 100.0);
+      REQUIRE(addGrid(cache, tile));
+
+      for (double u : {0.3, 0.7}) {
+        for (double v : {0.3, 0.7}) {
+          std::optional<TerrainHeightSample> sample =
+              cache.findHeight(getPosition(rectangle, u, v));
+          REQUIRE(sample);
+          CHECK(sample->height == doctest::Approx(100.0).epsilon(1e-5));
+        }
+      }
+
+      cache.tileUnloaded(&tile, tile.rectangle, tile.geometricError);
+    }
+  }
+
+  SUBCASE("prefers the most detailed grid") {
+    const TestTile coarse = createFlatTile(
+        GlobeRectangle::fromDegrees(10.0, 20.0, 10.02, 20.02),
+        64.0,
+        100.0);
+    const TestTile fine = createFlatTile(
+        GlobeRectangle::fromDegrees(10.0, 20.0, 10.01, 20.01),
+        16.0,
+        50.0);
+    REQUIRE(addGrid(cache, fine));
+    REQUIRE(addGrid(cache, coarse));
+
+    std::optional<TerrainHeightSample> sample =
+        cache.findHeight(Cartographic::fromDegrees(10.005, 20.005));
+    REQUIRE(sample);
+    CHECK(sample->height == doctest::Approx(50.0).epsilon(1e-5));
+
+    sample = cache.findHeight(Cartographic::fromDegrees(10.015, 20.015));
+    REQUIRE(sample);
+    CHECK(sample->height == doctest::Approx(100.0).epsilon(1e-5));
+  }
+
+  SUBCASE("clears a coarser grid where a more detailed tile loads") {
+    const TestTile coarse = createFlatTile(
+        GlobeRectangle::fromDegrees(10.0, 20.0, 10.02, 20.02),
+        64.0,
+        100.0);
+    const TestTile fine = createFlatTile(
+        GlobeRectangle::fromDegrees(10.0, 20.0, 10.01, 20.01),
+        16.0,
+        50.0);
+    REQUIRE(addGrid(cache, coarse));
+
+    cache.tileLoaded(&fine, fine.rectangle, fine.geometricError);
+    CHECK(!cache.findHeight(Cartographic::fromDegrees(10.005, 20.005)));
+    CHECK(cache.findHeight(Cartographic::fromDegrees(10.015, 20.015)));
+
+    // A tile that covers the whole grid leaves nothing of it.
+    const TestTile cover = createFlatTile(coarse.rectangle, 16.0, 50.0);
+    cache.tileLoaded(&cover, cover.rectangle, cover.geometricError);
+    CHECK(cache.getGridCount() == 0);
+  }
+
+  SUBCASE("clears only the grids that a loaded tile overlaps") {
+    // Small grids scattered far apart, including either side of the
+    // antimeridian, each in quadtree nodes of their own.
+    std::vector<TestTile> tiles;
+    for (double longitude : {-179.995, -60.0, 10.0, 120.0, 179.985}) {
+      tiles.emplace_back(createFlatTile(
+          GlobeRectangle::fromDegrees(
+              longitude,
+              20.0,
+              longitude + 0.01,
+              20.01),
+          64.0,
+          100.0));
+    }
+    for (const TestTile& tile : tiles) {
+      REQUIRE(addGrid(cache, tile));
+    }
+
+    SUBCASE("a small tile") {
+      const TestTile fine = createFlatTile(tiles[2].rectangle, 16.0, 50.0);
+      cache.tileLoaded(&fine, fine.rectangle, fine.geometricError);
+      CHECK(cache.getGridCount() == tiles.size() - 1);
+      CHECK(!cache.findHeight(Cartographic::fromDegrees(10.005, 20.005)));
+    }
+
+    SUBCASE("a tile larger than any grid") {
+      const TestTile large = createFlatTile(
+          GlobeRectangle::fromDegrees(0.0, 0.0, 90.0, 45.0),
+          16.0,
+          50.0);
+      cache.tileLoaded(&large, large.rectangle, large.geometricError);
+      CHECK(cache.getGridCount() == tiles.size() - 1);
+      CHECK(!cache.findHeight(Cartographic::fromDegrees(10.005, 20.005)));
+      CHECK(cache.findHeight(Cartographic::fromDegrees(120.005, 20.005)));
+    }
+
+    SUBCASE("a tile that crosses the antimeridian") {
+      const GlobeRectangle rectangle =
+          GlobeRectangle::fromDegrees(179.98, 19.0, -179.98, 21.0);
+      cache.tileLoaded(&rectangle, rectangle, 16.0);
+      CHECK(cache.getGridCount() == tiles.size() - 2);
+      CHECK(cache.findHeight(Cartographic::fromDegrees(-59.995, 20.005)));
+    }
+  }
+
+  SUBCASE("clears a new grid where more detailed tiles are loaded") {
+    const TestTile coarse = createFlatTile(
+        GlobeRectangle::fromDegrees(10.0, 20.0, 10.02, 20.02),
+        64.0,
+        100.0);
+    REQUIRE(addGrid(
+        cache,
+        coarse,
+        {GlobeRectangle::fromDegrees(10.0, 20.0, 10.01, 20.01)}));
+
+    CHECK(!cache.findHeight(Cartographic::fromDegrees(10.005, 20.005)));
+    CHECK(cache.findHeight(Cartographic::fromDegrees(10.015, 20.015)));
+  }
+
+  SUBCASE("discards a tile's grid when it is unloaded") {
+    const TestTile tile = createFlatTile(
+        GlobeRectangle::fromDegrees(10.0, 20.0, 10.01, 20.01),
+        16.0,
+        100.0);
+    REQUIRE(addGrid(cache, tile));
+    REQUIRE(cache.findHeight(Cartographic::fromDegrees(10.005, 20.005)));
+
+    cache.tileUnloaded(&tile, tile.rectangle, tile.geometricError);
+    CHECK(cache.getGridCount() == 0);
+    CHECK(!cache.findHeight(Cartographic::fromDegrees(10.005, 20.005)));
+  }
+
+  SUBCASE("does not cache a model with nothing in its rectangle") {
+    const TestTile tile = createFlatTile(
+        GlobeRectangle::fromDegrees(10.0, 20.0, 10.01, 20.01),
+        16.0,
+        100.0);
+    CHECK(!cache.addGrid(
+        &tile,
+        GlobeRectangle::fromDegrees(30.0, 20.0, 30.01, 20.01),
+        tile.geometricError,
+        tile.model,
+        tile.modelToEcef,
+        {}));
+    CHECK(cache.getGridCount() == 0);
+  }
+}
@@ -0,0 +1,116 @@
+#include "TileLoadScheduler.h"
+
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace CesiumForUnityNative;
+
+namespace {
+
+struct TestTileset {
+  float weight = 1.0f;
+  int32_t maximumSimultaneousTileLoads = 20;
+  int32_t pendingLoads = 10;
+};
+
+// Updates each tileset once in the given tick, as Cesium3DTilesetImpl does,
+// and returns the number of loads each was allowed.
+std::vector<int32_t> updateTilesets(
+    TileLoadScheduler& scheduler,
+    uint64_t tick,
+    int32_t globalLimit,
+    const std::vector<TestTileset*>& tilesets) {
+  std::vector<int32_t> allocations;
+  for (TestTileset* pTileset : tilesets) {
+    allocations.emplace_back(scheduler.beginTilesetUpdate(
+        pTileset,
+        tick,
+        globalLimit,
+        pTileset->weight,
+        pTileset->maximumSimultaneousTileLoads));
+    scheduler.endTilesetUpdate(pTileset, pTileset->pendingLoads);
+  }
+  return allocations;
+}
+
+} // namespace
+
+TEST_CASE("TileLoadScheduler") {
+  TileLoadScheduler scheduler;
+  TestTileset first;
+  TestTileset second;
+
+  SUBCASE("returns each tileset's own limit without a global limit") {
+    first.maximumSimultaneousTileLoads = 12;
+    second.maximumSimultaneousTileLoads = 3;
+    CHECK(
+        updateTilesets(scheduler, 1, 0, {&first, &second}) ==
+        std::vector<int32_t>{12, 3});
+  }
+
+  SUBCASE("gives each tileset one load until it reports its pending loads") {
+    CHECK(
+        updateTilesets(scheduler, 1, 8, {&first, &second}) ==
+        std::vector<int32_t>{1, 1});
+  }
+
+  SUBCASE("divides the global limit in proportion to weight") {
+    first.weight = 3.0f;
+    second.weight = 1.0f;
+    updateTilesets(scheduler, 1, 8, {&first, &second});
+    CHECK(
+        updateTilesets(scheduler, 2, 8, {&first, &second}) ==
+        std::vector<int32_t>{6, 2});
+  }
+
+  SUBCASE("gives what a tileset can't use to the others") {
+    first.pendingLoads = 2;
+    updateTilesets(scheduler, 1, 8, {&first, &second});
+    CHECK(
+        updateTilesets(scheduler, 2, 8, {&first, &second}) ==
+        std::vector<int32_t>{2, 6});
+  }
+
+  SUBCASE("never exceeds a tileset's own limit") {
+    first.maximumSimultaneousTileLoads = 3;
+    updateTilesets(scheduler, 1, 8, {&first, &second});
+    CHECK(
+        updateTilesets(scheduler, 2, 8, {&first, &second}) ==
+        std::vector<int32_t>{3, 5});
+  }
+
+  SUBCASE("gives a tileset with no weight one load") {
+    second.weight = 0.0f;
+    updateTilesets(scheduler, 1, 4, {&first, &second});
+    CHECK(
+        updateTilesets(scheduler, 2, 4, {&first, &second}) ==
+        std::vector<int32_t>{3, 1});
+  }
+
+  SUBCASE("keeps the allocation until the tick changes") {
+    updateTilesets(scheduler, 1, 8, {&first, &second});
+    updateTilesets(scheduler, 2, 8, {&first, &second});
+
+    first.pendingLoads = 0;
+    CHECK(
+        updateTilesets(scheduler, 2, 8, {&first, &second}) ==
+        std::vector<int32_t>{4, 4});
+    CHECK(
+        updateTilesets(scheduler, 3, 8, {&first, &second}) ==
+        std::vector<int32_t>{1, 8});
+  }
+
+  SUBCASE("stops sharing with a tileset that no longer updates") {
+    updateTilesets(scheduler, 1, 8, {&first, &second});
+    updateTilesets(scheduler, 2, 8, {&first});
+    CHECK(updateTilesets(scheduler, 3, 8, {&first}) == std::vector<int32_t>{8});
+  }
+
+  SUBCASE("stops sharing with a removed tileset") {
+    updateTilesets(scheduler, 1, 8, {&first, &second});
+    scheduler.removeTileset(&second);
+    CHECK(updateTilesets(scheduler, 2, 8, {&first}) == std::vector<int32_t>{8});
+  }
+}
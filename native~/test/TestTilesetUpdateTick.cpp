@@ -0,0 +1,34 @@
+#include "TilesetUpdateTick.h"
+
+#include <doctest/doctest.h>
+
+using namespace CesiumForUnityNative;
+
+TEST_CASE("TilesetUpdateTick") {
+  TilesetUpdateTick tick;
+  int first = 0;
+  int second = 0;
+
+  SUBCASE("tilesets updating in the same frame share a tick") {
+    uint64_t firstTick = tick.beginTilesetUpdate(&first, 10);
+    uint64_t secondTick = tick.beginTilesetUpdate(&second, 10);
+    CHECK(firstTick == secondTick);
+    CHECK(tick.getCurrentTick() == firstTick);
+  }
+
+  SUBCASE("a new frame begins a new tick") {
+    uint64_t firstTick = tick.beginTilesetUpdate(&first, 10);
+    uint64_t nextTick = tick.beginTilesetUpdate(&first, 11);
+    CHECK(nextTick != firstTick);
+    CHECK(tick.beginTilesetUpdate(&second, 11) == nextTick);
+  }
+
+  SUBCASE("a tileset updating again without a new frame begins a new tick") {
+    uint64_t firstTick = tick.beginTilesetUpdate(&first, 10);
+    CHECK(tick.beginTilesetUpdate(&second, 10) == firstTick);
+
+    uint64_t nextTick = tick.beginTilesetUpdate(&first, 10);
+    CHECK(nextTick != firstTick);
+    CHECK(tick.beginTilesetUpdate(&second, 10) == nextTick);
+  }
+}